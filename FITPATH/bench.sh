@@ -0,0 +1,83 @@
+#!/bin/bash
+
+# Benchmarks of path generation, of each simulator and of fitpath, on
+# fixed inputs built from data/etx and data/instances. Every result is
+# a JSON line with the mean, standard deviation, minimum, median and
+# maximum over the runs.
+#
+# fitpath runs with -b (program "fitpath -b") and with the default
+# cycle detection (program "fitpath").
+#
+# RUNS (default 5) sets the repetitions of the simulator benchmarks,
+# FITPATH_RUNS (default 3) those of fitpath in each mode, and SEED
+# (default 1) the seed of the path sets simulated. PROGRAMS lists the
+# simulator benchmarks; benchSimulation (simulation.c) takes seconds
+# per path set on these inputs and is left out by default.
+
+RUNS=${RUNS:-5}
+FITPATH_RUNS=${FITPATH_RUNS:-3}
+SEED=${SEED:-1}
+PATHSETS=${PATHSETS:-10}
+PROGRAMS=${PROGRAMS:-"benchSimulationD benchSimulationE benchSimulationF benchSimulationG benchSimulationH benchSimulationH2"}
+
+. ./instances.sh
+
+# <topology> <instance file> <flows per instance> <instance number>
+INPUTS=(
+	"etxGrid56 instGrid3 3 2"
+	"etxRandom30 instRand3 3 1"
+)
+
+WORKDIR=$(mktemp -d /tmp/bench_XXX)
+RUNDIR=$(makeRunDir $WORKDIR)
+BIN=$(pwd)
+
+# Print the JSON summary of the numbers on standard input.
+summarise() {
+
+	sort -g | awk -v program="$1" -v benchmark="$2" -v input="$3" -v unit="$4" '
+		{ x[n++] = $1; sum += $1; }
+		END {
+			if (n == 0) exit 1;
+			mean = sum / n;
+			for (i = 0; i < n; i++) squares += (x[i] - mean) ^ 2;
+			stddev = n > 1 ? sqrt(squares / (n - 1)) : 0;
+			median = n % 2 ? x[int(n / 2)] : (x[n / 2 - 1] + x[n / 2]) / 2;
+			printf("{\"program\":\"%s\",\"benchmark\":\"%s\",\"input\":\"%s\",\"runs\":%d,\"unit\":\"%s\",", program, benchmark, input, n, unit);
+			printf("\"mean\":%.3f,\"stddev\":%.3f,\"min\":%.3f,\"median\":%.3f,\"max\":%.3f}\n", mean, stddev, x[0], median, x[n - 1]);
+		}'
+}
+
+for INPUT in "${INPUTS[@]}"
+do
+	set -- $INPUT
+	NAME=$1-$2-$4
+	INPUTFILE=$WORKDIR/$NAME
+	makeInput $1 $2 $3 $4 $INPUTFILE
+
+	for PROGRAM in $PROGRAMS
+	do
+		./$PROGRAM -r $RUNS -n $PATHSETS -s $SEED $INPUTFILE | sed "s|$INPUTFILE|$NAME|"
+	done
+
+	NNODES=$(numberOfNodes $INPUTFILE)
+	for MODE in "-b" ""
+	do
+		rm -f $WORKDIR/times $WORKDIR/best $WORKDIR/costs
+		for RUN in $(seq $FITPATH_RUNS)
+		do
+			START=$(date +%s%N)
+			(cd $RUNDIR && $BIN/fitpath $MODE -s $INPUTFILE $NNODES 1 1 > $WORKDIR/output)
+			END=$(date +%s%N)
+			echo $(( (END - START) / 1000000 )) >> $WORKDIR/times
+			awk '/^Stats time best/{print $4}' $WORKDIR/output >> $WORKDIR/best
+			awk '/bestCost = /{print $7}' $WORKDIR/output >> $WORKDIR/costs
+		done
+		PROGRAM=$(echo fitpath $MODE)
+		summarise "$PROGRAM" time $NAME ms < $WORKDIR/times
+		summarise "$PROGRAM" timeToBest $NAME "cpu ms" < $WORKDIR/best
+		summarise "$PROGRAM" cost $NAME cost < $WORKDIR/costs
+	done
+done
+
+rm -rf $WORKDIR
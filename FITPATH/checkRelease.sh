@@ -0,0 +1,82 @@
+#!/bin/bash
+
+# Check that optimised builds compute what the debug build computes:
+# runs fitpath, mape and heuristicILS_mate from the FITPATH directory
+# and from the given directory on the benchmark inputs and compares
+# their outputs, less the lines reporting times. fitpath runs with
+# both cycle detections. The searches stop after ITERATIONS iterations
+# (default 2), not at their time limit, so that both builds do the same
+# work, and heuristicILS_mate gets a fixed seed.
+#
+#	./checkRelease.sh <directory with the optimised programs>
+
+. ./instances.sh
+
+DIR=$(cd $1 && pwd)
+BIN=$(pwd)
+ITERATIONS=${ITERATIONS:-2}
+
+# <topology> <instance file> <flows per instance> <instance number>
+INPUTS=(
+	"etxGrid56 instGrid3 3 2"
+	"etxRandom30 instRand3 3 1"
+	"etxRand2_30 instRand3 3 5"
+	"etxGrid56 instGrid3 3 7"
+	"etxGrid3_56 instGrid3 3 3"
+)
+
+WORKDIR=$(mktemp -d /tmp/checkRelease_XXX)
+RUNDIR=$(makeRunDir $WORKDIR)
+FAILED=0
+
+# Run a program and drop the lines that depend on timing.
+run() {
+
+	(cd $RUNDIR && "$@") | grep -v "^Stats time"
+}
+
+compare() {
+
+	if cmp -s $WORKDIR/debug $WORKDIR/release
+	then
+		echo "OK   $1"
+	else
+		echo "DIFF $1"
+		diff $WORKDIR/debug $WORKDIR/release | head -10
+		FAILED=1
+	fi
+}
+
+for INPUT in "${INPUTS[@]}"
+do
+	set -- $INPUT
+	NAME=$1-$2-$4
+	INPUTFILE=$WORKDIR/$NAME
+	makeInput $1 $2 $3 $4 $INPUTFILE
+	NNODES=$(numberOfNodes $INPUTFILE)
+
+	run $BIN/fitpath -b -s -i $ITERATIONS $INPUTFILE $NNODES 1 1 > $WORKDIR/debug
+	run $DIR/fitpath -b -s -i $ITERATIONS $INPUTFILE $NNODES 1 1 > $WORKDIR/release
+	compare "fitpath -b $NAME"
+
+	run $BIN/fitpath -s -i $ITERATIONS $INPUTFILE $NNODES 1 1 > $WORKDIR/debug
+	run $DIR/fitpath -s -i $ITERATIONS $INPUTFILE $NNODES 1 1 > $WORKDIR/release
+	compare "fitpath $NAME"
+done
+
+# heuristicILS_mate takes long enough that one input suffices.
+INPUTFILE=$WORKDIR/etxGrid56-instGrid3-2
+NNODES=$(numberOfNodes $INPUTFILE)
+run $BIN/heuristicILS_mate -S 1 -i $ITERATIONS $INPUTFILE $NNODES 1 1 > $WORKDIR/debug
+run $DIR/heuristicILS_mate -S 1 -i $ITERATIONS $INPUTFILE $NNODES 1 1 > $WORKDIR/release
+compare "heuristicILS_mate etxGrid56-instGrid3-2"
+
+# mape simulates four fixed paths and needs an input with four flows.
+INPUTFILE=$WORKDIR/etxGrid56-instGrid3-4flows
+makeInput etxGrid56 instGrid3 4 1 $INPUTFILE
+run $BIN/mape -S 1 $INPUTFILE > $WORKDIR/debug
+run $DIR/mape -S 1 $INPUTFILE > $WORKDIR/release
+compare "mape etxGrid56-instGrid3-4flows"
+
+rm -rf $WORKDIR
+exit $FAILED
@@ -0,0 +1,69 @@
+#!/bin/bash
+
+# Check that fitpath computes the same result on every run: runs it on
+# each benchmark input, with both cycle detections, once as is and once
+# with MALLOC_PERTURB_ set to each byte of PERTURB (default 90 165), so
+# that memory read before it is written holds other contents, and
+# compares the outputs, less the lines reporting times. The searches
+# stop after ITERATIONS iterations (default 2), not at their time limit.
+#
+#	./checkReproducible.sh
+
+. ./instances.sh
+
+BIN=$(pwd)
+ITERATIONS=${ITERATIONS:-2}
+PERTURB=${PERTURB:-90 165}
+
+# <topology> <instance file> <flows per instance> <instance number>
+INPUTS=(
+	"etxGrid56 instGrid3 3 2"
+	"etxRandom30 instRand3 3 1"
+	"etxRand2_30 instRand3 3 5"
+	"etxGrid56 instGrid3 3 7"
+	"etxGrid3_56 instGrid3 3 3"
+)
+
+WORKDIR=$(mktemp -d /tmp/checkReproducible_XXX)
+RUNDIR=$(makeRunDir $WORKDIR)
+FAILED=0
+
+# Run a program and drop the lines that depend on timing.
+run() {
+
+	(cd $RUNDIR && "$@") | grep -v "^Stats time"
+}
+
+compare() {
+
+	if cmp -s $WORKDIR/first $WORKDIR/second
+	then
+		echo "OK   $1"
+	else
+		echo "DIFF $1"
+		diff $WORKDIR/first $WORKDIR/second | head -10
+		FAILED=1
+	fi
+}
+
+for INPUT in "${INPUTS[@]}"
+do
+	set -- $INPUT
+	NAME=$1-$2-$4
+	INPUTFILE=$WORKDIR/$NAME
+	makeInput $1 $2 $3 $4 $INPUTFILE
+	NNODES=$(numberOfNodes $INPUTFILE)
+
+	for MODE in "-b" ""
+	do
+		run $BIN/fitpath $MODE -s -i $ITERATIONS $INPUTFILE $NNODES 1 1 > $WORKDIR/first
+		for BYTE in $PERTURB
+		do
+			MALLOC_PERTURB_=$BYTE run $BIN/fitpath $MODE -s -i $ITERATIONS $INPUTFILE $NNODES 1 1 > $WORKDIR/second
+			compare "$(echo fitpath $MODE $NAME) MALLOC_PERTURB_=$BYTE"
+		done
+	done
+done
+
+rm -rf $WORKDIR
+exit $FAILED
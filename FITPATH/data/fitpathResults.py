@@ -0,0 +1,74 @@
+import struct, array
+
+# Reader of the result files written by fitpath -o (see resultFile.h).
+# Columns are returned as array.array, which numpy.asarray takes
+# without copying element by element.
+#
+#	header, blocks = read("results/56-1-ref1.fpr")
+#	for block in blocks:
+#		cost = block["cost"]
+#		delayFlow0 = block["flowDelay"][0]
+
+MAGIC = b"FPRS"
+VERSION = 1
+
+def _column(data, offset, typecode, count):
+	column = array.array(typecode)
+	size = column.itemsize * count
+	if hasattr(column, "frombytes"):
+		column.frombytes(data[offset:offset + size])
+	else:
+		column.fromstring(data[offset:offset + size])
+	if len(column) != count:
+		raise ValueError("truncated result file")
+	return column, offset + size
+
+def _string(data, offset):
+	length, = struct.unpack_from("<I", data, offset)
+	offset += 4
+	return data[offset:offset + length].decode("utf-8", "replace"), offset + length
+
+def read(filename):
+	with open(filename, "rb") as f:
+		data = f.read()
+
+	if data[:4] != MAGIC:
+		raise ValueError(filename + " is not a result file")
+	version, flows, graphNodes, nodes, instance, reference, startTime = struct.unpack_from("<IIIiiiq", data, 4)
+	if version != VERSION:
+		raise ValueError(filename + " has version " + str(version))
+	offset = 4 + struct.calcsize("<IIIiiiq")
+	inputName, offset = _string(data, offset)
+	options, offset = _string(data, offset)
+
+	header = {"flows": flows, "graphNodes": graphNodes, "nodes": nodes, "instance": instance,
+		"reference": reference, "startTime": startTime, "input": inputName, "options": options}
+
+	blocks = []
+	while offset < len(data):
+		rows, pathNodes = struct.unpack_from("<II", data, offset)
+		offset += 8
+		block = {"rows": rows}
+		for name, typecode in (("simulation", "I"), ("time", "f"), ("cost", "f"), ("delay", "f")):
+			block[name], offset = _column(data, offset, typecode, rows)
+		for name in ("rate", "flowDelay", "loss"):
+			block[name] = []
+			for flow in range(flows):
+				column, offset = _column(data, offset, "f", rows)
+				block[name].append(column)
+		lengths, offset = _column(data, offset, "H", rows * flows)
+		nodesColumn, offset = _column(data, offset, "H", pathNodes)
+
+		# paths[row][flow], each path source first.
+		block["paths"] = []
+		start = 0
+		for row in range(rows):
+			paths = []
+			for flow in range(flows):
+				length = lengths[row * flows + flow]
+				paths.append(list(nodesColumn[start:start + length]))
+				start += length
+			block["paths"].append(paths)
+		blocks.append(block)
+
+	return header, blocks
@@ -11,7 +11,7 @@
 t_weight dijkstra(t_graph * graph, long source, long destination, t_array ** output) {
 
 	t_array * lastHop, * numberOfHops;
-	t_list * neighbors;
+	t_smallVec * neighbors;
 	t_set * defSet;
 	t_list * defList;
 	long bestSrcNode, bestDstNode;
@@ -27,6 +27,7 @@ t_weight dijkstra(t_graph * graph, long source, long destination, t_array ** out
 	lastHop = arrayNew(numberOfNodes);
 	numberOfHops = arrayNew(numberOfNodes);
 	defSet = setNew();
+	setReserve(defSet, numberOfNodes - 1);
 	defList = listNew();
 	MALLOC(pathsCost, sizeof(t_weight) * numberOfNodes);
 
@@ -46,7 +47,7 @@ t_weight dijkstra(t_graph * graph, long source, long destination, t_array ** out
 
 			srcNode -= 1;
 			neighbors = graphGetNeighbors(graph, srcNode);
-			for (dstNode = listBegin(neighbors); dstNode; dstNode = listNext(neighbors)) {
+			for (dstNode = smallVecBegin(neighbors); dstNode < smallVecEnd(neighbors); dstNode++) {
 
 				if (graphIsDisabled(graph, srcNode, * dstNode)) continue ;
 				if (setIsElementOf(defSet, * dstNode)) continue ;
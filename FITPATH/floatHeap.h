@@ -4,16 +4,27 @@
 #include "graph.h"
 #include "list.h"
 
+/*
+ * Indexed 4-ary heap; the implementation is in heapImpl.h.
+ */
 typedef struct {
 
 	int bufferSize;
 	int size;
 	void ** elements;
 	double * keys;
+	int * handles;
+	int * positions;
+	int * freeHandles;
+	int numberOfHandles;
+	int numberOfFreeHandles;
 } t_floatHeap;
 
 t_floatHeap * floatHeapNew();
-void floatHeapAdd(t_floatHeap * floatHeap, void * element, double key);
+void floatHeapReserve(t_floatHeap * floatHeap, int numberOfElements);
+int floatHeapAdd(t_floatHeap * floatHeap, void * element, double key);
+void floatHeapDecreaseKey(t_floatHeap * floatHeap, int handle, double key);
+int floatHeapContains(t_floatHeap * floatHeap, int handle);
 void * floatHeapExtractMinimum(t_floatHeap * floatHeap, double * key);
 void * floatHeapTop(t_floatHeap * floatHeap);
 double floatHeapTopKey(t_floatHeap * floatHeap);
@@ -9,8 +9,8 @@ t_graph * graphNew(int numberOfNodes) {
 	MALLOC(graph, sizeof(t_graph));
 	graph->numberOfNodes = numberOfNodes;
 
-	MALLOC(graph->neighborhood, numberOfNodes * sizeof(t_list *));
-	for (i = 0; i < numberOfNodes; i++) graph->neighborhood[i] = listNew();
+	MALLOC(graph->neighborhood, numberOfNodes * sizeof(t_smallVec));
+	for (i = 0; i < numberOfNodes; i++) smallVecInit(& graph->neighborhood[i]);
 
 	MALLOC(graph->neighborDisabled, numberOfNodes * sizeof(t_set *));
 	for (i = 0; i < numberOfNodes; i++) graph->neighborDisabled[i] = setNew();
@@ -26,32 +26,31 @@ t_graph * graphNew(int numberOfNodes) {
 		}
 	}
 
+	graph->linkData = NULL;
+	graph->linkDataFree = NULL;
+
 	return(graph);
 }
 
 void graphAddLink(t_graph * graph, int src, int dst, float cost) {
 
-	int * node;
+	if (graph->linkData) graphSetLinkData(graph, NULL, NULL);
 
 	if (graph->adj[src][dst] == GRAPH_INFINITY) {
 
-		MALLOC(node, sizeof(int));
-		* node = dst;
 		graph->adj[src][dst] = (t_weight) GRAPH_MULTIPLIER * cost;
-		listAdd(graph->neighborhood[src], node);
+		smallVecAdd(& graph->neighborhood[src], dst);
 	}
 	else if (src == dst && graph->adj[src][dst] == 0) {
 
-		MALLOC(node, sizeof(int));
-		* node = dst;
 		graph->adj[src][dst] = (t_weight) GRAPH_MULTIPLIER * cost;
-		listAdd(graph->neighborhood[src], node);
+		smallVecAdd(& graph->neighborhood[src], dst);
 	}
 }
 
-t_list * graphGetNeighbors(t_graph * graph, int node) {
+t_smallVec * graphGetNeighbors(t_graph * graph, int node) {
 
-	return(graph->neighborhood[node]);
+	return(& graph->neighborhood[node]);
 }
 
 int graphSize(t_graph * graph) {
@@ -68,10 +67,11 @@ void graphFree(t_graph * graph) {
 	
 	int i;
 
+	graphSetLinkData(graph, NULL, NULL);
+
 	for (i = 0; i < graph->numberOfNodes; i++) {
 
-		listFreeWithData(graph->neighborhood[i]);
-		free(graph->neighborhood[i]);
+		smallVecFree(& graph->neighborhood[i]);
 		setFree(graph->neighborDisabled[i]);
 		free(graph->neighborDisabled[i]);
 		free(graph->adj[i]);
@@ -115,6 +115,19 @@ int graphIsDisabled(t_graph * graph, int src, int dst) {
 	return(setIsElementOf(graph->neighborDisabled[src], dst));
 }
 
+void * graphGetLinkData(t_graph * graph) {
+
+	return(graph->linkData);
+}
+
+void graphSetLinkData(t_graph * graph, void * linkData, void (* linkDataFree)(void *)) {
+
+	if (graph->linkData && graph->linkDataFree) graph->linkDataFree(graph->linkData);
+
+	graph->linkData = linkData;
+	graph->linkDataFree = linkDataFree;
+}
+
 void graphPrint(t_graph * graph) {
 
 	int i, j;
@@ -136,7 +149,7 @@ void graphPrint(t_graph * graph) {
 	printf("Neighborhood:\n\n");
 	for (i = 0; i < graph->numberOfNodes; i++) {
 		printf("%d : ", i);
-		for (neighbor = listBegin(graph->neighborhood[i]); neighbor; neighbor = listNext(graph->neighborhood[i])) {
+		for (neighbor = smallVecBegin(& graph->neighborhood[i]); neighbor < smallVecEnd(& graph->neighborhood[i]); neighbor++) {
 
 			printf(" %d,", * neighbor);
 		}
@@ -1,12 +1,15 @@
 #ifndef __GRAPH_H__
 #define __GRAPH_H__
 
+#ifndef _ISOC99_SOURCE
 #define _ISOC99_SOURCE
+#endif
 
 #include <math.h>
 
 #include "list.h"
 #include "set.h"
+#include "smallVec.h"
 
 #include <stdint.h>
 
@@ -29,14 +32,22 @@
 typedef struct {
 
 	int numberOfNodes;
-	t_list ** neighborhood;
+	t_smallVec * neighborhood;
 	t_set ** neighborDisabled;
 	t_weight ** adj;
+
+	/*
+	 * Opaque per-graph data derived from the link costs
+	 * (e.g., the simulator's link table). It is released by
+	 * graphFree and whenever a link is added.
+	 */
+	void * linkData;
+	void (* linkDataFree)(void * linkData);
 } t_graph;
 
 t_graph * graphNew(int numberOfNodes);
 void graphAddLink(t_graph * graph, int src, int dst, float cost);
-t_list * graphGetNeighbors(t_graph * graph, int node);
+t_smallVec * graphGetNeighbors(t_graph * graph, int node);
 int graphSize(t_graph * graph);
 t_weight graphGetCost(t_graph * graph, int src, int dst);
 void graphFree(t_graph * graph);
@@ -45,6 +56,8 @@ void graphDisableLink(t_graph * graph, int src, int dst);
 void graphDisableNode(t_graph * graph, int node);
 void graphReenableAll(t_graph * graph);
 int graphIsDisabled(t_graph * graph, int src, int dst);
+void * graphGetLinkData(t_graph * graph);
+void graphSetLinkData(t_graph * graph, void * linkData, void (* linkDataFree)(void *));
 
 #endif
 
@@ -4,16 +4,27 @@
 #include "graph.h"
 #include "list.h"
 
+/*
+ * Indexed 4-ary heap; the implementation is in heapImpl.h.
+ */
 typedef struct {
 
 	int bufferSize;
 	int size;
 	void ** elements;
 	t_weight * keys;
+	int * handles;
+	int * positions;
+	int * freeHandles;
+	int numberOfHandles;
+	int numberOfFreeHandles;
 } t_heap;
 
 t_heap * heapNew();
-void heapAdd(t_heap * heap, void * element, t_weight key);
+void heapReserve(t_heap * heap, int numberOfElements);
+int heapAdd(t_heap * heap, void * element, t_weight key);
+void heapDecreaseKey(t_heap * heap, int handle, t_weight key);
+int heapContains(t_heap * heap, int handle);
 void * heapExtractMinimum(t_heap * heap, t_weight * key);
 void * heapTop(t_heap * heap);
 t_weight heapTopKey(t_heap * heap);
@@ -0,0 +1,230 @@
+/*
+ * Indexed 4-ary min heap. This is not a regular header: heap.c and
+ * floatHeap.c include it once each after defining
+ *
+ *	HEAP_TYPE		the heap struct (see heap.h);
+ *	HEAP_KEY		the key type;
+ *	HEAP_FN(name)		the variant's function names, e.g. heap##name;
+ *	HEAP_KEY_FORMAT		the printf format of a key.
+ *
+ * Keys live in their own array, so the four children compared while
+ * sifting down share a cache line. Every element gets a handle when
+ * added, which stays valid until the element leaves the heap and is
+ * what heapDecreaseKey takes. Handles are small ints reused after
+ * extraction, so callers can index their own arrays with them.
+ */
+#define HEAP_ARITY			4
+#define MIN_ELEMENT_BUFFER	16
+
+static void HEAP_FN(Place)(HEAP_TYPE * heap, int position, void * element, HEAP_KEY key, int handle) {
+
+	heap->elements[position] = element;
+	heap->keys[position] = key;
+	heap->handles[position] = handle;
+	heap->positions[handle] = position;
+}
+
+static void HEAP_FN(SiftUp)(HEAP_TYPE * heap, int current, void * element, HEAP_KEY key, int handle) {
+
+	int father;
+
+	while(current) {
+
+		father = (current - 1) / HEAP_ARITY;
+
+		if (key >= heap->keys[father]) break;
+
+		HEAP_FN(Place)(heap, current, heap->elements[father], heap->keys[father], heap->handles[father]);
+		current = father;
+	}
+
+	HEAP_FN(Place)(heap, current, element, key, handle);
+}
+
+static void HEAP_FN(SiftDown)(HEAP_TYPE * heap, int current, void * element, HEAP_KEY key, int handle) {
+
+	int child, firstChild, lastChild, bestChild;
+
+	while(1) {
+
+		firstChild = current * HEAP_ARITY + 1;
+		if (firstChild >= heap->size) break;
+
+		lastChild = firstChild + HEAP_ARITY;
+		if (lastChild > heap->size) lastChild = heap->size;
+
+		bestChild = firstChild;
+		for (child = firstChild + 1; child < lastChild; child++) {
+
+			if (heap->keys[child] < heap->keys[bestChild]) bestChild = child;
+		}
+
+		if (heap->keys[bestChild] >= key) break;
+
+		HEAP_FN(Place)(heap, current, heap->elements[bestChild], heap->keys[bestChild], heap->handles[bestChild]);
+		current = bestChild;
+	}
+
+	HEAP_FN(Place)(heap, current, element, key, handle);
+}
+
+HEAP_TYPE * HEAP_FN(New)() {
+
+	HEAP_TYPE * heap;
+
+	MALLOC(heap, sizeof(HEAP_TYPE));
+
+	heap->bufferSize = MIN_ELEMENT_BUFFER;
+	MALLOC(heap->elements, sizeof(void *) * heap->bufferSize);
+	MALLOC(heap->keys, sizeof(HEAP_KEY) * heap->bufferSize);
+	MALLOC(heap->handles, sizeof(int) * heap->bufferSize);
+	MALLOC(heap->positions, sizeof(int) * heap->bufferSize);
+	MALLOC(heap->freeHandles, sizeof(int) * heap->bufferSize);
+	heap->size = 0;
+	heap->numberOfHandles = 0;
+	heap->numberOfFreeHandles = 0;
+
+	return(heap);
+}
+
+/*
+ * Make room for at least numberOfElements elements, so that adding
+ * them does not reallocate. The buffer otherwise doubles when full.
+ */
+void HEAP_FN(Reserve)(HEAP_TYPE * heap, int numberOfElements) {
+
+	int bufferSize;
+
+	if (numberOfElements <= heap->bufferSize) return ;
+
+	bufferSize = heap->bufferSize ? heap->bufferSize : MIN_ELEMENT_BUFFER;
+	while(bufferSize < numberOfElements) bufferSize *= 2;
+
+	heap->bufferSize = bufferSize;
+	REALLOC(heap->elements, sizeof(void *) * heap->bufferSize);
+	REALLOC(heap->keys, sizeof(HEAP_KEY) * heap->bufferSize);
+	REALLOC(heap->handles, sizeof(int) * heap->bufferSize);
+	REALLOC(heap->positions, sizeof(int) * heap->bufferSize);
+	REALLOC(heap->freeHandles, sizeof(int) * heap->bufferSize);
+}
+
+int HEAP_FN(Add)(HEAP_TYPE * heap, void * element, HEAP_KEY key) {
+
+	int handle;
+
+	if (heap->size == heap->bufferSize) HEAP_FN(Reserve)(heap, heap->size + 1);
+
+	if (heap->numberOfFreeHandles) handle = heap->freeHandles[--heap->numberOfFreeHandles];
+	else handle = heap->numberOfHandles++;
+
+	heap->size++;
+	HEAP_FN(SiftUp)(heap, heap->size - 1, element, key, handle);
+
+	return(handle);
+}
+
+/*
+ * Change the key of the element with the given handle. Meant for
+ * lowering it, but a larger key is also put in its place.
+ */
+void HEAP_FN(DecreaseKey)(HEAP_TYPE * heap, int handle, HEAP_KEY key) {
+
+	int position;
+
+	position = heap->positions[handle];
+
+	if (key > heap->keys[position])
+		HEAP_FN(SiftDown)(heap, position, heap->elements[position], key, handle);
+	else
+		HEAP_FN(SiftUp)(heap, position, heap->elements[position], key, handle);
+}
+
+/*
+ * Whether the element with the given handle is still in the heap.
+ */
+int HEAP_FN(Contains)(HEAP_TYPE * heap, int handle) {
+
+	return(handle < heap->numberOfHandles && heap->positions[handle] >= 0);
+}
+
+void * HEAP_FN(ExtractMinimum)(HEAP_TYPE * heap, HEAP_KEY * key) {
+
+	void * element;
+
+	if (heap->size == 0) return(NULL);
+
+	element = heap->elements[0];
+	if (key != NULL) * key = heap->keys[0];
+
+	heap->positions[heap->handles[0]] = -1;
+	heap->freeHandles[heap->numberOfFreeHandles++] = heap->handles[0];
+
+	heap->size--;
+	if (heap->size)
+		HEAP_FN(SiftDown)(heap, 0, heap->elements[heap->size], heap->keys[heap->size], heap->handles[heap->size]);
+
+	return(element);
+}
+
+void * HEAP_FN(Top)(HEAP_TYPE * heap) {
+
+	if (heap->size == 0) return(NULL);
+
+	return(heap->elements[0]);
+}
+
+HEAP_KEY HEAP_FN(TopKey)(HEAP_TYPE * heap) {
+
+	if (heap->size == 0) return(0);
+
+	return(heap->keys[0]);
+}
+
+int HEAP_FN(Size)(HEAP_TYPE * heap) {
+
+	return(heap->size);
+}
+
+int HEAP_FN(IsEmpty)(HEAP_TYPE * heap) {
+
+	return((heap->size == 0));
+}
+
+void HEAP_FN(Free)(HEAP_TYPE * heap) {
+
+	if (heap->bufferSize) {
+
+		free(heap->elements);
+		free(heap->keys);
+		free(heap->handles);
+		free(heap->positions);
+		free(heap->freeHandles);
+		heap->size = 0;
+		heap->bufferSize = 0;
+		heap->numberOfHandles = 0;
+		heap->numberOfFreeHandles = 0;
+		heap->elements = NULL;
+		heap->keys = NULL;
+		heap->handles = NULL;
+		heap->positions = NULL;
+		heap->freeHandles = NULL;
+	}
+}
+
+void HEAP_FN(FreeWithData)(HEAP_TYPE * heap) {
+
+	int i;
+
+	for (i = 0; i < heap->size; i++) free(heap->elements[i]);
+	HEAP_FN(Free)(heap);
+}
+
+void HEAP_FN(Print)(HEAP_TYPE * heap) {
+
+	int i;
+
+	printf("Heap has %d elements.\nBuffer size is %d.\n", HEAP_FN(Size)(heap), heap->bufferSize);
+
+	for (i = 0; i < heap->size; i++)
+		printf("Index = %d\nData = \"%s\"\nKey = " HEAP_KEY_FORMAT "\n\n", i, (char *) heap->elements[i], heap->keys[i]);
+}
@@ -1,54 +1,118 @@
 #include "array.h"
 #include "graph.h"
 #include "set.h"
+#include "heuristics.h"
 
 #include "dijkstra.h"
+#include "linkTable.h"
+#include "memory.h"
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
-t_array * outputWeights, * inputWeights, * indexes, * candidates;
-t_set * alreadyVisited;
+t_heuristicCtx * heuristicCtxNew(int numberOfNodes) {
 
-void heuristicInit(int numberOfNodes, int numberOfPaths) {
+	t_heuristicCtx * ctx;
 
-	int i;
+	MALLOC(ctx, sizeof(t_heuristicCtx));
+	memset(ctx, 0, sizeof(t_heuristicCtx));
+
+	ctx->numberOfNodes = numberOfNodes;
+	MALLOC(ctx->nodeSlot, sizeof(int) * (numberOfNodes + 1));
+	memset(ctx->nodeSlot, 0, sizeof(int) * (numberOfNodes + 1));
+
+	return(ctx);
+}
 
-	outputWeights = arrayNew(numberOfNodes);
-	inputWeights = arrayNew(numberOfNodes);
-	candidates = arrayNew(numberOfNodes);
-	indexes = arrayNew(numberOfNodes);
-	alreadyVisited = setNew();
+void heuristicCtxFree(t_heuristicCtx * ctx) {
+
+	free(ctx->nodeSlot);
+	free(ctx->slotNode);
+	free(ctx->outputWeights);
+	free(ctx->inputWeights);
+	free(ctx->pathsThrough);
+	free(ctx->indexes);
+	free(ctx->candidates);
+	free(ctx->hopAirTime);
+	free(ctx->hopFlow);
+	free(ctx->hopHead);
+	free(ctx->hopTail);
+	free(ctx->weight);
+	free(ctx->airTime);
+	free(ctx->used);
+}
+
+/*
+ * Make room for numberOfSlots nodes (or hops) and numberOfPaths paths.
+ */
+static void heuristicCtxReserve(t_heuristicCtx * ctx, int numberOfSlots, int numberOfPaths) {
+
+	if (numberOfSlots > ctx->slotCapacity) {
+
+		ctx->slotCapacity = numberOfSlots > 2 * ctx->slotCapacity ? numberOfSlots : 2 * ctx->slotCapacity;
+		REALLOC(ctx->slotNode, sizeof(int) * ctx->slotCapacity);
+		REALLOC(ctx->outputWeights, sizeof(int64_t) * ctx->slotCapacity);
+		REALLOC(ctx->inputWeights, sizeof(int64_t) * ctx->slotCapacity);
+		REALLOC(ctx->pathsThrough, sizeof(int) * ctx->slotCapacity);
+		REALLOC(ctx->candidates, sizeof(int) * ctx->slotCapacity);
+		REALLOC(ctx->hopAirTime, sizeof(double) * ctx->slotCapacity);
+		REALLOC(ctx->hopFlow, sizeof(int) * ctx->slotCapacity);
+		REALLOC(ctx->hopHead, sizeof(int) * ctx->slotCapacity);
+		REALLOC(ctx->hopTail, sizeof(int) * ctx->slotCapacity);
+		free(ctx->indexes);
+		ctx->indexes = NULL;
+	}
 
-	for (i = 0; i < numberOfNodes; i++) {
+	if (numberOfPaths > ctx->pathCapacity) {
 
-		arraySet(indexes, i, arrayNew(numberOfPaths + 1));
+		ctx->pathCapacity = numberOfPaths > 2 * ctx->pathCapacity ? numberOfPaths : 2 * ctx->pathCapacity;
+		REALLOC(ctx->weight, sizeof(double) * ctx->pathCapacity);
+		REALLOC(ctx->airTime, sizeof(double) * ctx->pathCapacity);
+		REALLOC(ctx->used, sizeof(char) * ctx->pathCapacity);
+		free(ctx->indexes);
+		ctx->indexes = NULL;
 	}
+
+	if (ctx->indexes == NULL) MALLOC(ctx->indexes, sizeof(int) * (ctx->slotCapacity * ctx->pathCapacity + 1));
 }
 
-void heuristicFinalize() {
+/*
+ * Slot of node, given (and cleared for numberOfPaths paths) on the
+ * first call for the node since the last heuristicCtxRelease.
+ */
+static int heuristicCtxSlot(t_heuristicCtx * ctx, int node, int numberOfPaths) {
 
-	int i;
+	int slot;
 
-	arrayFree(outputWeights);
-	arrayFree(inputWeights);
-	free(outputWeights);
-	free(inputWeights);
+	if (ctx->nodeSlot[node]) return(ctx->nodeSlot[node] - 1);
 
-	for (i = 0; i < arrayLength(indexes); i++) {
-		
-		arrayFree((void *) arrayGet(indexes, i));
-		free(arrayGet(indexes, i));
-	}
-	arrayFree(indexes);
-	free(indexes);
-	setFree(alreadyVisited);
+	slot = ctx->numberOfSlots++;
+	ctx->nodeSlot[node] = slot + 1;
+	ctx->slotNode[slot] = node;
+	ctx->outputWeights[slot] = 0;
+	ctx->inputWeights[slot] = 0;
+	ctx->pathsThrough[slot] = 0;
+	memset(& ctx->indexes[slot * ctx->pathCapacity], 0, sizeof(int) * numberOfPaths);
+
+	return(slot);
+}
+
+/*
+ * Clear the map of the nodes given a slot, leaving it all zeros.
+ */
+static void heuristicCtxRelease(t_heuristicCtx * ctx) {
+
+	int slot;
+
+	for (slot = 0; slot < ctx->numberOfSlots; slot++) ctx->nodeSlot[ctx->slotNode[slot]] = 0;
+	ctx->numberOfSlots = 0;
 }
 
-float heuristicMultiplePathNewlowerBound(t_graph * graph, t_array * paths, float * costs, float breakAt) {
+float heuristicMultiplePathNewlowerBound(t_heuristicCtx * ctx, t_graph * graph, t_array * paths, float * costs, float breakAt) {
 
 	long i, j, k;
-	int numberOfPaths, numberOfNodes, numberOfCandidates;
+	int numberOfPaths, numberOfNodes, numberOfCandidates, slot, nextSlot;
 	t_array * path, * path2;
 	unsigned long prev, prevPrev, current, next, nextNext;
 	unsigned long indexInOtherPath, indexInOtherPath2;
@@ -56,11 +120,11 @@ float heuristicMultiplePathNewlowerBound(t_graph * graph, t_array * paths, float
 	float worstEstimate, currentEstimate;
 	float delayEstimate; // TODO: generalize the type.
 
-	arrayClear(outputWeights);
-	arrayClear(inputWeights);
-	arrayClear(candidates);
-
 	numberOfPaths = arrayLength(paths);
+	numberOfNodes = 0;
+	for (i = 0; i < numberOfPaths; i++) numberOfNodes += arrayLength(arrayGet(paths, i));
+	heuristicCtxReserve(ctx, numberOfNodes, numberOfPaths);
+
 	numberOfCandidates = 0;
 
 	if (breakAt < INFINITY) breakAt *= numberOfPaths;
@@ -72,27 +136,22 @@ float heuristicMultiplePathNewlowerBound(t_graph * graph, t_array * paths, float
 		for (j = 0; j < numberOfNodes; j++) {
 
 			current = (unsigned long) arrayGet(path, j);
+			slot = heuristicCtxSlot(ctx, current, numberOfPaths);
 
-			if (arrayGet(outputWeights, current) == 0 && arrayGet(inputWeights, current) == 0) {
-
-				arrayClear(arrayGet(indexes, current));
-			}
-
-			arraySet(arrayGet(indexes, current), i, (void *) (j + 1));
+			ctx->indexes[slot * ctx->pathCapacity + i] = j + 1;
 
-			arrayInc(arrayGet(indexes, current), numberOfPaths);
-			if (((unsigned long) arrayGet(arrayGet(indexes, current), numberOfPaths)) == 2)
-				arraySet(candidates, numberOfCandidates++, (void *) current);
+			if (++ctx->pathsThrough[slot] == 2)
+				ctx->candidates[numberOfCandidates++] = current;
 
 			if (j < numberOfNodes - 1) {
 
 				next = (unsigned long) arrayGet(path, j + 1);
-				arrayIncBy(outputWeights, current, graphGetCost(graph, current, next));
+				ctx->outputWeights[slot] += graphGetCost(graph, current, next);
 			}
 			if (j > 0) {
 
 				prev = (unsigned long) arrayGet(path, j - 1);
-				arrayIncBy(inputWeights, current, graphGetCost(graph, prev, current));
+				ctx->inputWeights[slot] += graphGetCost(graph, prev, current);
 			}
 		}
 	}
@@ -100,8 +159,9 @@ float heuristicMultiplePathNewlowerBound(t_graph * graph, t_array * paths, float
 	worstEstimate = INFINITY;
 	for (i = 0; i < numberOfCandidates; i++) {
 		
-		current = (unsigned long) arrayGet(candidates, i);
-		delayEstimate = (unsigned long) arrayGet(inputWeights, current) + (unsigned long) arrayGet(outputWeights, current);
+		current = ctx->candidates[i];
+		slot = ctx->nodeSlot[current] - 1;
+		delayEstimate = (unsigned long) ctx->inputWeights[slot] + (unsigned long) ctx->outputWeights[slot];
 		currentEstimate = 0;
 //printf("Current == %lu\n", current);
 //		setClear(alreadyVisited);
@@ -111,7 +171,7 @@ float heuristicMultiplePathNewlowerBound(t_graph * graph, t_array * paths, float
 
 			currentClique = 0;
 
-			indexInOtherPath = (unsigned long) arrayGet(arrayGet(indexes, current), j);
+			indexInOtherPath = ctx->indexes[slot * ctx->pathCapacity + j];
 			if (indexInOtherPath == 0) {
 
 				currentEstimate += 1.0/costs[j];
@@ -132,10 +192,11 @@ float heuristicMultiplePathNewlowerBound(t_graph * graph, t_array * paths, float
 			if (indexInOtherPath < arrayLength(path)) {
 
 				next = (unsigned long) arrayGet(path, indexInOtherPath);
+				nextSlot = ctx->nodeSlot[next] - 1;
 
 				for (k = 0; k < numberOfPaths; k++) {
 //printf("Evaluating coding and next link in path %d\n", k);
-					indexInOtherPath2 = (unsigned long) arrayGet(arrayGet(indexes, next), k);
+					indexInOtherPath2 = ctx->indexes[nextSlot * ctx->pathCapacity + k];
 
 					if (indexInOtherPath2 == 0) {
 
@@ -174,10 +235,10 @@ float heuristicMultiplePathNewlowerBound(t_graph * graph, t_array * paths, float
 		}
 
 //printf("Throughput for independent flows is %.2f\n", currentEstimate);
-//printf("delayEstimate for %lu flows is %.2f\n", ((unsigned long) arrayGet(arrayGet(indexes, current), numberOfPaths)), delayEstimate);
+//printf("delayEstimate for %d flows is %.2f\n", ctx->pathsThrough[slot], delayEstimate);
 //printf("Worst clique found is %lu\n", worstClique);
 
-		currentEstimate += ((float) ((unsigned long) arrayGet(arrayGet(indexes, current), numberOfPaths))) / (delayEstimate + worstClique);
+		currentEstimate += ((float) ctx->pathsThrough[slot]) / (delayEstimate + worstClique);
 		
 //printf("New estimate = %e\n", currentEstimate);
 
@@ -193,6 +254,8 @@ float heuristicMultiplePathNewlowerBound(t_graph * graph, t_array * paths, float
 
 	}
 
+	heuristicCtxRelease(ctx);
+
 	return(1.0/worstEstimate);
 }
 
@@ -507,3 +570,335 @@ float heuristicEstimateCost(t_graph * graph, t_array * paths) {
 	return(heuristicMultiplePathInterFlowUpperUpperBound(graph, paths) / 3);
 }
 
+/*
+ * Lower bounds on the cost computed by simulationh2: the sum over
+ * flows of 1 - flowTime / meanInterval, where each delivered packet
+ * is weighted by the product of the delivery factors of its hops.
+ * Both use the graph's link table, which must be built (linkTableGet)
+ * before they are called from several threads.
+ */
+
+/*
+ * A flow delivers at most one packet per flowTime, weighted by the
+ * delivery probability of its path.
+ */
+float heuristicPathCostLowerBound(t_graph * graph, t_array * path) {
+
+	t_linkTable * linkTable;
+	double deliveryProbability;
+	int i;
+
+	linkTable = linkTableGet(graph);
+	deliveryProbability = 1.0;
+	for (i = 1; i < arrayLength(path); i++) {
+
+		deliveryProbability *= linkTableLink(linkTable, (long) arrayGet(path, i - 1), (long) arrayGet(path, i))->deliveryFactor;
+	}
+
+	return(1.0 - deliveryProbability);
+}
+
+/*
+ * Links conflict as in simulationh2.c.
+ */
+#define HEURISTIC_CONFLICT_LIMIAR	(GRAPH_MULTIPLIER / 0.01)
+
+/*
+ * Smallest total cost of the flows when the hops of a clique of
+ * mutually conflicting links take airTime[f] per packet of flow f:
+ *   sum_f rate_f * airTime[f] <= 1, rate_f <= 1 / flowTime_f.
+ * The largest delivered weight under that constraint is a fractional
+ * knapsack, solved greedily. used is scratch space.
+ */
+static double heuristicCliqueBound(double * weight, double * airTime, t_array * flowTimes, int numberOfPaths, char * used) {
+
+	double capacity, rate, bound;
+	int f, g, best;
+
+	for (f = 0; f < numberOfPaths; f++) used[f] = 0;
+
+	bound = 0;
+	capacity = 1.0;
+	for (g = 0; g < numberOfPaths; g++) {
+
+		/*
+		 * Next flow with the highest weight per unit of air time.
+		 */
+		best = -1;
+		for (f = 0; f < numberOfPaths; f++) {
+
+			if (used[f]) continue ;
+			if (best < 0 || weight[f] * airTime[best] > weight[best] * airTime[f]) best = f;
+		}
+		used[best] = 1;
+
+		rate = 1.0 / (long) arrayGet(flowTimes, best);
+		if (airTime[best] > 0 && rate * airTime[best] > capacity) rate = capacity / airTime[best];
+		capacity -= rate * airTime[best];
+		bound += 1.0 - weight[best] * rate;
+	}
+
+	return(bound);
+}
+
+/*
+ * Bound for the first numberOfPaths entries of paths. Every attempt
+ * of every hop is transmitted, so the rates of the flows must fit in
+ * the air time of each clique of the conflict relation. Two cliques
+ * are tried for each node v of a hop: the hops incident to v, and
+ * those plus the hops sent by a node u with a link to v. The worst
+ * clique gives the bound.
+ */
+float heuristicCostLowerBound(t_heuristicCtx * ctx, t_graph * graph, t_array * paths, int numberOfPaths, t_array * flowTimes) {
+
+	t_linkTable * linkTable;
+	t_linkParams * link;
+	t_array * path;
+	double * weight, * hopAirTime, * airTime;
+	double cliqueBound, bound, independentBound;
+	int numberOfNodes, numberOfNeighbors, numberOfHops, f, h, i, s, u, v, node, tail;
+	int * neighbors, * hopFlow, * hopHead, * hopTail;
+
+	linkTable = linkTableGet(graph);
+
+	numberOfNodes = 0;
+	for (f = 0; f < numberOfPaths; f++) numberOfNodes += arrayLength(arrayGet(paths, f));
+	heuristicCtxReserve(ctx, numberOfNodes, numberOfPaths);
+
+	weight = ctx->weight;
+	airTime = ctx->airTime;
+	hopAirTime = ctx->hopAirTime;
+	hopFlow = ctx->hopFlow;
+	hopHead = ctx->hopHead;
+	hopTail = ctx->hopTail;
+
+	/*
+	 * The nodes of the hops that may conflict get a slot.
+	 */
+	h = 0;
+	independentBound = 0;
+	for (f = 0; f < numberOfPaths; f++) {
+
+		path = arrayGet(paths, f);
+		weight[f] = 1.0;
+		for (i = 1; i < arrayLength(path); i++) {
+
+			node = (long) arrayGet(path, i - 1);
+			tail = (long) arrayGet(path, i);
+			link = linkTableLink(linkTable, node, tail);
+			weight[f] *= link->deliveryFactor;
+
+			/*
+			 * Hops over links that do not reach the conflict
+			 * threshold may not conflict with the others.
+			 */
+			if (graphGetCost(graph, node, tail) >= HEURISTIC_CONFLICT_LIMIAR) continue ;
+
+			hopFlow[h] = f;
+			hopHead[h] = node;
+			hopTail[h] = tail;
+			hopAirTime[h] = (double) link->airTime * link->numberOfRetries;
+			heuristicCtxSlot(ctx, node, 0);
+			heuristicCtxSlot(ctx, tail, 0);
+			h++;
+		}
+		independentBound += 1.0 - weight[f];
+
+		/*
+		 * From now on, weight is the delivered weight per unit of
+		 * rate, relative to the flow's target rate.
+		 */
+		weight[f] *= (long) arrayGet(flowTimes, f);
+	}
+	numberOfHops = h;
+
+	bound = independentBound;
+	for (s = 0; s < ctx->numberOfSlots; s++) {
+
+		v = ctx->slotNode[s];
+
+		/*
+		 * u = v stands for the clique of the hops incident to v.
+		 */
+		neighbors = linkTableNeighbors(linkTable, v, & numberOfNeighbors);
+		for (i = -1; i < numberOfNeighbors; i++) {
+
+			u = i < 0 ? v : neighbors[i];
+			if (u != v && (!ctx->nodeSlot[u] || graphGetCost(graph, u, v) >= HEURISTIC_CONFLICT_LIMIAR)) continue ;
+
+			for (f = 0; f < numberOfPaths; f++) airTime[f] = 0;
+			for (h = 0; h < numberOfHops; h++) {
+
+				if (hopHead[h] == v || hopTail[h] == v || hopHead[h] == u) airTime[hopFlow[h]] += hopAirTime[h];
+			}
+
+			cliqueBound = heuristicCliqueBound(weight, airTime, flowTimes, numberOfPaths, ctx->used);
+			if (cliqueBound > bound) bound = cliqueBound;
+		}
+	}
+
+	heuristicCtxRelease(ctx);
+
+	return(bound);
+}
+
+/*
+ * Cliques of node v: (v, v), the hops incident to v, then (v, u) for
+ * each neighbor u of v, in the order of linkTableNeighbors.
+ */
+static inline int heuristicBoundClique(t_linkTable * linkTable, int v) {
+
+	return(linkTable->neighborStart[v] + v);
+}
+
+t_heuristicBound * heuristicBoundNew(t_graph * graph, t_array * flowTimes, int numberOfPaths) {
+
+	t_heuristicBound * bound;
+	t_linkTable * linkTable;
+	int numberOfNodes, numberOfCliques, numberOfNeighbors, v, i, u;
+	int * neighbors;
+
+	linkTable = linkTableGet(graph);
+	numberOfNodes = linkTable->numberOfNodes;
+	numberOfCliques = heuristicBoundClique(linkTable, numberOfNodes);
+
+	MALLOC(bound, sizeof(t_heuristicBound));
+	bound->numberOfPaths = numberOfPaths;
+	bound->flowTimes = flowTimes;
+	MALLOC(bound->paths, sizeof(t_array *) * numberOfPaths);
+	MALLOC(bound->delivery, sizeof(double) * numberOfPaths);
+	MALLOC(bound->weight, sizeof(double) * numberOfPaths);
+	MALLOC(bound->used, sizeof(char) * numberOfPaths);
+	MALLOC(bound->nodeHops, sizeof(int) * numberOfNodes);
+	MALLOC(bound->airTime, sizeof(double) * numberOfCliques * numberOfPaths);
+	memset(bound->paths, 0, sizeof(t_array *) * numberOfPaths);
+	memset(bound->nodeHops, 0, sizeof(int) * numberOfNodes);
+	memset(bound->airTime, 0, sizeof(double) * numberOfCliques * numberOfPaths);
+
+	/*
+	 * Cliques (v, u) by u, counted and then placed.
+	 */
+	MALLOC(bound->headStart, sizeof(int) * (numberOfNodes + 1));
+	MALLOC(bound->headCliques, sizeof(int) * (numberOfCliques - numberOfNodes + 1));
+	memset(bound->headStart, 0, sizeof(int) * (numberOfNodes + 1));
+	for (v = 0; v < numberOfNodes; v++) {
+
+		neighbors = linkTableNeighbors(linkTable, v, & numberOfNeighbors);
+		for (i = 0; i < numberOfNeighbors; i++) bound->headStart[neighbors[i] + 1]++;
+	}
+	for (u = 0; u < numberOfNodes; u++) bound->headStart[u + 1] += bound->headStart[u];
+	for (v = 0; v < numberOfNodes; v++) {
+
+		neighbors = linkTableNeighbors(linkTable, v, & numberOfNeighbors);
+		for (i = 0; i < numberOfNeighbors; i++) bound->headCliques[bound->headStart[neighbors[i]]++] = heuristicBoundClique(linkTable, v) + 1 + i;
+	}
+	for (u = numberOfNodes; u > 0; u--) bound->headStart[u] = bound->headStart[u - 1];
+	bound->headStart[0] = 0;
+
+	return(bound);
+}
+
+void heuristicBoundFree(t_heuristicBound * bound) {
+
+	free(bound->paths);
+	free(bound->delivery);
+	free(bound->weight);
+	free(bound->used);
+	free(bound->nodeHops);
+	free(bound->headStart);
+	free(bound->headCliques);
+	free(bound->airTime);
+}
+
+/*
+ * Add the terms of path as the path of flow f or, with add = 0, clear
+ * them. A hop from node to tail is in the cliques of node, in those of
+ * tail and in the cliques (v, node) of the other nodes v. The air time
+ * of a flow in a clique adds up over its hops in path order, as in
+ * heuristicCostLowerBound, so both give the same bound.
+ */
+static void heuristicBoundPath(t_heuristicBound * bound, t_linkTable * linkTable, t_graph * graph, t_array * path, int f, int add) {
+
+	t_linkParams * link;
+	double * airTime = bound->airTime + f, hopAirTime;
+	int i, c, node, tail, tailFirst, tailEnd, numberOfPaths = bound->numberOfPaths;
+
+	if (add) bound->delivery[f] = 1.0;
+	for (i = 1; i < arrayLength(path); i++) {
+
+		node = (long) arrayGet(path, i - 1);
+		tail = (long) arrayGet(path, i);
+		link = linkTableLink(linkTable, node, tail);
+		if (add) bound->delivery[f] *= link->deliveryFactor;
+
+		if (graphGetCost(graph, node, tail) >= HEURISTIC_CONFLICT_LIMIAR) continue ;
+
+		hopAirTime = add ? (double) link->airTime * link->numberOfRetries : 0;
+		bound->nodeHops[node] += add ? 1 : -1;
+		bound->nodeHops[tail] += add ? 1 : -1;
+
+		tailFirst = heuristicBoundClique(linkTable, tail);
+		tailEnd = heuristicBoundClique(linkTable, tail + 1);
+		for (c = heuristicBoundClique(linkTable, node); c < heuristicBoundClique(linkTable, node + 1); c++) {
+
+			if (add) airTime[c * numberOfPaths] += hopAirTime;
+			else airTime[c * numberOfPaths] = 0;
+		}
+		for (c = tailFirst; c < tailEnd; c++) {
+
+			if (add) airTime[c * numberOfPaths] += hopAirTime;
+			else airTime[c * numberOfPaths] = 0;
+		}
+		for (c = bound->headStart[node]; c < bound->headStart[node + 1]; c++) {
+
+			if (bound->headCliques[c] >= tailFirst && bound->headCliques[c] < tailEnd) continue ;
+			if (add) airTime[bound->headCliques[c] * numberOfPaths] += hopAirTime;
+			else airTime[bound->headCliques[c] * numberOfPaths] = 0;
+		}
+	}
+
+	if (add) bound->weight[f] = bound->delivery[f] * (long) arrayGet(bound->flowTimes, f);
+}
+
+/*
+ * heuristicCostLowerBound(ctx, graph, paths, arrayLength(paths),
+ * flowTimes) for the flowTimes of heuristicBoundNew.
+ */
+float heuristicBoundUpdate(t_heuristicBound * bound, t_graph * graph, t_array * paths) {
+
+	t_linkTable * linkTable;
+	double cliqueBound, result;
+	int numberOfNeighbors, f, i, u, v, numberOfPaths = bound->numberOfPaths;
+	int * neighbors;
+
+	linkTable = linkTableGet(graph);
+
+	for (f = 0; f < numberOfPaths; f++) {
+
+		if (arrayGet(paths, f) == bound->paths[f]) continue ;
+
+		if (bound->paths[f]) heuristicBoundPath(bound, linkTable, graph, bound->paths[f], f, 0);
+		bound->paths[f] = arrayGet(paths, f);
+		heuristicBoundPath(bound, linkTable, graph, bound->paths[f], f, 1);
+	}
+
+	result = 0;
+	for (f = 0; f < numberOfPaths; f++) result += 1.0 - bound->delivery[f];
+
+	for (v = 0; v < linkTable->numberOfNodes; v++) {
+
+		if (!bound->nodeHops[v]) continue ;
+
+		neighbors = linkTableNeighbors(linkTable, v, & numberOfNeighbors);
+		for (i = -1; i < numberOfNeighbors; i++) {
+
+			u = i < 0 ? v : neighbors[i];
+			if (u != v && (!bound->nodeHops[u] || graphGetCost(graph, u, v) >= HEURISTIC_CONFLICT_LIMIAR)) continue ;
+
+			cliqueBound = heuristicCliqueBound(bound->weight, & bound->airTime[(heuristicBoundClique(linkTable, v) + 1 + i) * numberOfPaths], bound->flowTimes, numberOfPaths, bound->used);
+			if (cliqueBound > result) result = cliqueBound;
+		}
+	}
+
+	return(result);
+}
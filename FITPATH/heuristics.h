@@ -1,9 +1,77 @@
 #ifndef __HEURISTIC_H__
 #define __HEURISTIC_H__
 
-void heuristicInit(int numberOfNodes, int numberOfPaths);
-void heuristicFinalize();
-float heuristicMultiplePathNewlowerBound(t_graph * graph, t_array * paths, float * costs, float breakAt);
+#include <stdint.h>
+
+#include "array.h"
+#include "graph.h"
+
+/*
+ * Scratch space of the bounds below. The per node map is all zeros
+ * between calls: a call gives a slot to each node its paths visit,
+ * keeps its per node values there and, before returning, clears only
+ * the nodes it gave a slot to. A call thus costs the number of hops of
+ * its paths, not the number of nodes of the graph. The slot and path
+ * arrays grow with the largest call. Calls on different contexts may
+ * run at the same time; each thread needs its own.
+ */
+typedef struct {
+
+	int numberOfNodes;
+	int * nodeSlot;				// Per node: 1 + its slot, or 0.
+	int numberOfSlots;
+	int slotCapacity;
+	int pathCapacity;
+
+	/*
+	 * Per slot: the node, the weights of the links leaving and
+	 * entering it, the number of paths through it and, in
+	 * indexes[slot * pathCapacity + path], its 1-based position
+	 * in each path (0 if the path does not visit it).
+	 */
+	int * slotNode;
+	int64_t * outputWeights;
+	int64_t * inputWeights;
+	int * pathsThrough;
+	int * indexes;
+	int * candidates;
+
+	/*
+	 * Per hop and per path, for heuristicCostLowerBound.
+	 */
+	double * hopAirTime;
+	int * hopFlow, * hopHead, * hopTail;
+	double * weight, * airTime;
+	char * used;
+} t_heuristicCtx;
+
+/*
+ * heuristicCostLowerBound kept up to date along a walk that changes
+ * the paths of a few flows at a time, as the Gray-code walk of
+ * neighborhood.h does. Every clique (v, u) of heuristicCostLowerBound
+ * keeps the air time each flow takes in it, and each flow its weight;
+ * heuristicBoundUpdate recomputes them only for the flows whose path
+ * changed since the previous call, then takes the worst clique again.
+ * Paths are told apart by their address, so a path must not change
+ * while it is in use. Each thread needs its own.
+ */
+typedef struct {
+
+	int numberOfPaths;
+	t_array * flowTimes;
+	t_array ** paths;			// Per flow: the path of its terms (NULL before the first call).
+	double * delivery;			// Per flow: delivery probability of its path.
+	double * weight;			// Per flow: delivered weight per unit of rate.
+	int * nodeHops;				// Per node: conflicting hops incident to it.
+	int * headStart;			// Per node u: cliques (v, u), v != u, are
+	int * headCliques;			// headCliques[headStart[u]] to headCliques[headStart[u + 1] - 1].
+	double * airTime;			// airTime[clique * numberOfPaths + f], cliques as in heuristicBoundClique.
+	char * used;
+} t_heuristicBound;
+
+t_heuristicCtx * heuristicCtxNew(int numberOfNodes);
+void heuristicCtxFree(t_heuristicCtx * ctx);
+float heuristicMultiplePathNewlowerBound(t_heuristicCtx * ctx, t_graph * graph, t_array * paths, float * costs, float breakAt);
 //float heuristicMultiplePathNewlowerBound(t_graph * graph, float * paths, float breakAt);
 float heuristicSinglePathLowerBound(t_graph * graph, t_array * path);
 float heuristicMultiplePathInterFlowLowerBound(t_graph * graph, t_array * paths);
@@ -11,7 +79,11 @@ float heuristicSinglePathUpperBound(t_graph * graph, t_array * path);
 float heuristicMultiplePathInterFlowUpperUpperBound(t_graph * graph, t_array * paths);
 float heuristicMultiplePathInterFlowLowerUpperBound(t_graph * graph, t_array * paths);
 float heuristicEstimateCost(t_graph * graph, t_array * paths);
+float heuristicPathCostLowerBound(t_graph * graph, t_array * path);
+float heuristicCostLowerBound(t_heuristicCtx * ctx, t_graph * graph, t_array * paths, int numberOfPaths, t_array * flowTimes);
+t_heuristicBound * heuristicBoundNew(t_graph * graph, t_array * flowTimes, int numberOfPaths);
+void heuristicBoundFree(t_heuristicBound * bound);
+float heuristicBoundUpdate(t_heuristicBound * bound, t_graph * graph, t_array * paths);
 
 
 #endif
-
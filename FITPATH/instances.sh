@@ -0,0 +1,42 @@
+# Helpers shared by bench.sh, train.sh and checkRelease.sh, which run
+# the programs on inputs built from data/etx and data/instances. Meant
+# to be sourced from the FITPATH directory.
+
+FLOWTIME=${FLOWTIME:-40000}
+
+# Build an input file from a topology and one instance of an instance
+# file, i.e., the flowsPerInstance source/destination pairs at position
+# instanceNumber (from 1). Every flow gets FLOWTIME.
+#
+#	makeInput <topology> <instance file> <flowsPerInstance> <instanceNumber> <output>
+#
+# The topology files end with a placeholder flow, which is dropped.
+makeInput() {
+
+	local FIRST=$(( ($4 - 1) * $3 + 1 ))
+	local LAST=$(( $4 * $3 ))
+
+	(
+		sed '/^Source/,$d' data/etx/$1
+		echo Source
+		sed -n "${FIRST},${LAST}p" data/instances/$2 | awk '{print $1}'
+		echo Destination
+		sed -n "${FIRST},${LAST}p" data/instances/$2 | awk '{print $2}'
+		echo FlowTime
+		for i in $(seq $3); do echo $FLOWTIME; done
+	) > $5
+}
+
+# Number of nodes of the topology in an input file.
+numberOfNodes() {
+
+	sed '/^Source/,$d' $1 | awk '/Links/{next;} {if ($1 >= nnodes) nnodes = $1 + 1; if ($2 >= nnodes) nnodes = $2 + 1;} END{print nnodes}'
+}
+
+# Working directory for fitpath, which writes its routes to ../inst
+# relative to where it runs. Prints the directory to run it from.
+makeRunDir() {
+
+	mkdir -p $1/inst/newILS $1/inst/delay $1/run
+	echo $1/run
+}
@@ -0,0 +1,185 @@
+#ifndef __INTVEC_H__
+#define __INTVEC_H__
+
+#include <stdint.h>
+#include <string.h>
+
+#include "array.h"
+#include "memory.h"
+
+/*
+ * Integer vectors for what t_array would box into void pointers:
+ * counters, flags and per flow totals. Elements have their own size
+ * and are stored contiguously, and every accessor is inlined. The
+ * structs are meant to be embedded by value; Init and Free handle
+ * the storage only.
+ */
+typedef struct {
+
+	int32_t * data;
+	int length;
+} t_intVec;
+
+typedef struct {
+
+	int64_t * data;
+	int length;
+} t_longVec;
+
+/*
+ * A path as its node ids, source first.
+ */
+typedef struct {
+
+	uint16_t * nodes;
+	int length;
+} t_u16Path;
+
+static inline void intVecInit(t_intVec * vec, int length) {
+
+	MALLOC(vec->data, (length ? length : 1) * sizeof(int32_t));
+	memset(vec->data, 0, length * sizeof(int32_t));
+	vec->length = length;
+}
+
+static inline int32_t intVecGet(const t_intVec * vec, int index) {
+
+	return(vec->data[index]);
+}
+
+static inline void intVecSet(t_intVec * vec, int index, int32_t value) {
+
+	vec->data[index] = value;
+}
+
+static inline void intVecInc(t_intVec * vec, int index) {
+
+	vec->data[index]++;
+}
+
+static inline void intVecDec(t_intVec * vec, int index) {
+
+	vec->data[index]--;
+}
+
+static inline void intVecAdd(t_intVec * vec, int index, int32_t amount) {
+
+	vec->data[index] += amount;
+}
+
+static inline void intVecClear(t_intVec * vec) {
+
+	memset(vec->data, 0, vec->length * sizeof(int32_t));
+}
+
+static inline int intVecLength(const t_intVec * vec) {
+
+	return(vec->length);
+}
+
+static inline void intVecFree(t_intVec * vec) {
+
+	free(vec->data);
+}
+
+static inline void longVecInit(t_longVec * vec, int length) {
+
+	MALLOC(vec->data, (length ? length : 1) * sizeof(int64_t));
+	memset(vec->data, 0, length * sizeof(int64_t));
+	vec->length = length;
+}
+
+static inline int64_t longVecGet(const t_longVec * vec, int index) {
+
+	return(vec->data[index]);
+}
+
+static inline void longVecSet(t_longVec * vec, int index, int64_t value) {
+
+	vec->data[index] = value;
+}
+
+static inline void longVecInc(t_longVec * vec, int index) {
+
+	vec->data[index]++;
+}
+
+static inline void longVecAdd(t_longVec * vec, int index, int64_t amount) {
+
+	vec->data[index] += amount;
+}
+
+static inline void longVecClear(t_longVec * vec) {
+
+	memset(vec->data, 0, vec->length * sizeof(int64_t));
+}
+
+static inline int longVecLength(const t_longVec * vec) {
+
+	return(vec->length);
+}
+
+/*
+ * Copy the first min(lengths) elements of src into dst.
+ */
+static inline void longVecCopy(t_longVec * dst, const t_longVec * src) {
+
+	memcpy(dst->data, src->data, (dst->length < src->length ? dst->length : src->length) * sizeof(int64_t));
+}
+
+static inline void longVecFree(t_longVec * vec) {
+
+	free(vec->data);
+}
+
+/*
+ * Pack a path held as a t_array of node ids. Node ids must fit in 16
+ * bits, which covers every topology in data/.
+ */
+static inline void u16PathInit(t_u16Path * path, t_array * nodes) {
+
+	long node;
+	int i;
+
+	path->length = arrayLength(nodes);
+	MALLOC(path->nodes, (path->length ? path->length : 1) * sizeof(uint16_t));
+	for (i = 0; i < path->length; i++) {
+
+		node = (long) arrayGet(nodes, i);
+		if (node < 0 || node > UINT16_MAX) {
+
+			fprintf(stderr, "Node %ld does not fit in a t_u16Path\n", node);
+			exit(1);
+		}
+		path->nodes[i] = node;
+	}
+}
+
+static inline void u16PathCopy(t_u16Path * dst, const t_u16Path * src) {
+
+	dst->length = src->length;
+	MALLOC(dst->nodes, (src->length ? src->length : 1) * sizeof(uint16_t));
+	memcpy(dst->nodes, src->nodes, src->length * sizeof(uint16_t));
+}
+
+static inline long u16PathNode(const t_u16Path * path, int index) {
+
+	return(path->nodes[index]);
+}
+
+static inline int u16PathLength(const t_u16Path * path) {
+
+	return(path->length);
+}
+
+static inline int u16PathEquals(const t_u16Path * path1, const t_u16Path * path2) {
+
+	return(path1->length == path2->length && !memcmp(path1->nodes, path2->nodes, path1->length * sizeof(uint16_t)));
+}
+
+static inline void u16PathFree(t_u16Path * path) {
+
+	free(path->nodes);
+}
+
+#endif
@@ -0,0 +1,105 @@
+#define _ISOC99_SOURCE
+#include <math.h>
+#include <string.h>
+
+#include "linkTable.h"
+#include "graph.h"
+#include "list.h"
+#include "memory.h"
+
+/*
+ * Fill the parameters of the link src -> dst. The expressions are
+ * the ones the simulator used to evaluate on every call, kept in
+ * the same order so results do not change.
+ */
+static void linkTableCompute(t_linkParams * link, t_weight cost) {
+
+	double tmp;
+
+	tmp = (double) GRAPH_MULTIPLIER / (double) cost;
+	link->airTime = GRAPH_MULTIPLIER * ((tmp * (1 + (1-tmp) * (2 + (1-tmp) * 3))) + 4 * (1-tmp) * (1-tmp) * (1-tmp));
+	link->numberOfRetries = round((double) link->airTime / (double) GRAPH_MULTIPLIER);
+	// link->backoffUnit = ((tmp * (15.5 + (1-tmp) * (47 + (1-tmp) * 110.5))) + 238 * (1-tmp) * (1-tmp) * (1-tmp)); //802.11b
+	link->backoffUnit = ((tmp * (7.5 + (1-tmp) * (23 + (1-tmp) * 54.5))) + 118 * (1-tmp) * (1-tmp) * (1-tmp)); //802.11g
+	link->backoffUnit /= ((1 << link->numberOfRetries) - 1);
+	link->airTime /= link->numberOfRetries;
+
+	link->successProbability = sqrt(tmp);
+	tmp = 1 - link->successProbability;
+	link->deliveryFactor = (1 - tmp * tmp * tmp * tmp);
+}
+
+t_linkTable * linkTableNew(t_graph * graph) {
+
+	t_linkTable * linkTable;
+	t_smallVec * neighbors;
+	t_weight cost;
+	int * neighbor;
+	int n, i, j;
+
+	n = graphSize(graph);
+
+	MALLOC(linkTable, sizeof(t_linkTable));
+	MALLOC(linkTable->params, sizeof(t_linkParams) * n * n);
+	memset(linkTable->params, 0, sizeof(t_linkParams) * n * n);
+	linkTable->numberOfNodes = n;
+
+	for (i = 0; i < n; i++) {
+		for (j = 0; j < n; j++) {
+
+			cost = graphGetCost(graph, i, j);
+			if (i == j || cost == 0 || cost == GRAPH_INFINITY) continue ;
+
+			linkTableCompute(linkTableLink(linkTable, i, j), cost);
+		}
+	}
+
+	MALLOC(linkTable->neighborStart, sizeof(int) * (n + 1));
+	linkTable->neighborStart[0] = 0;
+	for (i = 0; i < n; i++) {
+
+		linkTable->neighborStart[i + 1] = linkTable->neighborStart[i] + smallVecLength(graphGetNeighbors(graph, i));
+	}
+
+	MALLOC(linkTable->neighbors, sizeof(int) * (linkTable->neighborStart[n] + 1));
+	for (i = 0; i < n; i++) {
+
+		j = linkTable->neighborStart[i];
+		neighbors = graphGetNeighbors(graph, i);
+		for (neighbor = smallVecBegin(neighbors); neighbor < smallVecEnd(neighbors); neighbor++) {
+
+			linkTable->neighbors[j++] = * neighbor;
+		}
+	}
+
+	return(linkTable);
+}
+
+static void linkTableRelease(void * linkTable) {
+
+	linkTableFree(linkTable);
+	free(linkTable);
+}
+
+/*
+ * Return the table of the graph, building it on first use.
+ */
+t_linkTable * linkTableGet(t_graph * graph) {
+
+	t_linkTable * linkTable;
+
+	linkTable = graphGetLinkData(graph);
+	if (linkTable) return(linkTable);
+
+	linkTable = linkTableNew(graph);
+	graphSetLinkData(graph, linkTable, linkTableRelease);
+
+	return(linkTable);
+}
+
+void linkTableFree(t_linkTable * linkTable) {
+
+	free(linkTable->params);
+	free(linkTable->neighborStart);
+	free(linkTable->neighbors);
+}
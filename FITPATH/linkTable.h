@@ -0,0 +1,49 @@
+#ifndef __LINKTABLE_H__
+#define __LINKTABLE_H__
+
+#include "graph.h"
+
+/*
+ * Per-link parameters of the MAC model used by the simulator.
+ * They depend only on the ETX of the physical link, so they are
+ * computed once per graph and shared by every simulation.
+ */
+typedef struct {
+
+	t_weight airTime;			// Air time of a single transmission attempt.
+	double backoffUnit;			// Mean backoff (in slots) of the first attempt.
+	double successProbability;	// sqrt(1 / ETX): one-way success probability.
+	double deliveryFactor;		// 1 - (1 - sqrt(1 / ETX))^4: delivery probability.
+	unsigned char numberOfRetries;
+} t_linkParams;
+
+/*
+ * Neighbors are stored in compressed form: the neighbors of node i
+ * are neighbors[neighborStart[i]] to neighbors[neighborStart[i + 1] - 1].
+ * Unlike the graph's neighbor lists, they can be walked by several
+ * threads at once.
+ */
+typedef struct {
+
+	int numberOfNodes;
+	t_linkParams * params;
+	int * neighborStart;
+	int * neighbors;
+} t_linkTable;
+
+t_linkTable * linkTableNew(t_graph * graph);
+t_linkTable * linkTableGet(t_graph * graph);
+void linkTableFree(t_linkTable * linkTable);
+
+static inline t_linkParams * linkTableLink(t_linkTable * linkTable, int src, int dst) {
+
+	return(& linkTable->params[src * linkTable->numberOfNodes + dst]);
+}
+
+static inline int * linkTableNeighbors(t_linkTable * linkTable, int node, int * numberOfNeighbors) {
+
+	* numberOfNeighbors = linkTable->neighborStart[node + 1] - linkTable->neighborStart[node];
+	return(& linkTable->neighbors[linkTable->neighborStart[node]]);
+}
+
+#endif
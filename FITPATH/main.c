@@ -98,7 +98,6 @@ printf("initial guest of cost is %f\n", bestCost);
 		arraySet(currentPaths, i, prefixTreePath(path));
 		upperBound += prefixTreeGetUpperBound(path);
 	}
-heuristicInit(graphSize(graph), numberOfPairs);
 	run = 1;
 	while(run) {
 		currentCost = simulationSimulate(graph, currentPaths);
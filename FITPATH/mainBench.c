@@ -0,0 +1,273 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+
+#include <math.h>
+
+#include "parser.h"
+#include "graph.h"
+#include "yen.h"
+#include "prefixTree.h"
+#include "list.h"
+#include "array.h"
+#include "memory.h"
+
+/*
+ * The simulators before simulationh2 take no flow times and return
+ * only the cost. This file is compiled once for each interface
+ * (mainBench.o and mainBenchLegacy.o) and linked with every variant.
+ */
+#ifdef BENCH_LEGACY_SIMULATOR
+#include "simulation.h"
+#else
+#include "simulationh2.h"
+#endif
+
+/*
+ * Throughput benchmark of path generation (yen) and of the simulator
+ * linked in. Each measurement is repeated and summarised over the
+ * repetitions; the path sets simulated are drawn with a fixed seed,
+ * so every variant and every run simulates the same ones. Results are
+ * written as JSON Lines.
+ */
+
+typedef struct {
+
+	double mean;
+	double stddev;
+	double min;
+	double median;
+	double max;
+} t_summary;
+
+double benchNow(void) {
+
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, & now);
+
+	return(now.tv_sec + now.tv_nsec / 1e9);
+}
+
+int compareDoubles(const void * a, const void * b) {
+
+	double x = * (const double *) a, y = * (const double *) b;
+
+	return((x > y) - (x < y));
+}
+
+void benchSummarise(double * samples, int n, t_summary * summary) {
+
+	double sum = 0, squares = 0;
+	int i;
+
+	qsort(samples, n, sizeof(double), compareDoubles);
+	for (i = 0; i < n; i++) sum += samples[i];
+	summary->mean = sum / n;
+	for (i = 0; i < n; i++) squares += (samples[i] - summary->mean) * (samples[i] - summary->mean);
+	summary->stddev = n > 1 ? sqrt(squares / (n - 1)) : 0;
+	summary->min = samples[0];
+	summary->max = samples[n - 1];
+	summary->median = n % 2 ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2;
+}
+
+void benchReport(FILE * results, char * program, char * benchmark, char * input, unsigned int seed, int runs, char * unit, double * samples) {
+
+	t_summary summary;
+
+	benchSummarise(samples, runs, & summary);
+	fprintf(results, "{\"program\":\"%s\",\"benchmark\":\"%s\",\"input\":\"%s\",\"seed\":%u,\"runs\":%d,\"unit\":\"%s\","
+		"\"mean\":%.3f,\"stddev\":%.3f,\"min\":%.3f,\"median\":%.3f,\"max\":%.3f}\n",
+		program, benchmark, input, seed, runs, unit, summary.mean, summary.stddev, summary.min, summary.median, summary.max);
+	fflush(results);
+}
+
+int main(int argc, char ** argv) {
+
+	t_graph * graph;
+	t_list * src, * dst, * flt, * pathList;
+	t_list ** pathLists;
+	t_array *** candidates;
+	t_array ** pathSets;
+	t_array * flowTimes, * txDurations;
+	t_prefixTreeNode * path;
+	int * numberOfCandidates, * currentSrc, * currentDst, * currentFlt;
+	int numberOfFlows, numberOfPaths = 10, numberOfPathSets = 50, runs = 5;
+	unsigned int seed = 1, state;
+	unsigned long generated;
+	double * samples, start;
+	char * program;
+	FILE * results;
+	int c, f, k, i, run;
+
+	while ((c = getopt(argc, argv, "r:n:k:s:")) != -1) {
+
+		switch(c) {
+
+			case 'r':
+				runs = atoi(optarg);
+				break ;
+
+			case 'n':
+				numberOfPathSets = atoi(optarg);
+				break ;
+
+			case 'k':
+				numberOfPaths = atoi(optarg);
+				break ;
+
+			case 's':
+				seed = strtoul(optarg, NULL, 10);
+				break ;
+
+			default:
+				fprintf(stderr, "Use: %s [-r runs] [-n pathSets] [-k paths] [-s seed] <input>\n", argv[0]);
+				exit(1);
+		}
+	}
+
+	if (argc - optind != 1 || runs < 1 || numberOfPathSets < 1 || numberOfPaths < 1) {
+
+		fprintf(stderr, "Use: %s [-r runs] [-n pathSets] [-k paths] [-s seed] <input>\n", argv[0]);
+		exit(1);
+	}
+
+	/*
+	 * Several simulators print their progress to stdout. The results
+	 * go to a copy of it, and stdout itself to /dev/null.
+	 */
+	results = fdopen(dup(STDOUT_FILENO), "w");
+	if (!results || !freopen("/dev/null", "w", stdout)) {
+
+		fprintf(stderr, "Could not redirect the standard output\n");
+		exit(1);
+	}
+
+	program = strrchr(argv[0], '/') ? strrchr(argv[0], '/') + 1 : argv[0];
+	graph = parserParse(argv[optind], & src, & dst, & flt);
+	numberOfFlows = listLength(src);
+	if (numberOfFlows == 0 || listLength(dst) != numberOfFlows || listLength(flt) != numberOfFlows) {
+
+		fprintf(stderr, "%s: expected the same number of sources, destinations and flow times\n", argv[optind]);
+		exit(1);
+	}
+
+	MALLOC(samples, sizeof(double) * runs);
+	MALLOC(pathLists, sizeof(t_list *) * numberOfFlows);
+
+	/*
+	 * Paths generated per second. The paths of the last run are kept.
+	 */
+	for (run = 0; run < runs; run++) {
+
+		generated = 0;
+		start = benchNow();
+		currentSrc = listBegin(src);
+		currentDst = listBegin(dst);
+		for (f = 0; f < numberOfFlows; f++) {
+
+			if (run) {
+
+				for (path = listBegin(pathLists[f]); path; path = listNext(pathLists[f])) prefixTreePrune(path);
+				listFree(pathLists[f]);
+				free(pathLists[f]);
+			}
+			pathLists[f] = yen(graph, * currentSrc, * currentDst, numberOfPaths);
+			generated += listLength(pathLists[f]);
+			currentSrc = listNext(src);
+			currentDst = listNext(dst);
+		}
+		samples[run] = generated / (benchNow() - start);
+	}
+	benchReport(results, program, "yen", argv[optind], seed, runs, "paths/s", samples);
+
+	flowTimes = arrayNew(numberOfFlows);
+	txDurations = arrayNew(numberOfFlows);
+	MALLOC(candidates, sizeof(t_array **) * numberOfFlows);
+	MALLOC(numberOfCandidates, sizeof(int) * numberOfFlows);
+	currentFlt = listBegin(flt);
+	for (f = 0; f < numberOfFlows; f++) {
+
+		pathList = pathLists[f];
+		if (listLength(pathList) == 0) {
+
+			fprintf(stderr, "%s: no path for flow %d\n", argv[optind], f);
+			exit(1);
+		}
+		numberOfCandidates[f] = listLength(pathList);
+		MALLOC(candidates[f], sizeof(t_array *) * listLength(pathList));
+		for (k = 0, path = listBegin(pathList); path; path = listNext(pathList), k++) candidates[f][k] = prefixTreePath(path);
+
+		arraySet(flowTimes, f, (void *) (long) * currentFlt);
+		arraySet(txDurations, f, (void *) 238L);
+		currentFlt = listNext(flt);
+	}
+
+	/*
+	 * The path sets: the shortest paths first, then random mixes.
+	 */
+	MALLOC(pathSets, sizeof(t_array *) * numberOfPathSets);
+	state = seed;
+	for (i = 0; i < numberOfPathSets; i++) {
+
+		pathSets[i] = arrayNew(numberOfFlows);
+		for (f = 0; f < numberOfFlows; f++) arraySet(pathSets[i], f, candidates[f][i ? rand_r(& state) % numberOfCandidates[f] : 0]);
+	}
+
+	/*
+	 * Simulations per second.
+	 */
+	for (run = 0; run < runs; run++) {
+
+		start = benchNow();
+		for (i = 0; i < numberOfPathSets; i++) {
+
+#ifdef BENCH_LEGACY_SIMULATOR
+			simulationSimulate(graph, pathSets[i]);
+#else
+			t_return * r = simulationSimulate(graph, pathSets[i], flowTimes, txDurations);
+
+			simulationReturnFree(r);
+			free(r);
+#endif
+		}
+		samples[run] = numberOfPathSets / (benchNow() - start);
+	}
+	benchReport(results, program, "simulate", argv[optind], seed, runs, "simulations/s", samples);
+
+	for (i = 0; i < numberOfPathSets; i++) {
+
+		arrayFree(pathSets[i]);
+		free(pathSets[i]);
+	}
+	free(pathSets);
+	for (f = 0; f < numberOfFlows; f++) {
+
+		free(candidates[f]);
+		for (path = listBegin(pathLists[f]); path; path = listNext(pathLists[f])) prefixTreePrune(path);
+		listFree(pathLists[f]);
+		free(pathLists[f]);
+	}
+	free(candidates);
+	free(numberOfCandidates);
+	free(pathLists);
+	free(samples);
+	arrayFree(flowTimes);
+	free(flowTimes);
+	arrayFree(txDurations);
+	free(txDurations);
+	listFreeWithData(src);
+	free(src);
+	listFreeWithData(dst);
+	free(dst);
+	listFreeWithData(flt);
+	free(flt);
+	graphFree(graph);
+	free(graph);
+	fclose(results);
+
+	return(0);
+}
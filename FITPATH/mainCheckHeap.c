@@ -0,0 +1,247 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "heap.h"
+#include "floatHeap.h"
+#include "memory.h"
+
+/*
+ * Keys are drawn below MAX_KEY, so that many are equal, and every
+ * key is an integer that both variants hold exactly.
+ */
+#define MAX_KEY			1000
+#define MAX_ELEMENTS	4096
+
+/*
+ * The two variants of heapImpl.h behind one interface, with the keys
+ * passed as doubles.
+ */
+typedef struct {
+
+	char * name;
+	void * (* new)(void);
+	void (* reserve)(void * heap, int numberOfElements);
+	int (* add)(void * heap, void * element, double key);
+	void (* decreaseKey)(void * heap, int handle, double key);
+	int (* contains)(void * heap, int handle);
+	void * (* extractMinimum)(void * heap, double * key);
+	double (* topKey)(void * heap);
+	int (* size)(void * heap);
+	void (* free)(void * heap);
+} t_heapVariant;
+
+static void * weightNew(void) { return(heapNew()); }
+static void weightReserve(void * heap, int numberOfElements) { heapReserve(heap, numberOfElements); }
+static int weightAdd(void * heap, void * element, double key) { return(heapAdd(heap, element, (t_weight) key)); }
+static void weightDecreaseKey(void * heap, int handle, double key) { heapDecreaseKey(heap, handle, (t_weight) key); }
+static int weightContains(void * heap, int handle) { return(heapContains(heap, handle)); }
+static double weightTopKey(void * heap) { return((double) heapTopKey(heap)); }
+static int weightSize(void * heap) { return(heapSize(heap)); }
+static void weightFree(void * heap) { heapFree(heap); free(heap); }
+
+static void * weightExtractMinimum(void * heap, double * key) {
+
+	t_weight weightKey = 0;
+	void * element;
+
+	element = heapExtractMinimum(heap, & weightKey);
+	* key = (double) weightKey;
+
+	return(element);
+}
+
+static void * floatNew(void) { return(floatHeapNew()); }
+static void floatReserve(void * heap, int numberOfElements) { floatHeapReserve(heap, numberOfElements); }
+static int floatAdd(void * heap, void * element, double key) { return(floatHeapAdd(heap, element, key)); }
+static void floatDecreaseKey(void * heap, int handle, double key) { floatHeapDecreaseKey(heap, handle, key); }
+static int floatContains(void * heap, int handle) { return(floatHeapContains(heap, handle)); }
+static void * floatExtractMinimum(void * heap, double * key) { return(floatHeapExtractMinimum(heap, key)); }
+static double floatTopKey(void * heap) { return(floatHeapTopKey(heap)); }
+static int floatSize(void * heap) { return(floatHeapSize(heap)); }
+static void floatFree(void * heap) { floatHeapFree(heap); free(heap); }
+
+t_heapVariant variants[] = {
+	{"heap", weightNew, weightReserve, weightAdd, weightDecreaseKey, weightContains, weightExtractMinimum, weightTopKey, weightSize, weightFree},
+	{"floatHeap", floatNew, floatReserve, floatAdd, floatDecreaseKey, floatContains, floatExtractMinimum, floatTopKey, floatSize, floatFree},
+};
+
+/*
+ * Reference: the key and the element of every handle in the heap.
+ * Elements are distinct non NULL pointers.
+ */
+double referenceKey[MAX_ELEMENTS];
+void * referenceElement[MAX_ELEMENTS];
+char referenceIn[MAX_ELEMENTS];
+int referenceSize;
+
+double referenceMinimum(void) {
+
+	double minimum = MAX_KEY;
+	int handle;
+
+	for (handle = 0; handle < MAX_ELEMENTS; handle++) {
+
+		if (referenceIn[handle] && referenceKey[handle] < minimum) minimum = referenceKey[handle];
+	}
+
+	return(minimum);
+}
+
+/*
+ * A random handle of an element in the heap.
+ */
+int referencePick(void) {
+
+	int handle;
+
+	handle = rand() % MAX_ELEMENTS;
+	while(!referenceIn[handle]) handle = (handle + 1) % MAX_ELEMENTS;
+
+	return(handle);
+}
+
+/*
+ * Random adds, key changes and extractions, checking after each one
+ * the size, the minimum key and heapContains of a random handle. An
+ * extraction must return an element with the minimum key, whose handle
+ * then leaves the heap. Adds prevail in the first half, extractions in
+ * the second, and the heap is emptied at the end.
+ */
+int checkVariant(t_heapVariant * variant, int numberOfOperations) {
+
+	void * heap, * element;
+	double key;
+	int i, handle, add;
+
+	heap = variant->new();
+	memset(referenceIn, 0, sizeof(referenceIn));
+	referenceSize = 0;
+
+	for (i = 0; i < numberOfOperations || referenceSize; i++) {
+
+		if (i == numberOfOperations / 4) variant->reserve(heap, MAX_ELEMENTS);
+
+		add = i < numberOfOperations && referenceSize < MAX_ELEMENTS && rand() % 100 < (i < numberOfOperations / 2 ? 60 : 35);
+
+		if (add) {
+
+			key = rand() % MAX_KEY;
+			element = (void *) (intptr_t) (i + 1);
+			handle = variant->add(heap, element, key);
+			if (handle < 0 || handle >= MAX_ELEMENTS || referenceIn[handle]) {
+
+				fprintf(stderr, "%s operation %d: add returned handle %d, which is in use\n", variant->name, i, handle);
+				return(0);
+			}
+
+			referenceIn[handle] = 1;
+			referenceElement[handle] = element;
+			referenceKey[handle] = key;
+			referenceSize++;
+		}
+		else if (referenceSize && i < numberOfOperations && rand() % 3 == 0) {
+
+			handle = referencePick();
+			key = rand() % 4 ? rand() % ((int) referenceKey[handle] + 1) : rand() % MAX_KEY;
+			variant->decreaseKey(heap, handle, key);
+			referenceKey[handle] = key;
+		}
+		else {
+
+			element = variant->extractMinimum(heap, & key);
+			if (referenceSize == 0) {
+
+				if (element != NULL) {
+
+					fprintf(stderr, "%s operation %d: extracted an element from an empty heap\n", variant->name, i);
+					return(0);
+				}
+				continue ;
+			}
+
+			for (handle = 0; handle < MAX_ELEMENTS; handle++) {
+
+				if (referenceIn[handle] && referenceElement[handle] == element) break ;
+			}
+
+			if (handle == MAX_ELEMENTS || key != referenceKey[handle] || key != referenceMinimum() || variant->contains(heap, handle)) {
+
+				fprintf(stderr, "%s operation %d: extracted key %.0f, expected %.0f\n", variant->name, i, key, referenceMinimum());
+				return(0);
+			}
+
+			referenceIn[handle] = 0;
+			referenceSize--;
+		}
+
+		if (variant->size(heap) != referenceSize) {
+
+			fprintf(stderr, "%s operation %d: size %d, expected %d\n", variant->name, i, variant->size(heap), referenceSize);
+			return(0);
+		}
+
+		if (referenceSize && variant->topKey(heap) != referenceMinimum()) {
+
+			fprintf(stderr, "%s operation %d: top key %.0f, expected %.0f\n", variant->name, i, variant->topKey(heap), referenceMinimum());
+			return(0);
+		}
+
+		handle = rand() % MAX_ELEMENTS;
+		if (variant->contains(heap, handle) != referenceIn[handle]) {
+
+			fprintf(stderr, "%s operation %d: contains(%d) is %d, expected %d\n", variant->name, i, handle, variant->contains(heap, handle), referenceIn[handle]);
+			return(0);
+		}
+	}
+
+	variant->free(heap);
+
+	return(1);
+}
+
+/*
+ * Check heap and floatHeap against an array of keys.
+ *
+ *	checkHeap [-S seed] [-n operations]
+ */
+int main(int argc, char ** argv) {
+
+	unsigned int seed = 1;
+	int numberOfOperations = 50000;
+	int c, v, failed = 0;
+
+	while ((c = getopt(argc, argv, "S:n:")) != -1) {
+
+		switch(c) {
+
+			case 'S':
+				seed = atoi(optarg);
+				break ;
+
+			case 'n':
+				numberOfOperations = atoi(optarg);
+				break ;
+
+			default:
+				fprintf(stderr, "Use: %s [-S seed] [-n operations]\n", argv[0]);
+				exit(1);
+		}
+	}
+
+	srand(seed);
+	for (v = 0; v < sizeof(variants) / sizeof(variants[0]); v++) {
+
+		if (!checkVariant(& variants[v], numberOfOperations)) {
+
+			failed = 1;
+			continue ;
+		}
+
+		printf("checkHeap: %s, %d operations OK\n", variants[v].name, numberOfOperations);
+	}
+
+	return(failed);
+}
@@ -0,0 +1,189 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "set.h"
+
+/*
+ * Elements are drawn below MAX_ELEMENT, most of them below
+ * SMALL_ELEMENT, so that the two sets often have different numbers of
+ * words when they are combined.
+ */
+#define MAX_ELEMENT		4096
+#define SMALL_ELEMENT	200
+#define NUMBER_OF_SETS	2
+
+char reference[NUMBER_OF_SETS][MAX_ELEMENT];
+int failures = 0;
+
+int randomElement(void) {
+
+	if (rand() % 8) return(rand() % SMALL_ELEMENT);
+
+	return(rand() % MAX_ELEMENT);
+}
+
+/*
+ * Compare a set with its reference: size, membership of every element
+ * and the elements visited by setFirst/setNext.
+ */
+void checkSet(t_set * set, char * ref, int operation, char * name) {
+
+	int element, expected, size = 0;
+
+	for (element = 0; element < MAX_ELEMENT; element++) {
+
+		size += ref[element];
+		if (setIsElementOf(set, element) != ref[element]) {
+
+			fprintf(stderr, "Operation %d (%s): setIsElementOf(%d) is %d, expected %d\n", operation, name, element, setIsElementOf(set, element), ref[element]);
+			failures++;
+			return ;
+		}
+	}
+
+	if (setSize(set) != size || setIsEmpty(set) != (size == 0)) {
+
+		fprintf(stderr, "Operation %d (%s): setSize is %d, expected %d\n", operation, name, setSize(set), size);
+		failures++;
+		return ;
+	}
+
+	expected = -1;
+	for (element = setFirst(set); element >= 0; element = setNext(set, element)) {
+
+		for (expected++; expected < MAX_ELEMENT && !ref[expected]; expected++);
+		if (element != expected) {
+
+			fprintf(stderr, "Operation %d (%s): setNext gave %d, expected %d\n", operation, name, element, expected);
+			failures++;
+			return ;
+		}
+	}
+
+	for (expected++; expected < MAX_ELEMENT && !ref[expected]; expected++);
+	if (expected != MAX_ELEMENT) {
+
+		fprintf(stderr, "Operation %d (%s): iteration stopped before %d\n", operation, name, expected);
+		failures++;
+	}
+}
+
+/*
+ * Check t_set against an array of flags: random adds, deletions,
+ * clears, reserves and bulk operations between two sets, comparing
+ * both sets with their references after every operation.
+ *
+ *	checkSet [-S seed] [-n operations]
+ */
+int main(int argc, char ** argv) {
+
+	t_set * sets[NUMBER_OF_SETS];
+	unsigned int seed = 1;
+	int numberOfOperations = 20000;
+	int c, i, s, other, element, size;
+	char * name;
+
+	while ((c = getopt(argc, argv, "S:n:")) != -1) {
+
+		switch(c) {
+
+			case 'S':
+				seed = atoi(optarg);
+				break ;
+
+			case 'n':
+				numberOfOperations = atoi(optarg);
+				break ;
+
+			default:
+				fprintf(stderr, "Use: %s [-S seed] [-n operations]\n", argv[0]);
+				exit(1);
+		}
+	}
+
+	srand(seed);
+	for (s = 0; s < NUMBER_OF_SETS; s++) sets[s] = setNew();
+	memset(reference, 0, sizeof(reference));
+
+	for (i = 0; i < numberOfOperations && failures == 0; i++) {
+
+		s = rand() % NUMBER_OF_SETS;
+		other = (s + 1) % NUMBER_OF_SETS;
+
+		switch(rand() % 100) {
+
+			case 0:
+				name = "setClear";
+				setClear(sets[s]);
+				memset(reference[s], 0, MAX_ELEMENT);
+				break ;
+
+			case 1:
+				name = "setReserve";
+				setReserve(sets[s], randomElement());
+				break ;
+
+			case 2: case 3:
+				name = "setUnion";
+				setUnion(sets[s], sets[other]);
+				for (element = 0; element < MAX_ELEMENT; element++) reference[s][element] |= reference[other][element];
+				break ;
+
+			case 4: case 5:
+				name = "setIntersection";
+				setIntersection(sets[s], sets[other]);
+				for (element = 0; element < MAX_ELEMENT; element++) reference[s][element] &= reference[other][element];
+				break ;
+
+			case 6: case 7:
+				name = "setDifference";
+				setDifference(sets[s], sets[other]);
+				for (element = 0; element < MAX_ELEMENT; element++) reference[s][element] &= !reference[other][element];
+				break ;
+
+			case 8: case 9:
+				name = "setIntersectionSize";
+				size = 0;
+				for (element = 0; element < MAX_ELEMENT; element++) size += reference[s][element] & reference[other][element];
+				if (setIntersectionSize(sets[s], sets[other]) != size) {
+
+					fprintf(stderr, "Operation %d (%s): %d, expected %d\n", i, name, setIntersectionSize(sets[s], sets[other]), size);
+					failures++;
+				}
+				break ;
+
+			default:
+				if (rand() % 3) {
+
+					name = "setAdd";
+					element = randomElement();
+					setAdd(sets[s], element);
+					reference[s][element] = 1;
+				}
+				else {
+
+					name = "setDel";
+					element = randomElement();
+					setDel(sets[s], element);
+					reference[s][element] = 0;
+				}
+		}
+
+		checkSet(sets[s], reference[s], i, name);
+		checkSet(sets[other], reference[other], i, name);
+	}
+
+	for (s = 0; s < NUMBER_OF_SETS; s++) {
+
+		setFree(sets[s]);
+		free(sets[s]);
+	}
+
+	if (failures) return(1);
+
+	printf("checkSet: %d operations OK\n", numberOfOperations);
+
+	return(0);
+}
@@ -9,7 +9,7 @@
 #include <math.h>
 
 #include "graph.h"
-#include "parserOnlyPaths.h"
+#include "parser.h"
 #include "prefixTree.h"
 #include "list.h"
 #include "array.h"
@@ -19,6 +19,15 @@
 #include "heuristics.h"
 #include "dijkstra.h"
 
+/*
+ * Built with SIMULATION_VBR (mainEvaluateSinglePathSetVbr.o) for
+ * simulationhvbr, whose flows replay Evalvid traces given after the
+ * input.
+ */
+#ifdef SIMULATION_VBR
+#include "vbrTrace.h"
+#endif
+
 //#include "evaluateSimulationAux.h"
 //#include "evaluateSimulationAuxB.h"
 
@@ -41,15 +50,30 @@ int main(int argc, char ** argv) {
 	t_array * txDurations;
 	int * currentTxTime;
 
+#ifdef SIMULATION_VBR
+	const t_vbrTrace ** traces;
+
+	if (argc < 3) {
+
+		fprintf(stderr, "Use: %s <input> <trace> [trace...]\n", argv[0]);
+		exit(1);
+	}
+
+	MALLOC(traces, sizeof(t_vbrTrace *) * (argc - 2));
+	for (i = 2; i < argc; i++) traces[i - 2] = vbrTraceLoad(argv[i]);
+	vbrSetFlowTraces(traces, argc - 2);
+	free(traces);
+#else
 	if (argc != 2) {
 
 		fprintf(stderr, "Use: %s <input>\n", argv[0]);
 		exit(1);
 	}
+#endif
 
 	MALLOC(r, sizeof(t_return));
 
-	graph = parserParse(argv[1], & parsedPathList, & flt, & ftx);
+	graph = parserParsePaths(argv[1], & parsedPathList, & flt, & ftx);
 
 	currentPaths = arrayNew(listLength(parsedPathList));
 
@@ -1,8 +1,9 @@
+#define _GNU_SOURCE
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
+#include <string.h>
 
-#define _ISOC99_SOURCE
 #include <math.h>
 
 #include "parser.h"
@@ -11,12 +12,19 @@
 #include "prefixTree.h"
 #include "list.h"
 #include "array.h"
+#include "linkTable.h"
 #include "simulationh2.h"
+#include "neighborhood.h"
+#include "pareto.h"
+#include "search.h"
+#include "surrogate.h"
+#include "resultFile.h"
 #include "memory.h"
 #include "heuristics.h"
 #include "dijkstra.h"
 
 #include <time.h>
+#include <pthread.h>
 
 
 int REF = 0;
@@ -34,27 +42,145 @@ void printCurrentPaths(t_array * paths, int numberOfPairs, int numberOfDescripto
 }
 
 
-double maxCost(t_graph * graph, t_array * paths, t_array * flowTimes){
-	//Avaliação prévia do custo máximo da solução, com base na probabilidade de entrega. Sem considerar as perdas por enfileiramento e interferência.
-	int tmp;
-	float deliveryProbability, maxInterval, maxCost, flowTime;
-	for (int i = 0; i < arrayLength(paths); i++) {
-		deliveryProbability = 1.0;
-		for (int j = 1; j < arrayLength(arrayGet(paths, i)); j++) {
-			tmp = 1 - sqrt((double) GRAPH_MULTIPLIER / (double) graphGetCost(graph, (long) arrayGet(arrayGet(paths, i), j - 1), (long) arrayGet(arrayGet(paths, i), j)));
-			//printf("hopCost: %.2f ", tmp);
-			deliveryProbability  *= (1 - tmp * tmp * tmp * tmp);
-		}
-		maxInterval = (int) arrayGet(flowTimes, i) * deliveryProbability;
-		flowTime=(int) arrayGet(flowTimes, i);
-		maxCost = maxCost + ((maxInterval-flowTime)/maxInterval);			
+/*
+ * Scratch of the lower bounds computed by recordSimulation.
+ */
+t_heuristicCtx * heuristicCtx = NULL;
 
-		//printf("\npathDeliveryProbability: %.2f\n", deliveryProbability);
-		//printf("maxInterval: %.2f\n", maxInterval);
+/*
+ * Simulator counters (-s), summed over every simulation of the run.
+ */
+int printStats = 0;
+t_simulationStats runStats;
+unsigned long numberOfSimulations = 0, timedOutSimulations = 0, maxCycleStates = 0;
+int * runMaxQueueDepth = NULL;
+
+void accumulateStats(t_return * r) {
+
+	if (!r->stats) return;
+
+	if (!runMaxQueueDepth) runMaxQueueDepth = (int *) calloc(r->stats->numberOfNodes, sizeof(int));
+
+	numberOfSimulations++;
+	if (r->stats->timedOut) timedOutSimulations++;
+	if (r->stats->cycleStates > maxCycleStates) maxCycleStates = r->stats->cycleStates;
+	runStats.numberOfNodes = r->stats->numberOfNodes;
+	runStats.iterations += r->stats->iterations;
+	runStats.statesSaved += r->stats->statesSaved;
+	runStats.collisions += r->stats->collisions;
+	runStats.cycleStates += r->stats->cycleStates;
+	runStats.cycleTime += r->stats->cycleTime;
+	runStats.droppedPackets += r->stats->droppedPackets;
+	runStats.setupTime += r->stats->setupTime;
+	runStats.loopTime += r->stats->loopTime;
+	runStats.teardownTime += r->stats->teardownTime;
+	for (int n = 0; n < r->stats->numberOfNodes; n++) {
+
+		if (r->stats->maxQueueDepth[n] > runMaxQueueDepth[n]) runMaxQueueDepth[n] = r->stats->maxQueueDepth[n];
 	}
-	
-	return maxCost;
+}
+
+void printRunStats(void) {
+
+	if (!printStats || numberOfSimulations == 0) return;
+
+	printf("Stats simulations %lu timedOut %lu\n", numberOfSimulations, timedOutSimulations);
+	printf("Stats iterations %lu statesSaved %lu collisions %lu\n", runStats.iterations, runStats.statesSaved, runStats.collisions);
+	printf("Stats cycleStates mean %.2f max %lu cycleTime mean %.2f\n",
+		(double) runStats.cycleStates / (numberOfSimulations - timedOutSimulations ? numberOfSimulations - timedOutSimulations : 1), maxCycleStates,
+		(double) runStats.cycleTime / (numberOfSimulations - timedOutSimulations ? numberOfSimulations - timedOutSimulations : 1));
+	printf("Stats droppedPackets %lu maxQueueDepth", runStats.droppedPackets);
+	for (int n = 0; n < runStats.numberOfNodes; n++) {
+
+		if (runMaxQueueDepth[n]) printf(" %d:%d", n, runMaxQueueDepth[n]);
+	}
+	printf("\n");
+	printf("Stats time setup %.3f loop %.3f teardown %.3f\n", runStats.setupTime, runStats.loopTime, runStats.teardownTime);
+	printf("Stats visited %lu skipped %lu\n", searchVisitedEntries, searchVisitedHits);
+	printf("Stats estimator candidates %lu rejected %lu (%.1f%%)\n", searchEstimatedCandidates, searchRejectedCandidates,
+		searchEstimatedCandidates ? 100.0 * searchRejectedCandidates / searchEstimatedCandidates : 0.0);
+}
+
+/*
+ * Surrogate cost model. With -l <log>, the features, cost and delay
+ * of every simulated path set are appended to <log>, from which
+ * trainSurrogate fits a model. With -r <model>, the search ranks each
+ * neighborhood by predicted cost and simulates only its
+ * -k <candidates> best mixes (8 by default).
+ */
+FILE * surrogateLog = NULL;
+
+/*
+ * Pareto mode (-p). Every simulated path set is offered to a
+ * non-dominated archive of (cost, delay, largest flow loss), printed
+ * at the end of the run. The search itself still minimises cost.
+ */
+t_pareto * pareto = NULL;
+
+/*
+ * Result file (-o <template>). A simulated path set better than every
+ * one before it, by cost and then by delay as the search compares
+ * them, is a new incumbent and is appended with the rate, delay and
+ * loss of each flow and its path.
+ */
+t_resultWriter * resultWriter = NULL;
+char * resultTemplate = NULL;
+uint32_t recordedSimulations = 0;
+float recordedCost = INFINITY, recordedDelay = INFINITY;
+
+/*
+ * Hand a simulated path set to the surrogate log, the Pareto archive
+ * and the result file.
+ */
+void recordSimulation(t_graph * graph, t_array * paths, t_array * flowTimes, t_return * r) {
+
+	double features[SURROGATE_FEATURES];
+	float maxLoss = 0;
+
+	recordedSimulations++;
+	if (resultWriter && (r->cost < recordedCost || (r->cost == recordedCost && r->delay < recordedDelay))) {
+
+		recordedCost = r->cost;
+		recordedDelay = r->delay;
+		resultWriterAdd(resultWriter, recordedSimulations, (float) clock() / (CLOCKS_PER_SEC / 1000), r->cost, r->delay,
+			r->rateFlows, r->delayFlows, r->packetsLossPerFlow, paths);
+	}
+
+	if (surrogateLog) {
+
+		surrogateFeatures(heuristicCtx, graph, paths, flowTimes, features);
+		surrogateLogWrite(surrogateLog, features, r->cost, r->delay);
+	}
+
+	if (pareto) {
 
+		for (int f = 0; f < arrayLength(paths); f++) {
+
+			if (r->packetsLossPerFlow[f] > maxLoss) maxLoss = r->packetsLossPerFlow[f];
+		}
+		paretoOffer(pareto, paths, r->cost, r->delay, maxLoss);
+	}
+}
+
+/*
+ * Called with every simulation. A path set better than every one
+ * before it is reported, unless it is the first, and bestTime is the
+ * CPU time at which the last one was found.
+ */
+float observedCost = INFINITY, observedDelay = INFINITY, bestTime = 0;
+
+void observeSimulation(void * context, t_graph * graph, t_array * paths, t_array * flowTimes, t_return * r) {
+
+	accumulateStats(r);
+	recordSimulation(graph, paths, flowTimes, r);
+
+	if (r->cost < observedCost || (r->cost == observedCost && r->delay < observedDelay)) {
+
+		if (observedCost < INFINITY) printf("BestCost = %.4f - Delay = %.4f\n", r->cost, r->delay);
+		observedCost = r->cost;
+		observedDelay = r->delay;
+		bestTime = (float) clock() / (CLOCKS_PER_SEC / 1000);
+	}
 }
 
 
@@ -104,14 +230,39 @@ double maxCost(t_graph * graph, t_array * paths, t_array * flowTimes){
     
 // }
 
+/*
+ * Route files for ns-3 (-d <routes>) and path costs (-c <costs>). %n, %i
+ * and %r in the names become <numNodes>, <inst> and <ref>, as with -o.
+ * Each file is opened on the first write and stays open until the end
+ * of the run.
+ */
+char * routesTemplate = "../inst/newILS/0new-route300_%n-%i-ref%r";
+char * pathCostTemplate = "../inst/delay/4s-pathCost300_%n-%i-ref%r";
+FILE * routesFile = NULL, * pathCostFile = NULL;
+
+FILE * openOutput(FILE ** file, char * template, char * mode) {
+
+	char name[FILENAME_MAX];
+
+	if (* file) return(* file);
+
+	if (!resultPathExpand(name, sizeof(name), template, NumNodes, INST, REF)
+		|| (* file = fopen(name, mode)) == NULL) {
+
+		fprintf(stderr, "Could not open %s\n", template);
+		return(NULL);
+	}
+
+	return(* file);
+}
+
 void printDSR(t_array * paths[], int numberOfPairs, int numberOfDescriptors, t_return * rf ){  
     printf("DSR Routes\n");
     //INST++;
-    FILE *arq_ns3, *arq_result;
-    char arq_name[25];
-	sprintf(arq_name,"../inst/newILS/0new-route300_%d-%d-ref%d", NumNodes, INST, REF);
+    FILE *arq_ns3;
   
-    arq_ns3 = fopen(arq_name, "w"); //"a+"
+    arq_ns3 = openOutput(& routesFile, routesTemplate, "w"); //"a+"
+    if (!arq_ns3) return;
     
 	 
 		//fprintf(arq_ns3,"if(INST == %d){\n",INST);	
@@ -146,18 +297,17 @@ void printDSR(t_array * paths[], int numberOfPairs, int numberOfDescriptors, t_r
 		fclose(arq_result);
 		*/
 	
-    fclose(arq_ns3);
+    fflush(arq_ns3);
     
 }
 
 
 
 void printSolution(t_array * paths[], int numberOfPairs, int numberOfDescriptors, t_graph * graph ){  
-    FILE *arq_ns3, *arq_result;
-    char arq_name[25];
-	sprintf(arq_name,"../inst/delay/4s-pathCost300_%d-%d-ref%d", NumNodes, INST, REF);
+    FILE *arq_ns3;
   
-    arq_ns3 = fopen(arq_name, "a+");
+    arq_ns3 = openOutput(& pathCostFile, pathCostTemplate, "a+");
+    if (!arq_ns3) return;
     
 
 		//fprintf(arq_ns3,"INST == %d\n",INST);	
@@ -175,7 +325,7 @@ void printSolution(t_array * paths[], int numberOfPairs, int numberOfDescriptors
 		}    
 		//fprintf(arq_ns3,"\n");
 		
-    fclose(arq_ns3);
+    fflush(arq_ns3);
     
 }
 
@@ -194,13 +344,12 @@ return 0;
 
 int main(int argc, char ** argv) {
 
-	int * currentSrc, * currentDst, * currentFlt, * randSrc, * randDst;
-	int i, j, c, numberOfPairs, numberOfNodes;
-	int numhist, numPaths;
-    int *num;
+	int * currentSrc, * currentDst, * currentFlt;
+	int i, c, numberOfPairs, numberOfNodes;
+	int numPaths;
 
 	int numberOfDescriptors = 1; //quantidade de descritores alterado de 2 para 1 em 02/07/2023
-	int numberOfPathsPerFlow = 100; // S = conjunto de soluções para cada fluxo
+	int numberOfPathsPerFlow = SEARCH_PATHS_PER_FLOW; // S = conjunto de soluções para cada fluxo
    
 	t_graph * graph;
 	t_list * pathList;
@@ -208,9 +357,11 @@ int main(int argc, char ** argv) {
 	t_prefixTreeNode * path;
 	t_array * nodePairs, * flowTime, * simFlowTime, * txDurations;
 	t_array * currentPaths;
-	t_array * currentAuxPaths, * neighborPaths, * bestPaths, * histPaths;
-	float  bestCost, bestDelay, currentCost, pertCost, bestTime, currentTime;
-	clock_t t; //variável para armazenar tempo
+	t_array * bestPaths;
+	t_array *** candidates;
+	int * numberOfCandidates;
+	t_searchOptions options;
+	float  bestCost, bestDelay;
     t_return * r, * rf;
 	FILE *arq;
 	
@@ -226,14 +377,132 @@ int main(int argc, char ** argv) {
 	/*INST = atoi(argv[3]);
 	REF = atoi(argv[2]);*/
 
-	REF = atoi(argv[4]);
-	INST = atoi(argv[3]);
-	NumNodes = atoi(argv[2]); //Alterado em 18/07/2023 por Debora
+	searchOptionsInit(& options);
+	while ((c = getopt(argc, argv, "bspi:j:t:m:l:r:k:o:d:c:")) != -1) {
+
+		switch(c) {
+
+			case 'b':
+				/*
+				 * Memory-bounded cycle detection (Brent).
+				 */
+				simulationSetCycleDetection(SIMULATION_CYCLE_BRENT);
+				break ;
+
+			case 's':
+				/*
+				 * Print simulator counters at the end of the run.
+				 */
+				printStats = 1;
+				simulationSetStats(1);
+				break ;
+
+			case 'i':
+				/*
+				 * Stop each trajectory after this many iterations.
+				 */
+				options.maxIterations = atoi(optarg);
+				break ;
+
+			case 'j':
+				/*
+				 * Simulate each neighborhood with this many threads.
+				 */
+				options.prefetch = atoi(optarg) > 1;
+				simulationSetBatchThreads(atoi(optarg));
+				break ;
+
+			case 't':
+				/*
+				 * Tabu tenure, in iterations.
+				 */
+				options.tabuTenure = atoi(optarg);
+				break ;
+
+			case 'm':
+				/*
+				 * Number of parallel search trajectories.
+				 */
+				options.numberOfWorkers = atoi(optarg);
+				break ;
+
+			case 'p':
+				/*
+				 * Keep the Pareto front of cost, delay and loss.
+				 */
+				pareto = paretoNew();
+				break ;
+
+			case 'l':
+				/*
+				 * Log every simulation for training the surrogate.
+				 */
+				surrogateLog = surrogateLogOpen(optarg);
+				if (!surrogateLog) {
+
+					fprintf(stderr, "Could not open log %s\n", optarg);
+					exit(1);
+				}
+				break ;
+
+			case 'r':
+				/*
+				 * Rank neighborhoods with a surrogate model.
+				 */
+				options.surrogate = surrogateLoad(optarg);
+				if (!options.surrogate) {
+
+					fprintf(stderr, "Could not load surrogate model %s\n", optarg);
+					exit(1);
+				}
+				break ;
+
+			case 'k':
+				options.surrogateTopK = atoi(optarg);
+				break ;
+
+			case 'o':
+				/*
+				 * Write the incumbents to a result file; %n, %i and
+				 * %r in the name become <numNodes>, <inst> and <ref>.
+				 */
+				resultTemplate = optarg;
+				break ;
+
+			case 'd':
+				/*
+				 * ns-3 route file of the best solution.
+				 */
+				routesTemplate = optarg;
+				break ;
+
+			case 'c':
+				/*
+				 * File the path costs are appended to.
+				 */
+				pathCostTemplate = optarg;
+				break ;
+
+			default:
+				fprintf(stderr, "Use: %s [-b] [-s] [-p] [-i iterations] [-j threads] [-t tenure] [-m workers] [-l log] [-r model] [-k candidates] [-o results] [-d routes] [-c costs] <input> <numNodes> <inst> <ref>\n", argv[0]);
+				exit(1);
+		}
+	}
+
+	if (argc - optind != 4) {
+
+		fprintf(stderr, "Use: %s [-b] [-s] [-p] [-i iterations] [-j threads] [-t tenure] [-m workers] [-l log] [-r model] [-k candidates] [-o results] [-d routes] [-c costs] <input> <numNodes> <inst> <ref>\n", argv[0]);
+		exit(1);
+	}
+
+	REF = atoi(argv[optind + 3]);
+	INST = atoi(argv[optind + 2]);
+	NumNodes = atoi(argv[optind + 1]); //Alterado em 18/07/2023 por Debora
 	
 	
 
 
-	graph = parserParse(argv[1], & src, & dst, &flt);
+	graph = parserParse(argv[optind], & src, & dst, &flt);
     //graphPrint(graph);
 	/*
 	 * Compute paths and place them in an array.
@@ -250,10 +519,6 @@ int main(int argc, char ** argv) {
 	i = 0;
 	listBegin(src);
 	listBegin(dst);
-	MALLOC(randSrc, sizeof(int));
-	MALLOC(randDst, sizeof(int));
-	srand(time(NULL));
-	* randDst = rand()%numberOfNodes;
 	while(1) { // Gera o conjunto de soluções S para cada Fluxo
 		
 		//* randSrc = rand()%numberOfNodes;
@@ -317,6 +582,35 @@ int main(int argc, char ** argv) {
 //numberOfDescriptors =2;
 numPaths = numberOfDescriptors*numberOfPairs;
 
+	if (resultTemplate) {
+
+		t_resultHeader header;
+		char resultName[FILENAME_MAX], options[1024] = "";
+
+		for (i = 1; i < optind; i++) {
+
+			if (strlen(options) + strlen(argv[i]) + 2 > sizeof(options)) break ;
+			if (i > 1) strcat(options, " ");
+			strcat(options, argv[i]);
+		}
+
+		header.numberOfFlows = numPaths;
+		header.graphNodes = numberOfNodes;
+		header.nodes = NumNodes;
+		header.instance = INST;
+		header.reference = REF;
+		header.startTime = time(NULL);
+		header.input = argv[optind];
+		header.options = options;
+
+		if (!resultPathExpand(resultName, sizeof(resultName), resultTemplate, NumNodes, INST, REF)
+			|| (resultWriter = resultWriterOpen(resultName, & header)) == NULL) {
+
+			fprintf(stderr, "Could not create result file %s\n", resultTemplate);
+			exit(1);
+		}
+	}
+
 
 	// //Novos valores para os fluxos   comentado em 02/07/2023
 	// //MDC - BUS
@@ -434,24 +728,18 @@ return(0);
 	bestCost = INFINITY;
 	bestDelay = INFINITY;
 	currentPaths = arrayNew(numberOfPairs*numberOfDescriptors); 
-	currentAuxPaths = arrayNew(numberOfPairs*numberOfDescriptors); 
-    neighborPaths = arrayNew(numberOfPairs*numberOfDescriptors);
 	bestPaths = arrayNew(numberOfPairs*numberOfDescriptors);
-	/*for (int i = 0; i < numberOfPathsPerFlow; i++) {
-		histPaths[i] = arrayNew(numberOfPairs*numberOfDescriptors);
-	}
-	*/
-	histPaths = arrayNew(numberOfPairs*numberOfDescriptors);
 	simFlowTime = arrayNew(numberOfPairs*numberOfDescriptors); 
 	
+	MALLOC(candidates, sizeof(t_array **) * numberOfPairs);
+	MALLOC(numberOfCandidates, sizeof(int) * numberOfPairs);
+	for (i = 0; i < numberOfPairs; i++) candidates[i] = searchCandidates(arrayGet(nodePairs, i), & numberOfCandidates[i]);
 	
 	c=0;
     for (i = 0; i < numberOfPairs; i++) { // Sulução Inicial
-       path = listBegin(arrayGet(nodePairs, i)); 
        for (int d = 0; d < numberOfDescriptors; d++) {
-		    arraySet(bestPaths, c, prefixTreePath(path));
-			arraySet(currentPaths, c, prefixTreePath(path));
-			arraySet(histPaths, c, prefixTreePath(path));
+		    arraySet(bestPaths, c, candidates[i][0]);
+			arraySet(currentPaths, c, candidates[i][0]);
 			arraySet(simFlowTime, c, arrayGet(flowTime, c));
 			c++;
 	   } 
@@ -463,13 +751,11 @@ return(0);
 	//printSolution(currentPaths, numberOfPairs, numberOfDescriptors, graph);
 	//return(0);
 
-	MALLOC(r, sizeof(t_return));
-	MALLOC(rf, sizeof(t_return));
+    heuristicCtx = heuristicCtxNew(graphSize(graph));
     r = simulationSimulate(graph, currentPaths, simFlowTime, txDurations); //função objetivo
+    observeSimulation(NULL, graph, currentPaths, simFlowTime, r);
     bestCost = r->cost;
 	bestDelay = r->delay;
-    currentTime = ((float)clock() - t)/((CLOCKS_PER_SEC/1000));
-    bestTime = currentTime;
     rf=r; // melhor fluxo retornado
     printf("S0 BestCost = %.4f\n", bestCost);
     
@@ -482,398 +768,55 @@ return(0);
 		printf("%d	%d	%.2f	%.2f	%d\n",INST, f, r->rateFlows[f], r->delayFlows[f],arrayLength(arrayGet(currentPaths, f)) );	
 		//fprintf(arq_delay,"%.2f\n", r->meanIntervalPerFlow[f] );	
 	}
-	
-
-
-
-	
-	
-    
-
-
-	//printf("Busca Local 0\n");
-    c=0;
-    for (i = 0; i < numberOfPairs; i++) { // obter o vizinho mais próximo de cada caminho
-       path = listNext(arrayGet(nodePairs, i)); 
-	   //Fazer a poda aqui.
-       for (int d = 0; d < numberOfDescriptors; d++) {
-			arraySet(neighborPaths, c, prefixTreePath(path));
-			arraySet(currentAuxPaths, c, arrayGet(currentPaths, c));
-			c++;
-	   } 
-    }
-	
-    num = (int *)calloc(numPaths+1, sizeof(int)) ;
-    if ( num == NULL ) {
-        perror("malloc") ;
-        return -1;
-    }
-
-	numhist=0;
-    while ( num[numPaths] == 0 ) { //Permutação entre os caminhos
-		int newPaths =0;
-		for(i=0; i < 2; i++) { //permutar os caminhos com o 2 conjuntos (currentPaths e neighborPaths)
-            for(j=0; j < numPaths; j++) {
-                if(num[j]){
-                    //printf("%d-n ", j);
-					newPaths=1;
-					arraySet(currentPaths, j, arrayGet(neighborPaths, j));
-                }else{
-                    //printf("%d-c ", j);
-					arraySet(currentPaths, j, arrayGet(currentAuxPaths, j));
-                }
-            }
-			num[0]++;
-           // putchar('\n');
-			//Avaliar a solução caso tenha um novo caminho
-			
-	
-			if(newPaths){
-				//printCurrentPaths(currentPaths, numberOfPairs, numberOfDescriptors);
-				//Avaliação prévia da solução.	
-				currentCost = maxCost(graph, currentPaths, simFlowTime);
-				//printf("maxCost = %.4f\n", currentCost);
-				if (currentCost <= bestCost) { //Executa a simulação se tiver melhor ou igual custo na avaliação prévia 
-				
-					r = simulationSimulate(graph, currentPaths, simFlowTime, txDurations); //função objetivo
-					currentCost = r->cost;
-					currentTime = ((float)clock() - t)/((CLOCKS_PER_SEC/1000));
-					//printf("currentCost = %.4f\n", currentCost);	
-					if (currentCost <bestCost) {
-						
-							bestTime = currentTime;
-							bestCost = currentCost;
-							bestDelay = r->delay;
-							for(int p=0; p<numPaths;p++){ //armazena a solução anterior no histórico
-								arraySet(histPaths, p, arrayGet(bestPaths, p));
-							}
-
-							for(int p=0; p<numPaths;p++){ //obtem a melhor solução
-								arraySet(bestPaths, p, arrayGet(currentPaths, p));
-							}
-
-							printf("it 0 BestCost = %.4f\n", bestCost);	
-							
-							//printf("historico");
-							//printCurrentPaths(histPaths, numberOfPairs, numberOfDescriptors);
-							//printf("best");
-							//printCurrentPaths(bestPaths, numberOfPairs, numberOfDescriptors);
-
-					}
-					
-					if(currentCost ==bestCost){ //Critério de desempate
-						printf("Empate = %f %f\n", bestCost, r->delay);	
-						//printCurrentPaths(currentPaths, numberOfPairs, numberOfDescriptors);
-						for (int f = 0; f < numberOfPairs*numberOfDescriptors; f++) {
-							printf("%d	%.2f	%d\n", f, r->delayFlows[f],arrayLength(arrayGet(currentPaths, f)) );	
-						}
-						
-						if(r->delay < bestDelay){
-							
-							bestTime = currentTime;
-							bestCost = currentCost;
-							bestDelay = r->delay;
-							for(int p=0; p<numPaths;p++){ //armazena a solução anterior no histórico
-								arraySet(histPaths, p, arrayGet(bestPaths, p));
-							}
-
-							for(int p=0; p<numPaths;p++){ //obtem a melhor solução
-								arraySet(bestPaths, p, arrayGet(currentPaths, p));
-							}
-
-							printf("it 0 desempate BestCost = %.4f\n", bestCost);	
-							for (int f = 0; f < numberOfPairs*numberOfDescriptors; f++) {
-								printf("Flow %lu %.2f - Delay %.2f \n",f, r->rateFlows[f], r->delayFlows[f] );	
-							}
-	
-						}
-						
-
-					}
-						
-				}
-			}
-			
-        }
-
-        for(i=0; i < numPaths; i++) {
-            if(num[i] == 2) {
-                num[i] = 0;
-                num[i+1]++ ;
-            }
-        }
-    }
- 
-    free(num) ;
-	
-   
-	//Cada iteração: Permuta a proxima solução com a melhor solução e em seguida com o histórico.
-	int iteracao =1;
-    while (bestCost>0 & iteracao < numberOfPathsPerFlow-1 & currentTime<60000){ //Reduzir o time para instancias que não atingirem o tempo
-		int bestSolution=0;
-		//printf("iteração %d\n", iteracao);
-		
-		//printf("Permutar a melhor solução com a próxima solução.\n");
-		//Perturbação com a Melhor Solução.
-		for(int p=0; p<numPaths;p++){ //obter a melhor solução
-			arraySet(currentAuxPaths, p, arrayGet(bestPaths, p));
-		}
-		 
-		c=0;
-		for (i = 0; i < numberOfPairs; i++) { // obter a próxima solução vizinha.
-			path = listNext(arrayGet(nodePairs, i)); 
-			for (int d = 0; d < numberOfDescriptors; d++) {
-					arraySet(neighborPaths, c, prefixTreePath(path));
-					c++;
-			} 
-		}
-		//printf("best");
-		//printCurrentPaths(currentAuxPaths, numberOfPairs, numberOfDescriptors);
-		//printf("neighbor");
-		//printCurrentPaths(neighborPaths, numberOfPairs, numberOfDescriptors);
-		
-		//printf("Busca Local permuta 1\n");
-		num = (int *)calloc(numPaths+1, sizeof(int)) ;
-		if ( num == NULL ) {
-			perror("malloc") ;
-			return -1;
-		}
-		while ( num[numPaths] == 0 ) { //Permutação entre os caminhos
-			int newPaths=0;
-			for(i=0; i < 2; i++) { //permutar os caminhos com o 2 conjuntos (currentPaths e neighborPaths)
-				for(j=0; j < numPaths; j++) {
-					if(num[j]){
-						//printf("%d-n ", j);
-						newPaths=1;
-						arraySet(currentPaths, j, arrayGet(neighborPaths, j));
-					}else{
-						//printf("%d-c ", j);
-						arraySet(currentPaths, j, arrayGet(currentAuxPaths, j));
-					}
-				}
-				num[0]++ ;
-			// putchar('\n');
-				
-				if(newPaths){
-					//Avalia o caminho
-					currentCost = maxCost(graph, currentPaths, simFlowTime);
-					if (currentCost <= bestCost) { //Executa a simulação se tiver melhor ou igual custo na avaliação prévia 
-				
-						r = simulationSimulate(graph, currentPaths, simFlowTime, txDurations); //função objetivo
-						currentCost = r->cost;
-						currentTime = ((float)clock() - t)/((CLOCKS_PER_SEC/1000));
-						//printf("currentCost = %.4f\n", currentCost);	
-						if (currentCost <bestCost) {
-							bestTime = currentTime;
-							bestCost = currentCost;
-							bestDelay = r->delay;
-							
-							bestSolution=1;
-							
-							for(int p=0; p<numPaths;p++){ //obtem a melhor solução
-								arraySet(bestPaths, p, arrayGet(currentPaths, p));
-							}
-
-							printf("it %d BestCost = %f\n", iteracao, bestCost);	
-							//printf("historico");
-							//printCurrentPaths(histPaths, numberOfPairs, numberOfDescriptors);
-							//printf("best");
-							//printCurrentPaths(bestPaths, numberOfPairs, numberOfDescriptors);
-							
-						}
-
-						if(currentCost ==bestCost){ //Critério de desempate
-							printf("Empate = %f %f\n", bestCost, r->delay);	
-							//printCurrentPaths(currentPaths, numberOfPairs, numberOfDescriptors);
-							for (int f = 0; f < numberOfPairs*numberOfDescriptors; f++) {
-								printf("%d	%.2f	%d\n", f, r->delayFlows[f],arrayLength(arrayGet(currentPaths, f)) );	
-							}
-							
-							if(r->delay < bestDelay){
-								
-								bestTime = currentTime;
-								bestCost = currentCost;
-								bestDelay = r->delay;
-								for(int p=0; p<numPaths;p++){ //armazena a solução anterior no histórico
-									arraySet(histPaths, p, arrayGet(bestPaths, p));
-								}
-
-								for(int p=0; p<numPaths;p++){ //obtem a melhor solução
-									arraySet(bestPaths, p, arrayGet(currentPaths, p));
-								}
-
-								printf("it %d desempate BestCost = %f\n", iteracao, bestCost);
-								for (int f = 0; f < numberOfPairs*numberOfDescriptors; f++) {
-								   printf("Flow %lu %.2f - Delay %.2f \n",f, r->rateFlows[f], r->delayFlows[f] );	
-							    }
-		
-							}
-							
 
-					}
-
-
-
-					}else{
-						printf("maxCost = %.4f\n", currentCost);
-					
-					}
-				}
-			
-				for(i=0; i < numPaths; i++) {
-					if(num[i] == 2) {
-						num[i] = 0;
-						num[i+1]++ ;
-					}
-				}
-			}
-    	}
- 
-		free(num);
-
-    	
-		if(bestSolution){ //Caso tenha encontrado uma melhor solução, permutar essa solução com o histórico.
-			//printf("Permutar a melhor solução da iteração com o histórico.\n");
-			
-			
-			for(int p=0; p<numPaths;p++){ //armazena a solução anterior no histórico
-				arraySet(currentAuxPaths, p, arrayGet(bestPaths, p));
-			}
-			for(int p=0; p<numPaths;p++){ //armazena a solução anterior no histórico
-				arraySet(neighborPaths, p, arrayGet(histPaths, p));
-			}
-
-
-		}else{
-			//printf("Permutar o histórico com a próxima solução.\n");
-			for(int p=0; p<numPaths;p++){ //armazena a solução anterior no histórico
-				arraySet(currentAuxPaths, p, arrayGet(histPaths, p));
-			}
-		}
-		
-		//printCurrentPaths(currentAuxPaths, numberOfPairs, numberOfDescriptors);
-		//printCurrentPaths(neighborPaths, numberOfPairs, numberOfDescriptors);
-		
-		//printf("Busca Local permuta 2\n");
-		num = (int *)calloc(numPaths+1, sizeof(int)) ;
-		if ( num == NULL ) {
-			perror("malloc") ;
-			return -1;
-		}
-		while ( num[numPaths] == 0 ) { //Permutação entre os caminhos
-			int newPaths=0;
-			for(i=0; i < 2; i++) { //permutar os caminhos com o 2 conjuntos (currentPaths e neighborPaths)
-				for(j=0; j < numPaths; j++) {
-					if(num[j]){
-						//printf("%d-n ", j);
-						newPaths=1;
-						arraySet(currentPaths, j, arrayGet(neighborPaths, j));
-					}else{
-						//printf("%d-c ", j);
-						arraySet(currentPaths, j, arrayGet(currentAuxPaths, j));
-					}
-				}
-				num[0]++ ;
-			// putchar('\n');
-				
-				if(newPaths){
-					//printCurrentPaths(currentPaths, numberOfPairs, numberOfDescriptors);
-					//Avaliação prévia da solução.	
-					currentCost = maxCost(graph, currentPaths, simFlowTime);
-					//printf("maxCost = %.4f\n", currentCost);
-					if (currentCost <= bestCost) { //Executa a simulação se tiver melhor ou igual custo na avaliação prévia 
-				
-						r = simulationSimulate(graph, currentPaths, simFlowTime, txDurations); //função objetivo
-						currentCost = r->cost;
-						currentTime = ((float)clock() - t)/((CLOCKS_PER_SEC/1000));
-						//printf("currentCost = %.4f\n", currentCost);	
-						if (currentCost <bestCost) {
-							bestTime = currentTime;
-							bestCost = currentCost;
-							bestDelay = r->delay;
-							for(int p=0; p<numPaths;p++){ //armazena a solução anterior no histórico
-								arraySet(histPaths, p, arrayGet(bestPaths, p));
-							}
-
-							for(int p=0; p<numPaths;p++){ //obtem a melhor solução
-								arraySet(bestPaths, p, arrayGet(currentPaths, p));
-							}
-
-							printf("it %d BestCost = %.4f\n", iteracao, bestCost);	
-							//printf("historico");
-							//printCurrentPaths(histPaths, numberOfPairs, numberOfDescriptors);
-							//printf("best");
-							//printCurrentPaths(bestPaths, numberOfPairs, numberOfDescriptors);
-							
-						}
-
-						if(currentCost ==bestCost){ //Critério de desempate
-							printf("Empate = %f %f\n", bestCost, r->delay);	
-							//printCurrentPaths(currentPaths, numberOfPairs, numberOfDescriptors);
-							for (int f = 0; f < numberOfPairs*numberOfDescriptors; f++) {
-								printf("%d	%.2f	%d\n", f, r->delayFlows[f],arrayLength(arrayGet(currentPaths, f)) );	
-							}
-							
-							if(r->delay < bestDelay){
-								
-								bestTime = currentTime;
-								bestCost = currentCost;
-								bestDelay = r->delay;
-								for(int p=0; p<numPaths;p++){ //armazena a solução anterior no histórico
-									arraySet(histPaths, p, arrayGet(bestPaths, p));
-								}
-
-								for(int p=0; p<numPaths;p++){ //obtem a melhor solução
-									arraySet(bestPaths, p, arrayGet(currentPaths, p));
-								}
-
-								printf("it 0 desempate BestCost = %.4f\n", bestCost);	
-								for (int f = 0; f < numberOfPairs*numberOfDescriptors; f++) {
-								printf("Flow %lu %.2f - Delay %.2f \n",f, r->rateFlows[f], r->delayFlows[f] );	
-								}
-	
-							}
-							
-
-
-					}
-
-					}
-				}
-			
-				for(i=0; i < numPaths; i++) {
-					if(num[i] == 2) {
-						num[i] = 0;
-						num[i+1]++ ;
-					}
-				}
-			}
-    	}
- 
-		free(num);
-
-		iteracao++;
-	}
-	
+	//Cada iteração: Permuta a proxima solução com a melhor solução e em seguida com o histórico (ver searchMultiStart).
+	options.observer = observeSimulation;
+	int iteracao = searchMultiStart(graph, candidates, numberOfCandidates, numberOfPairs, numberOfDescriptors, numberOfPathsPerFlow,
+		simFlowTime, txDurations, & options, bestPaths, & bestCost, & bestDelay);
+	for (i = 0; i < numberOfPairs; i++) free(candidates[i]);
+	free(candidates);
+	free(numberOfCandidates);
 
 printCurrentPaths(bestPaths, numberOfPairs, numberOfDescriptors);
 printf("iteration = %d - bestCost = %f - bestDelay = %f\n", iteracao, bestCost, bestDelay);	
+if (printStats) printf("Stats time best %.0f ms\n", bestTime); //Tempo de CPU até a melhor solução
 
 
 
 printDSR(bestPaths, numberOfPairs, numberOfDescriptors, rf);
 //printSolution(currentPaths, numberOfPairs, numberOfDescriptors, graph);
+simulationReturnFree(rf);
+free(rf);
 r = simulationSimulate(graph, bestPaths, simFlowTime, txDurations); //função objetivo
+accumulateStats(r);
 for (int f = 0; f < numberOfPairs*numberOfDescriptors; f++) {
 	printf("Flow %lu %.2f - Delay %.2f \n",f, r->rateFlows[f], r->delayFlows[f] );	
 }
+printRunStats();
+if (pareto) paretoPrint(stdout, pareto);
+if (resultWriter) {
 
+	if (!resultWriterClose(resultWriter)) fprintf(stderr, "Could not write the result file\n");
+	free(resultWriter);
+}
+if (routesFile) fclose(routesFile);
+if (pathCostFile) fclose(pathCostFile);
+
+    free(runMaxQueueDepth);
+    heuristicCtxFree(heuristicCtx);
+    free(heuristicCtx);
+    if (surrogateLog) fclose(surrogateLog);
+    if (pareto) {
+        paretoFree(pareto);
+        free(pareto);
+    }
+    free(options.surrogate);
     arrayFree(currentPaths);
     free(currentPaths);
 	
 	
+    simulationReturnFree(r);
     free(r);
-	free(rf);
 	
 	listFreeWithData(dst);
 	free(dst);
@@ -904,17 +847,9 @@ for (int f = 0; f < numberOfPairs*numberOfDescriptors; f++) {
 	arrayFree(txDurations);
 	free(txDurations);
 
-	arrayFree(currentAuxPaths);
-	free(currentAuxPaths);
-
-	arrayFree(neighborPaths);
-	free(neighborPaths);
-
 	arrayFree(bestPaths);
 	free(bestPaths);
 
-	arrayFree(histPaths);
-	free(histPaths);
 	
 	//fclose(arq);
 	
@@ -0,0 +1,490 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <pthread.h>
+
+#include <math.h>
+
+#include "parser.h"
+#include "graph.h"
+#include "yen.h"
+#include "prefixTree.h"
+#include "list.h"
+#include "array.h"
+#include "linkTable.h"
+#include "simulationh2.h"
+#include "search.h"
+#include "memory.h"
+
+/*
+ * Solve many flow instances over one topology in a single process.
+ * The topology is parsed and its link table built once, the paths of
+ * each (source, destination) pair are computed once and shared by
+ * every instance that has the pair, and the instances are solved by a
+ * pool of threads. Each result is written as soon as it is ready, one
+ * line per instance, in CSV or JSON Lines.
+ */
+
+typedef enum {
+
+	OUTPUT_CSV,
+	OUTPUT_JSONL,
+} t_outputFormat;
+
+/*
+ * Yen paths of a pair of nodes.
+ */
+typedef struct {
+
+	t_list * pathList;
+	t_array ** candidates;
+	int numberOfCandidates;
+} t_pairPaths;
+
+typedef struct {
+
+	char * name;
+	int numberOfFlows;
+	t_pairPaths ** pairs;		// pairs[f]: paths of the pair of flow f.
+	t_array * flowTimes;
+	t_array * txDurations;
+} t_instance;
+
+typedef struct {
+
+	t_graph * graph;
+	t_instance * instances;
+	int numberOfInstances;
+	int numberOfPathsPerFlow;
+	int numberOfWorkers;
+	t_outputFormat format;
+	FILE * output;
+
+	pthread_mutex_t lock;
+	int nextInstance;
+} t_batch;
+
+int compareNames(const void * a, const void * b) {
+
+	return(strcmp(* (char * const *) a, * (char * const *) b));
+}
+
+/*
+ * Add the instance files named by path to names: path itself, or the
+ * regular files in it, in name order, if it is a directory.
+ */
+int addInstanceFiles(char * path, char *** names, int numberOfNames) {
+
+	struct stat st;
+	struct dirent * entry;
+	char ** entries = NULL;
+	int numberOfEntries = 0;
+	char * name;
+	DIR * dir;
+
+	if (stat(path, & st) < 0) {
+
+		fprintf(stderr, "Could not open %s\n", path);
+		exit(1);
+	}
+
+	if (!S_ISDIR(st.st_mode)) {
+
+		REALLOC(* names, sizeof(char *) * (numberOfNames + 1));
+		(* names)[numberOfNames] = strdup(path);
+		return(numberOfNames + 1);
+	}
+
+	dir = opendir(path);
+	if (!dir) {
+
+		fprintf(stderr, "Could not open %s\n", path);
+		exit(1);
+	}
+	while ((entry = readdir(dir))) {
+
+		if (entry->d_name[0] == '.') continue ;
+
+		MALLOC(name, strlen(path) + strlen(entry->d_name) + 2);
+		sprintf(name, "%s/%s", path, entry->d_name);
+		if (stat(name, & st) < 0 || !S_ISREG(st.st_mode)) {
+
+			free(name);
+			continue ;
+		}
+
+		REALLOC(entries, sizeof(char *) * (numberOfEntries + 1));
+		entries[numberOfEntries++] = name;
+	}
+	closedir(dir);
+
+	qsort(entries, numberOfEntries, sizeof(char *), compareNames);
+	REALLOC(* names, sizeof(char *) * (numberOfNames + numberOfEntries + 1));
+	memcpy(* names + numberOfNames, entries, sizeof(char *) * numberOfEntries);
+	free(entries);
+
+	return(numberOfNames + numberOfEntries);
+}
+
+/*
+ * Read the flows of an instance (the Source, Destination and FlowTime
+ * sections of the fitpath input) and attach the paths of their pairs,
+ * computing those not seen before. Returns 0 if the instance can not
+ * be solved.
+ */
+int loadInstance(t_instance * instance, char * name, t_graph * graph, t_pairPaths ** pairTable, int numberOfPathsPerFlow) {
+
+	t_list * src, * dst, * flt;
+	t_graph * flowGraph;
+	t_pairPaths * pair;
+	int * currentSrc, * currentDst, * currentFlt;
+	int numberOfNodes = graphSize(graph);
+	int f, ok = 1;
+
+	flowGraph = parserParse(name, & src, & dst, & flt);
+	graphFree(flowGraph);
+	free(flowGraph);
+
+	instance->name = name;
+	instance->numberOfFlows = listLength(src);
+	if (instance->numberOfFlows == 0 || listLength(dst) != instance->numberOfFlows || listLength(flt) != instance->numberOfFlows) {
+
+		fprintf(stderr, "%s: expected the same number of sources, destinations and flow times\n", name);
+		ok = 0;
+	}
+
+	MALLOC(instance->pairs, sizeof(t_pairPaths *) * instance->numberOfFlows);
+	instance->flowTimes = arrayNew(instance->numberOfFlows);
+	instance->txDurations = arrayNew(instance->numberOfFlows);
+
+	currentSrc = listBegin(src);
+	currentDst = listBegin(dst);
+	currentFlt = listBegin(flt);
+	for (f = 0; ok && f < instance->numberOfFlows; f++) {
+
+		if (* currentSrc >= numberOfNodes || * currentDst >= numberOfNodes) {
+
+			fprintf(stderr, "%s: flow %d is not in the topology\n", name, f);
+			ok = 0;
+			break ;
+		}
+
+		pair = pairTable[* currentSrc * numberOfNodes + * currentDst];
+		if (!pair) {
+
+			MALLOC(pair, sizeof(t_pairPaths));
+			pair->pathList = yen(graph, * currentSrc, * currentDst, numberOfPathsPerFlow);
+			pair->candidates = searchCandidates(pair->pathList, & pair->numberOfCandidates);
+			pairTable[* currentSrc * numberOfNodes + * currentDst] = pair;
+		}
+		if (pair->numberOfCandidates == 0) {
+
+			fprintf(stderr, "%s: no path between nodes %d and %d\n", name, * currentSrc, * currentDst);
+			ok = 0;
+			break ;
+		}
+
+		instance->pairs[f] = pair;
+		arraySet(instance->flowTimes, f, (void *) (long) * currentFlt);
+		arraySet(instance->txDurations, f, (void *) 238L); // Tempo de transmissão de um frame.
+
+		currentSrc = listNext(src);
+		currentDst = listNext(dst);
+		currentFlt = listNext(flt);
+	}
+
+	listFreeWithData(src);
+	free(src);
+	listFreeWithData(dst);
+	free(dst);
+	listFreeWithData(flt);
+	free(flt);
+
+	return(ok);
+}
+
+void countSimulation(void * context, t_graph * graph, t_array * paths, t_array * flowTimes, t_return * r) {
+
+	(* (unsigned long *) context)++;
+}
+
+/*
+ * Write a string as a quoted CSV field or JSON string.
+ */
+void writeQuoted(FILE * output, char * string, t_outputFormat format) {
+
+	fputc('"', output);
+	for (; * string; string++) {
+
+		if (* string == '"') fputc(format == OUTPUT_CSV ? '"' : '\\', output);
+		else if (* string == '\\' && format == OUTPUT_JSONL) fputc('\\', output);
+		fputc(* string, output);
+	}
+	fputc('"', output);
+}
+
+void writeResult(t_batch * batch, t_instance * instance, t_array * bestPaths, float bestCost, float bestDelay,
+	int iterations, unsigned long simulations, double seconds) {
+
+	FILE * output = batch->output;
+	t_array * path;
+	int f, k;
+
+	pthread_mutex_lock(& batch->lock);
+	if (batch->format == OUTPUT_CSV) {
+
+		writeQuoted(output, instance->name, OUTPUT_CSV);
+		fprintf(output, ",%d,%f,%f,%d,%lu,%.3f,\"", instance->numberOfFlows, bestCost, bestDelay, iterations, simulations, seconds);
+		for (f = 0; f < arrayLength(bestPaths); f++) {
+
+			path = arrayGet(bestPaths, f);
+			if (f) fputc(';', output);
+			for (k = 0; k < arrayLength(path); k++) fprintf(output, k ? " %lu" : "%lu", (unsigned long) arrayGet(path, k));
+		}
+		fprintf(output, "\"\n");
+	}
+	else {
+
+		fprintf(output, "{\"instance\":");
+		writeQuoted(output, instance->name, OUTPUT_JSONL);
+		fprintf(output, ",\"flows\":%d,\"cost\":%f,\"delay\":%f,\"iterations\":%d,\"simulations\":%lu,\"seconds\":%.3f,\"paths\":[",
+			instance->numberOfFlows, bestCost, bestDelay, iterations, simulations, seconds);
+		for (f = 0; f < arrayLength(bestPaths); f++) {
+
+			path = arrayGet(bestPaths, f);
+			fprintf(output, f ? ",[" : "[");
+			for (k = 0; k < arrayLength(path); k++) fprintf(output, k ? ",%lu" : "%lu", (unsigned long) arrayGet(path, k));
+			fprintf(output, "]");
+		}
+		fprintf(output, "]}\n");
+	}
+	fflush(output);
+	pthread_mutex_unlock(& batch->lock);
+}
+
+void solveInstance(t_batch * batch, t_instance * instance) {
+
+	t_array *** candidates;
+	t_array * bestPaths;
+	int * numberOfCandidates;
+	int numberOfPathsPerFlow = batch->numberOfPathsPerFlow;
+	t_searchOptions options;
+	float bestCost = INFINITY, bestDelay = INFINITY;
+	unsigned long simulations = 0;
+	struct timespec start, end;
+	int f, iterations;
+
+	clock_gettime(CLOCK_MONOTONIC, & start);
+
+	MALLOC(candidates, sizeof(t_array **) * instance->numberOfFlows);
+	MALLOC(numberOfCandidates, sizeof(int) * instance->numberOfFlows);
+	bestPaths = arrayNew(instance->numberOfFlows);
+	for (f = 0; f < instance->numberOfFlows; f++) {
+
+		candidates[f] = instance->pairs[f]->candidates;
+		numberOfCandidates[f] = instance->pairs[f]->numberOfCandidates;
+		if (numberOfCandidates[f] < numberOfPathsPerFlow) numberOfPathsPerFlow = numberOfCandidates[f];
+		arraySet(bestPaths, f, candidates[f][0]);
+	}
+
+	searchOptionsInit(& options);
+	options.numberOfWorkers = batch->numberOfWorkers;
+	options.observer = countSimulation;
+	options.observerContext = & simulations;
+	iterations = searchMultiStart(batch->graph, candidates, numberOfCandidates, instance->numberOfFlows, 1, numberOfPathsPerFlow,
+		instance->flowTimes, instance->txDurations, & options, bestPaths, & bestCost, & bestDelay);
+
+	clock_gettime(CLOCK_MONOTONIC, & end);
+	writeResult(batch, instance, bestPaths, bestCost, bestDelay, iterations, simulations,
+		(end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9);
+
+	arrayFree(bestPaths);
+	free(bestPaths);
+	free(candidates);
+	free(numberOfCandidates);
+}
+
+void * batchRun(void * arg) {
+
+	t_batch * batch = arg;
+	int i;
+
+	while (1) {
+
+		pthread_mutex_lock(& batch->lock);
+		i = batch->nextInstance++;
+		pthread_mutex_unlock(& batch->lock);
+
+		if (i >= batch->numberOfInstances) break ;
+		solveInstance(batch, & batch->instances[i]);
+	}
+
+	return(NULL);
+}
+
+void usage(char * program) {
+
+	fprintf(stderr, "Use: %s [-b] [-j threads] [-m workers] [-k paths] [-f csv|jsonl] [-o output] <topology> <instance|directory>...\n", program);
+	exit(1);
+}
+
+int main(int argc, char ** argv) {
+
+	t_batch batch;
+	t_list * src, * dst, * flt;
+	t_pairPaths ** pairTable, * pair;
+	t_prefixTreeNode * path;
+	pthread_t * threads;
+	char ** names = NULL;
+	int numberOfNames = 0, numberOfThreads = 1, numberOfNodes;
+	int c, i, t;
+
+	batch.numberOfPathsPerFlow = 100;
+	batch.numberOfWorkers = 1;
+	batch.format = OUTPUT_CSV;
+	batch.output = stdout;
+
+	while ((c = getopt(argc, argv, "bj:m:k:f:o:")) != -1) {
+
+		switch(c) {
+
+			case 'b':
+				/*
+				 * Memory-bounded cycle detection (Brent).
+				 */
+				simulationSetCycleDetection(SIMULATION_CYCLE_BRENT);
+				break ;
+
+			case 'j':
+				/*
+				 * Instances solved at the same time.
+				 */
+				numberOfThreads = atoi(optarg);
+				break ;
+
+			case 'm':
+				/*
+				 * Search trajectories per instance (see fitpath -m).
+				 */
+				batch.numberOfWorkers = atoi(optarg);
+				break ;
+
+			case 'k':
+				/*
+				 * Yen paths per pair.
+				 */
+				batch.numberOfPathsPerFlow = atoi(optarg);
+				break ;
+
+			case 'f':
+				if (!strcmp(optarg, "csv")) batch.format = OUTPUT_CSV;
+				else if (!strcmp(optarg, "jsonl")) batch.format = OUTPUT_JSONL;
+				else usage(argv[0]);
+				break ;
+
+			case 'o':
+				batch.output = fopen(optarg, "w");
+				if (!batch.output) {
+
+					fprintf(stderr, "Could not open %s for writing\n", optarg);
+					exit(1);
+				}
+				break ;
+
+			default:
+				usage(argv[0]);
+		}
+	}
+
+	if (argc - optind < 2 || numberOfThreads < 1 || batch.numberOfWorkers < 1 || batch.numberOfPathsPerFlow < 1) usage(argv[0]);
+
+	batch.graph = parserParse(argv[optind], & src, & dst, & flt);
+	listFreeWithData(src);
+	free(src);
+	listFreeWithData(dst);
+	free(dst);
+	listFreeWithData(flt);
+	free(flt);
+
+	for (i = optind + 1; i < argc; i++) numberOfNames = addInstanceFiles(argv[i], & names, numberOfNames);
+
+	/*
+	 * Instances and paths are loaded before the threads start: yen is
+	 * not reentrant and changes the graph.
+	 */
+	numberOfNodes = graphSize(batch.graph);
+	MALLOC(pairTable, sizeof(t_pairPaths *) * numberOfNodes * numberOfNodes);
+	memset(pairTable, 0, sizeof(t_pairPaths *) * numberOfNodes * numberOfNodes);
+	MALLOC(batch.instances, sizeof(t_instance) * (numberOfNames + 1));
+	batch.numberOfInstances = 0;
+	for (i = 0; i < numberOfNames; i++) {
+
+		if (loadInstance(& batch.instances[batch.numberOfInstances], names[i], batch.graph, pairTable, batch.numberOfPathsPerFlow)) {
+
+			batch.numberOfInstances++;
+			continue ;
+		}
+
+		free(batch.instances[batch.numberOfInstances].pairs);
+		arrayFree(batch.instances[batch.numberOfInstances].flowTimes);
+		free(batch.instances[batch.numberOfInstances].flowTimes);
+		arrayFree(batch.instances[batch.numberOfInstances].txDurations);
+		free(batch.instances[batch.numberOfInstances].txDurations);
+	}
+	linkTableGet(batch.graph);
+
+	if (batch.format == OUTPUT_CSV) fprintf(batch.output, "instance,flows,cost,delay,iterations,simulations,seconds,paths\n");
+
+	pthread_mutex_init(& batch.lock, NULL);
+	batch.nextInstance = 0;
+	MALLOC(threads, sizeof(pthread_t) * numberOfThreads);
+	for (t = 1; t < numberOfThreads; t++) {
+
+		if (pthread_create(& threads[t], NULL, batchRun, & batch)) {
+
+			fprintf(stderr, "Could not create solver thread\n");
+			exit(1);
+		}
+	}
+	batchRun(& batch);
+	for (t = 1; t < numberOfThreads; t++) pthread_join(threads[t], NULL);
+	pthread_mutex_destroy(& batch.lock);
+	free(threads);
+
+	if (batch.output != stdout) fclose(batch.output);
+
+	for (i = 0; i < batch.numberOfInstances; i++) {
+
+		free(batch.instances[i].pairs);
+		arrayFree(batch.instances[i].flowTimes);
+		free(batch.instances[i].flowTimes);
+		arrayFree(batch.instances[i].txDurations);
+		free(batch.instances[i].txDurations);
+	}
+	free(batch.instances);
+
+	for (i = 0; i < numberOfNodes * numberOfNodes; i++) {
+
+		pair = pairTable[i];
+		if (!pair) continue ;
+		for (path = listBegin(pair->pathList); path; path = listNext(pair->pathList)) prefixTreePrune(path);
+		listFree(pair->pathList);
+		free(pair->pathList);
+		free(pair->candidates);
+		free(pair);
+	}
+	free(pairTable);
+
+	for (i = 0; i < numberOfNames; i++) free(names[i]);
+	free(names);
+
+	graphFree(batch.graph);
+	free(batch.graph);
+
+	return(0);
+}
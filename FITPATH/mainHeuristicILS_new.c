@@ -12,6 +12,7 @@
 #include "list.h"
 #include "array.h"
 #include "simulationh2.h"
+#include "neighborhood.h"
 #include "memory.h"
 #include "heuristics.h"
 #include "dijkstra.h"
@@ -72,30 +73,6 @@ void printCurrentPaths(t_array * paths, int numberOfPairs, int numberOfDescripto
 
 
 
-double maxCost(t_graph * graph, t_array * paths, t_array * flowTimes){
-	//Avaliação prévia do custo máximo da solução, com base na probabilidade de entrega. Sem considerar as perdas por enfileiramento e interferência.
-	int tmp;
-	float deliveryProbability, maxInterval, maxCost, flowTime;
-	for (int i = 0; i < arrayLength(paths); i++) {
-		deliveryProbability = 1.0;
-		for (int j = 1; j < arrayLength(arrayGet(paths, i)); j++) {
-			tmp = 1 - sqrt((double) GRAPH_MULTIPLIER / (double) graphGetCost(graph, (long) arrayGet(arrayGet(paths, i), j - 1), (long) arrayGet(arrayGet(paths, i), j)));
-			//printf("hopCost: %.2f ", tmp);
-			deliveryProbability  *= (1 - tmp * tmp * tmp * tmp);
-		}
-		maxInterval = (int) arrayGet(flowTimes, i) * deliveryProbability;
-		flowTime=(int) arrayGet(flowTimes, i);
-		maxCost = maxCost + ((maxInterval-flowTime)/maxInterval);			
-
-		//printf("\npathDeliveryProbability: %.2f\n", deliveryProbability);
-		//printf("maxInterval: %.2f\n", maxInterval);
-	}
-	
-	return maxCost;
-
-}
-
-
 // void printDSR(t_array * paths[], int numberOfPairs, int numberOfDescriptors, t_return * rf ){  
 //     printf("DSR Routes\n");
 //     //INST++;
@@ -247,9 +224,11 @@ int main(int argc, char ** argv) {
 	clock_t start = clock(); //adicionado por debora em 09/11/2023
 
 	int * currentSrc, * currentDst, * currentFlt, * randSrc, * randDst;
-	int i, j, c, numberOfPairs, numberOfNodes;
+	int i, c, numberOfPairs, numberOfNodes;
 	int numhist, numPaths;
-    int *num;
+	unsigned int seed = 1;
+	int maxIterations = 0;
+    t_neighborhood neighborhood;
 
 	int numberOfDescriptors = 1; //quantidade de descritores alterado de 2 para 1 em 02/07/2023
 	int numberOfPathsPerFlow = 100; // S = conjunto de soluções para cada fluxo
@@ -280,16 +259,46 @@ int main(int argc, char ** argv) {
 	*/
 
 
-	REF = atoi(argv[4]);
-	INST = atoi(argv[3]);
-	NumNodes = atoi(argv[2]); //Alterado em 18/07/2023 por Debora
+	while ((c = getopt(argc, argv, "S:i:")) != -1) {
+
+		switch(c) {
+
+			case 'S':
+				/*
+				 * Seed of rand(), fixed so that runs are reproducible.
+				 */
+				seed = atoi(optarg);
+				break ;
+
+			case 'i':
+				/*
+				 * Stop after this many iterations.
+				 */
+				maxIterations = atoi(optarg);
+				break ;
+
+			default:
+				fprintf(stderr, "Use: %s [-S seed] [-i iterations] <input> <numNodes> <inst> <ref>\n", argv[0]);
+				exit(1);
+		}
+	}
+
+	if (argc - optind != 4) {
+
+		fprintf(stderr, "Use: %s [-S seed] [-i iterations] <input> <numNodes> <inst> <ref>\n", argv[0]);
+		exit(1);
+	}
+
+	REF = atoi(argv[optind + 3]);
+	INST = atoi(argv[optind + 2]);
+	NumNodes = atoi(argv[optind + 1]); //Alterado em 18/07/2023 por Debora
 /*
 	NumNodes = atoi(argv[4]);
 	INST = atoi(argv[3]);
 	REF = atoi(argv[2]);
 */
 
-	graph = parserParse(argv[1], & src, & dst, &flt);
+	graph = parserParse(argv[optind], & src, & dst, &flt);
     //graphPrint(graph);
 	/*
 	 * Compute paths and place them in an array.
@@ -308,7 +317,7 @@ int main(int argc, char ** argv) {
 	listBegin(dst);
 	MALLOC(randSrc, sizeof(int));
 	MALLOC(randDst, sizeof(int));
-	srand(time(NULL));
+	srand(seed);
 	* randDst = rand()%numberOfNodes;
 	while(1) { // Gera o conjunto de soluções S para cada Fluxo
 		
@@ -519,6 +528,7 @@ return(0);
 	//printSolution(currentPaths, numberOfPairs, numberOfDescriptors, graph);
 	//return(0);
 
+	t = clock(); // the search time (and its 60 s limit) counts from here
 
 	MALLOC(r, sizeof(t_return));
 	MALLOC(rf, sizeof(t_return));
@@ -566,113 +576,73 @@ return(0);
 	   } 
     }
 	
-    num = (int *)calloc(numPaths+1, sizeof(int)) ;
-    if ( num == NULL ) {
-        perror("malloc") ;
-        return -1;
-    }
-
 	numhist=0;
-    while ( num[numPaths] == 0 ) { //Permutação entre os caminhos
-		int newPaths =0;
-		for(i=0; i < 2; i++) { //permutar os caminhos com o 2 conjuntos (currentPaths e neighborPaths)
-            for(j=0; j < numPaths; j++) {
-                if(num[j]){
-                    //printf("%d-n ", j);
-					newPaths=1;
-					arraySet(currentPaths, j, arrayGet(neighborPaths, j));
-                }else{
-                    //printf("%d-c ", j);
-					arraySet(currentPaths, j, arrayGet(currentAuxPaths, j));
-                }
-            }
-			num[0]++;
-           // putchar('\n');
-			//Avaliar a solução caso tenha um novo caminho
-			
+	neighborhoodBegin(& neighborhood, currentAuxPaths, neighborPaths, currentPaths);
+	while (neighborhoodNext(& neighborhood)) { //Permutação entre os caminhos, trocando um fluxo por vez (código de Gray)
 	
-			if(newPaths){
-				//printCurrentPaths(currentPaths, numberOfPairs, numberOfDescriptors);
-				//Avaliação prévia da solução.	
-				currentCost = maxCost(graph, currentPaths, simFlowTime);
-				//printf("maxCost = %.4f\n", currentCost);
-				if (currentCost <= bestCost) { //Executa a simulação se tiver melhor ou igual custo na avaliação prévia 
+		r = simulationSimulate(graph, currentPaths, simFlowTime, txDurations); //função objetivo
+		currentCost = r->cost;
+		currentTime = ((float)clock() - t)/((CLOCKS_PER_SEC/1000));
+		//printf("currentCost = %.4f\n", currentCost);	
+		if (currentCost <bestCost) {
+			
+				bestTime = currentTime;
+				bestCost = currentCost;
+				bestDelay = r->delay;
+				for(int p=0; p<numPaths;p++){ //armazena a solução anterior no histórico
+					arraySet(histPaths, p, arrayGet(bestPaths, p));
+				}
+
+				for(int p=0; p<numPaths;p++){ //obtem a melhor solução
+					arraySet(bestPaths, p, arrayGet(currentPaths, p));
+				}
+
+				printf("it 0 BestCost = %.4f\n", bestCost);	
 				
-					r = simulationSimulate(graph, currentPaths, simFlowTime, txDurations); //função objetivo
-					currentCost = r->cost;
-					currentTime = ((float)clock() - t)/((CLOCKS_PER_SEC/1000));
-					//printf("currentCost = %.4f\n", currentCost);	
-					if (currentCost <bestCost) {
-						
-							bestTime = currentTime;
-							bestCost = currentCost;
-							bestDelay = r->delay;
-							for(int p=0; p<numPaths;p++){ //armazena a solução anterior no histórico
-								arraySet(histPaths, p, arrayGet(bestPaths, p));
-							}
-
-							for(int p=0; p<numPaths;p++){ //obtem a melhor solução
-								arraySet(bestPaths, p, arrayGet(currentPaths, p));
-							}
-
-							printf("it 0 BestCost = %.4f\n", bestCost);	
-							
-							//printf("historico");
-							//printCurrentPaths(histPaths, numberOfPairs, numberOfDescriptors);
-							//printf("best");
-							//printCurrentPaths(bestPaths, numberOfPairs, numberOfDescriptors);
+				//printf("historico");
+				//printCurrentPaths(histPaths, numberOfPairs, numberOfDescriptors);
+				//printf("best");
+				//printCurrentPaths(bestPaths, numberOfPairs, numberOfDescriptors);
 
-					}
-					
-					if(currentCost ==bestCost){ //Critério de desempate
-						printf("Empate = %f %f\n", bestCost, r->delay);	
-						//printCurrentPaths(currentPaths, numberOfPairs, numberOfDescriptors);
-						for (int f = 0; f < numberOfPairs*numberOfDescriptors; f++) {
-							printf("%d	%.2f	%d\n", f, r->delayFlows[f],arrayLength(arrayGet(currentPaths, f)) );	
-						}
-						
-						if(r->delay < bestDelay){
-							
-							bestTime = currentTime;
-							bestCost = currentCost;
-							bestDelay = r->delay;
-							for(int p=0; p<numPaths;p++){ //armazena a solução anterior no histórico
-								arraySet(histPaths, p, arrayGet(bestPaths, p));
-							}
-
-							for(int p=0; p<numPaths;p++){ //obtem a melhor solução
-								arraySet(bestPaths, p, arrayGet(currentPaths, p));
-							}
-
-							printf("it 0 desempate BestCost = %.4f\n", bestCost);	
-							for (int f = 0; f < numberOfPairs*numberOfDescriptors; f++) {
-								printf("Flow %lu %.2f - Delay %.2f \n",f, r->rateFlows[f], r->delayFlows[f] );	
-							}
-	
-						}
-						
+		}
+		
+		if(currentCost ==bestCost){ //Critério de desempate
+			printf("Empate = %f %f\n", bestCost, r->delay);	
+			//printCurrentPaths(currentPaths, numberOfPairs, numberOfDescriptors);
+			for (int f = 0; f < numberOfPairs*numberOfDescriptors; f++) {
+				printf("%d	%.2f	%d\n", f, r->delayFlows[f],arrayLength(arrayGet(currentPaths, f)) );	
+			}
+			
+			if(r->delay < bestDelay){
+				
+				bestTime = currentTime;
+				bestCost = currentCost;
+				bestDelay = r->delay;
+				for(int p=0; p<numPaths;p++){ //armazena a solução anterior no histórico
+					arraySet(histPaths, p, arrayGet(bestPaths, p));
+				}
 
-					}
-						
+				for(int p=0; p<numPaths;p++){ //obtem a melhor solução
+					arraySet(bestPaths, p, arrayGet(currentPaths, p));
+				}
+
+				printf("it 0 desempate BestCost = %.4f\n", bestCost);	
+				for (int f = 0; f < numberOfPairs*numberOfDescriptors; f++) {
+					printf("Flow %lu %.2f - Delay %.2f \n",f, r->rateFlows[f], r->delayFlows[f] );	
 				}
+
 			}
 			
-        }
-
-        for(i=0; i < numPaths; i++) {
-            if(num[i] == 2) {
-                num[i] = 0;
-                num[i+1]++ ;
-            }
-        }
-    }
- 
-    free(num) ;
+
+		}
+			
+	}
+	neighborhoodFree(& neighborhood);
 	
    
 	//Cada iteração: Permuta a proxima solução com a melhor solução e em seguida com o histórico.
 	int iteracao =1;
-    while (bestCost>0 & iteracao < numberOfPathsPerFlow-1 & currentTime<60000){ //Reduzir o time para instancias que não atingirem o tempo
+    while (bestCost>0 & iteracao < numberOfPathsPerFlow-1 & currentTime<60000 & (!maxIterations || iteracao < maxIterations)){ //Reduzir o time para instancias que não atingirem o tempo
 		int bestSolution=0;
 		//printf("iteração %d\n", iteracao);
 		
@@ -696,103 +666,66 @@ return(0);
 		//printCurrentPaths(neighborPaths, numberOfPairs, numberOfDescriptors);
 		
 		//printf("Busca Local permuta 1\n");
-		num = (int *)calloc(numPaths+1, sizeof(int)) ;
-		if ( num == NULL ) {
-			perror("malloc") ;
-			return -1;
-		}
-		while ( num[numPaths] == 0 ) { //Permutação entre os caminhos
-			int newPaths=0;
-			for(i=0; i < 2; i++) { //permutar os caminhos com o 2 conjuntos (currentPaths e neighborPaths)
-				for(j=0; j < numPaths; j++) {
-					if(num[j]){
-						//printf("%d-n ", j);
-						newPaths=1;
-						arraySet(currentPaths, j, arrayGet(neighborPaths, j));
-					}else{
-						//printf("%d-c ", j);
-						arraySet(currentPaths, j, arrayGet(currentAuxPaths, j));
-					}
-				}
-				num[0]++ ;
-			// putchar('\n');
+		neighborhoodBegin(& neighborhood, currentAuxPaths, neighborPaths, currentPaths);
+		while (neighborhoodNext(& neighborhood)) { //Permutação entre os caminhos, trocando um fluxo por vez (código de Gray)
+	
+			r = simulationSimulate(graph, currentPaths, simFlowTime, txDurations); //função objetivo
+			currentCost = r->cost;
+			currentTime = ((float)clock() - t)/((CLOCKS_PER_SEC/1000));
+			//printf("currentCost = %.4f\n", currentCost);	
+			if (currentCost <bestCost) {
+				bestTime = currentTime;
+				bestCost = currentCost;
+				bestDelay = r->delay;
 				
-				if(newPaths){
-					//Avalia o caminho
-					currentCost = maxCost(graph, currentPaths, simFlowTime);
-					if (currentCost <= bestCost) { //Executa a simulação se tiver melhor ou igual custo na avaliação prévia 
+				bestSolution=1;
 				
-						r = simulationSimulate(graph, currentPaths, simFlowTime, txDurations); //função objetivo
-						currentCost = r->cost;
-						currentTime = ((float)clock() - t)/((CLOCKS_PER_SEC/1000));
-						//printf("currentCost = %.4f\n", currentCost);	
-						if (currentCost <bestCost) {
-							bestTime = currentTime;
-							bestCost = currentCost;
-							bestDelay = r->delay;
-							
-							bestSolution=1;
-							
-							for(int p=0; p<numPaths;p++){ //obtem a melhor solução
-								arraySet(bestPaths, p, arrayGet(currentPaths, p));
-							}
-
-							printf("it %d BestCost = %f\n", iteracao, bestCost);	
-							//printf("historico");
-							//printCurrentPaths(histPaths, numberOfPairs, numberOfDescriptors);
-							//printf("best");
-							//printCurrentPaths(bestPaths, numberOfPairs, numberOfDescriptors);
-							
-						}
-
-						if(currentCost ==bestCost){ //Critério de desempate
-							printf("Empate = %f %f\n", bestCost, r->delay);	
-							//printCurrentPaths(currentPaths, numberOfPairs, numberOfDescriptors);
-							for (int f = 0; f < numberOfPairs*numberOfDescriptors; f++) {
-								printf("%d	%.2f	%d\n", f, r->delayFlows[f],arrayLength(arrayGet(currentPaths, f)) );	
-							}
-							
-							if(r->delay < bestDelay){
-								
-								bestTime = currentTime;
-								bestCost = currentCost;
-								bestDelay = r->delay;
-								for(int p=0; p<numPaths;p++){ //armazena a solução anterior no histórico
-									arraySet(histPaths, p, arrayGet(bestPaths, p));
-								}
-
-								for(int p=0; p<numPaths;p++){ //obtem a melhor solução
-									arraySet(bestPaths, p, arrayGet(currentPaths, p));
-								}
-
-								printf("it %d desempate BestCost = %f\n", iteracao, bestCost);
-								for (int f = 0; f < numberOfPairs*numberOfDescriptors; f++) {
-								   printf("Flow %lu %.2f - Delay %.2f \n",f, r->rateFlows[f], r->delayFlows[f] );	
-							    }
-		
-							}
-							
-
-					}
-
+				for(int p=0; p<numPaths;p++){ //obtem a melhor solução
+					arraySet(bestPaths, p, arrayGet(currentPaths, p));
+				}
 
+				printf("it %d BestCost = %f\n", iteracao, bestCost);	
+				//printf("historico");
+				//printCurrentPaths(histPaths, numberOfPairs, numberOfDescriptors);
+				//printf("best");
+				//printCurrentPaths(bestPaths, numberOfPairs, numberOfDescriptors);
+				
+			}
 
-					}else{
-						printf("maxCost = %.4f\n", currentCost);
+			if(currentCost ==bestCost){ //Critério de desempate
+				printf("Empate = %f %f\n", bestCost, r->delay);	
+				//printCurrentPaths(currentPaths, numberOfPairs, numberOfDescriptors);
+				for (int f = 0; f < numberOfPairs*numberOfDescriptors; f++) {
+					printf("%d	%.2f	%d\n", f, r->delayFlows[f],arrayLength(arrayGet(currentPaths, f)) );	
+				}
+				
+				if(r->delay < bestDelay){
 					
+					bestTime = currentTime;
+					bestCost = currentCost;
+					bestDelay = r->delay;
+					for(int p=0; p<numPaths;p++){ //armazena a solução anterior no histórico
+						arraySet(histPaths, p, arrayGet(bestPaths, p));
 					}
-				}
-			
-				for(i=0; i < numPaths; i++) {
-					if(num[i] == 2) {
-						num[i] = 0;
-						num[i+1]++ ;
+
+					for(int p=0; p<numPaths;p++){ //obtem a melhor solução
+						arraySet(bestPaths, p, arrayGet(currentPaths, p));
 					}
+
+					printf("it %d desempate BestCost = %f\n", iteracao, bestCost);
+					for (int f = 0; f < numberOfPairs*numberOfDescriptors; f++) {
+					   printf("Flow %lu %.2f - Delay %.2f \n",f, r->rateFlows[f], r->delayFlows[f] );	
+				    }
+
 				}
-			}
-    	}
- 
-		free(num);
+				
+
+		}
+
+
+
+		}
+		neighborhoodFree(& neighborhood);
 
     	
 		if(bestSolution){ //Caso tenha encontrado uma melhor solução, permutar essa solução com o histórico.
@@ -818,102 +751,66 @@ return(0);
 		//printCurrentPaths(neighborPaths, numberOfPairs, numberOfDescriptors);
 		
 		//printf("Busca Local permuta 2\n");
-		num = (int *)calloc(numPaths+1, sizeof(int)) ;
-		if ( num == NULL ) {
-			perror("malloc") ;
-			return -1;
-		}
-		while ( num[numPaths] == 0 ) { //Permutação entre os caminhos
-			int newPaths=0;
-			for(i=0; i < 2; i++) { //permutar os caminhos com o 2 conjuntos (currentPaths e neighborPaths)
-				for(j=0; j < numPaths; j++) {
-					if(num[j]){
-						//printf("%d-n ", j);
-						newPaths=1;
-						arraySet(currentPaths, j, arrayGet(neighborPaths, j));
-					}else{
-						//printf("%d-c ", j);
-						arraySet(currentPaths, j, arrayGet(currentAuxPaths, j));
-					}
-				}
-				num[0]++ ;
-			// putchar('\n');
-				
-				if(newPaths){
-					//printCurrentPaths(currentPaths, numberOfPairs, numberOfDescriptors);
-					//Avaliação prévia da solução.	
-					currentCost = maxCost(graph, currentPaths, simFlowTime);
-					//printf("maxCost = %.4f\n", currentCost);
-					if (currentCost <= bestCost) { //Executa a simulação se tiver melhor ou igual custo na avaliação prévia 
-				
-						r = simulationSimulate(graph, currentPaths, simFlowTime, txDurations); //função objetivo
-						currentCost = r->cost;
-						currentTime = ((float)clock() - t)/((CLOCKS_PER_SEC/1000));
-						//printf("currentCost = %.4f\n", currentCost);	
-						if (currentCost <bestCost) {
-							bestTime = currentTime;
-							bestCost = currentCost;
-							bestDelay = r->delay;
-							for(int p=0; p<numPaths;p++){ //armazena a solução anterior no histórico
-								arraySet(histPaths, p, arrayGet(bestPaths, p));
-							}
-
-							for(int p=0; p<numPaths;p++){ //obtem a melhor solução
-								arraySet(bestPaths, p, arrayGet(currentPaths, p));
-							}
-
-							printf("it %d BestCost = %.4f\n", iteracao, bestCost);	
-							//printf("historico");
-							//printCurrentPaths(histPaths, numberOfPairs, numberOfDescriptors);
-							//printf("best");
-							//printCurrentPaths(bestPaths, numberOfPairs, numberOfDescriptors);
-							
-						}
-
-						if(currentCost ==bestCost){ //Critério de desempate
-							printf("Empate = %f %f\n", bestCost, r->delay);	
-							//printCurrentPaths(currentPaths, numberOfPairs, numberOfDescriptors);
-							for (int f = 0; f < numberOfPairs*numberOfDescriptors; f++) {
-								printf("%d	%.2f	%d\n", f, r->delayFlows[f],arrayLength(arrayGet(currentPaths, f)) );	
-							}
-							
-							if(r->delay < bestDelay){
-								
-								bestTime = currentTime;
-								bestCost = currentCost;
-								bestDelay = r->delay;
-								for(int p=0; p<numPaths;p++){ //armazena a solução anterior no histórico
-									arraySet(histPaths, p, arrayGet(bestPaths, p));
-								}
-
-								for(int p=0; p<numPaths;p++){ //obtem a melhor solução
-									arraySet(bestPaths, p, arrayGet(currentPaths, p));
-								}
-
-								printf("it 0 desempate BestCost = %.4f\n", bestCost);	
-								for (int f = 0; f < numberOfPairs*numberOfDescriptors; f++) {
-								printf("Flow %lu %.2f - Delay %.2f \n",f, r->rateFlows[f], r->delayFlows[f] );	
-								}
+		neighborhoodBegin(& neighborhood, currentAuxPaths, neighborPaths, currentPaths);
+		while (neighborhoodNext(& neighborhood)) { //Permutação entre os caminhos, trocando um fluxo por vez (código de Gray)
 	
-							}
-							
+			r = simulationSimulate(graph, currentPaths, simFlowTime, txDurations); //função objetivo
+			currentCost = r->cost;
+			currentTime = ((float)clock() - t)/((CLOCKS_PER_SEC/1000));
+			//printf("currentCost = %.4f\n", currentCost);	
+			if (currentCost <bestCost) {
+				bestTime = currentTime;
+				bestCost = currentCost;
+				bestDelay = r->delay;
+				for(int p=0; p<numPaths;p++){ //armazena a solução anterior no histórico
+					arraySet(histPaths, p, arrayGet(bestPaths, p));
+				}
+
+				for(int p=0; p<numPaths;p++){ //obtem a melhor solução
+					arraySet(bestPaths, p, arrayGet(currentPaths, p));
+				}
 
+				printf("it %d BestCost = %.4f\n", iteracao, bestCost);	
+				//printf("historico");
+				//printCurrentPaths(histPaths, numberOfPairs, numberOfDescriptors);
+				//printf("best");
+				//printCurrentPaths(bestPaths, numberOfPairs, numberOfDescriptors);
+				
+			}
 
+			if(currentCost ==bestCost){ //Critério de desempate
+				printf("Empate = %f %f\n", bestCost, r->delay);	
+				//printCurrentPaths(currentPaths, numberOfPairs, numberOfDescriptors);
+				for (int f = 0; f < numberOfPairs*numberOfDescriptors; f++) {
+					printf("%d	%.2f	%d\n", f, r->delayFlows[f],arrayLength(arrayGet(currentPaths, f)) );	
+				}
+				
+				if(r->delay < bestDelay){
+					
+					bestTime = currentTime;
+					bestCost = currentCost;
+					bestDelay = r->delay;
+					for(int p=0; p<numPaths;p++){ //armazena a solução anterior no histórico
+						arraySet(histPaths, p, arrayGet(bestPaths, p));
 					}
 
+					for(int p=0; p<numPaths;p++){ //obtem a melhor solução
+						arraySet(bestPaths, p, arrayGet(currentPaths, p));
 					}
-				}
-			
-				for(i=0; i < numPaths; i++) {
-					if(num[i] == 2) {
-						num[i] = 0;
-						num[i+1]++ ;
+
+					printf("it 0 desempate BestCost = %.4f\n", bestCost);	
+					for (int f = 0; f < numberOfPairs*numberOfDescriptors; f++) {
+					printf("Flow %lu %.2f - Delay %.2f \n",f, r->rateFlows[f], r->delayFlows[f] );	
 					}
+
 				}
-			}
-    	}
- 
-		free(num);
+				
+
+
+		}
+
+		}
+		neighborhoodFree(& neighborhood);
 
 		iteracao++;
 	}
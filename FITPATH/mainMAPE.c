@@ -62,6 +62,7 @@ int main(int argc, char ** argv) {
 	int i, j, c, numberOfPairs, numberOfNodes;
 	int numhist, numPaths;
     int *num;
+	unsigned int seed = 1;
 
 	int numberOfDescriptors = 1; //quantidade de descritores alterado de 2 para 1 em 02/07/2023
 	
@@ -78,7 +79,30 @@ int main(int argc, char ** argv) {
 	FILE *arq;
 
 	
-	graph = parserParse(argv[1], & src, & dst, &flt);
+	while ((c = getopt(argc, argv, "S:")) != -1) {
+
+		switch(c) {
+
+			case 'S':
+				/*
+				 * Seed of rand(), fixed so that runs are reproducible.
+				 */
+				seed = atoi(optarg);
+				break ;
+
+			default:
+				fprintf(stderr, "Use: %s [-S seed] <input>\n", argv[0]);
+				exit(1);
+		}
+	}
+
+	if (argc - optind != 1) {
+
+		fprintf(stderr, "Use: %s [-S seed] <input>\n", argv[0]);
+		exit(1);
+	}
+
+	graph = parserParse(argv[optind], & src, & dst, &flt);
     
 	nodePairs = arrayNew(listLength(src)); // Vetor que armazenar todos caminhos do conjunto de soluções em cada fluxo
 	flowTime = arrayNew(listLength(flt)); // Vetor que armazenar todos intevalos de tempo de cada fluxo
@@ -91,7 +115,7 @@ int main(int argc, char ** argv) {
 	listBegin(dst);
 	MALLOC(randSrc, sizeof(int));
 	MALLOC(randDst, sizeof(int));
-	srand(time(NULL));
+	srand(seed);
 	* randDst = rand()%numberOfNodes;
 	while(1) { // Gera o conjunto de soluções S para cada Fluxo
 		currentSrc = listCurrent(src); // lista de fonte do arquivo
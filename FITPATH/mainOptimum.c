@@ -1,205 +1,368 @@
+#define _GNU_SOURCE
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
-
-#define _ISOC99_SOURCE
+#include <pthread.h>
 #include <math.h>
 
 #include "parser.h"
 #include "graph.h"
-#include "paths.h"
+#include "yen.h"
 #include "prefixTree.h"
 #include "list.h"
 #include "array.h"
-#include "simulation.h"
+#include "memory.h"
+#include "linkTable.h"
+#include "simulationh2.h"
+#include "search.h"
 
 #include "heuristics.h"
-#include "dijkstra.h"
 
 #include <string.h>
 
+/*
+ * Exact search over every combination of the K shortest paths of each
+ * flow, by default the SEARCH_PATHS_PER_FLOW paths fitpath searches. Flows are fixed one at a time and a partial assignment is
+ * discarded when its lower bound (heuristicCostLowerBound, plus the
+ * best individual bound of each flow still free) exceeds the best
+ * simulated cost found so far. The assignments of the first few flows
+ * form a queue of subtrees shared by the worker threads.
+ */
+
+typedef struct {
+
+	t_graph * graph;
+	int numberOfFlows;
+	int * numberOfCandidates;		// Candidate paths of each flow.
+	t_array *** candidates;			// candidates[f][c]: sorted by individual bound.
+	float ** candidateBounds;		// Individual bound of each candidate.
+	float * freeBound;				// freeBound[f]: best individual bounds of flows f..n-1.
+	t_array * flowTimes;
+	t_array * txDurations;
+
+	int taskDepth;					// Flows fixed by a task.
+	long numberOfTasks;
+	long nextTask;
+
+	double incumbent;				// Best cost so far, read without the lock.
+	long bestIndex;					// Enumeration index of the best combination.
+	int * bestChoice;
+	pthread_mutex_t lock;
+
+	unsigned long simulations;
+	unsigned long pruned;
+} t_search;
+
+static int numberOfThreads = 0;
+
+/*
+ * Record a simulated combination. Ties go to the combination found
+ * first in enumeration order, so the result does not depend on the
+ * number of threads.
+ */
+static void optimumOffer(t_search * search, int * choice, long index, double cost) {
+
+	int f;
+
+	pthread_mutex_lock(& search->lock);
+	if (cost < search->incumbent || (cost == search->incumbent && index < search->bestIndex)) {
+
+		for (f = 0; f < search->numberOfFlows; f++) search->bestChoice[f] = choice[f];
+		search->bestIndex = index;
+		__atomic_store(& search->incumbent, & cost, __ATOMIC_RELAXED);
+	}
+	pthread_mutex_unlock(& search->lock);
+}
+
+static void optimumSearch(t_search * search, t_heuristicCtx * ctx, t_array * paths, int * choice, int flow, long index) {
+
+	t_return * r;
+	double incumbent;
+	float bound;
+	int c;
+
+	if (flow == search->numberOfFlows) {
+
+		/*
+		 * The first combination is the initial incumbent.
+		 */
+		if (index == 0) return ;
+
+		r = simulationSimulate(search->graph, paths, search->flowTimes, search->txDurations);
+		__atomic_fetch_add(& search->simulations, 1, __ATOMIC_RELAXED);
+		optimumOffer(search, choice, index, r->cost);
+		simulationReturnFree(r);
+		free(r);
+		return ;
+	}
+
+	for (c = 0; c < search->numberOfCandidates[flow]; c++) {
+
+		choice[flow] = c;
+		arraySet(paths, flow, search->candidates[flow][c]);
+
+		/*
+		 * Equal bounds are kept, so that ties are settled by
+		 * optimumOffer as in a full enumeration.
+		 */
+		bound = heuristicCostLowerBound(ctx, search->graph, paths, flow + 1, search->flowTimes);
+		if (flow + 1 < search->numberOfFlows) bound += search->freeBound[flow + 1];
+		__atomic_load(& search->incumbent, & incumbent, __ATOMIC_RELAXED);
+		if (bound > incumbent) {
+
+			__atomic_fetch_add(& search->pruned, 1, __ATOMIC_RELAXED);
+			continue ;
+		}
+
+		optimumSearch(search, ctx, paths, choice, flow + 1, index * search->numberOfCandidates[flow] + c);
+	}
+}
+
+static void * optimumWorker(void * arg) {
+
+	t_search * search = arg;
+	t_heuristicCtx * ctx;
+	t_array * paths;
+	int * choice;
+	long task, index, rest;
+	double incumbent;
+	float bound;
+	int f, c;
+
+	paths = arrayNew(search->numberOfFlows);
+	MALLOC(choice, sizeof(int) * search->numberOfFlows);
+	ctx = heuristicCtxNew(graphSize(search->graph));
+
+	while (1) {
+
+		task = __atomic_fetch_add(& search->nextTask, 1, __ATOMIC_RELAXED);
+		if (task >= search->numberOfTasks) break ;
+
+		/*
+		 * The task number encodes the choices of the first
+		 * taskDepth flows, most significant first.
+		 */
+		rest = task;
+		for (f = search->taskDepth - 1; f >= 0; f--) {
+
+			choice[f] = rest % search->numberOfCandidates[f];
+			rest /= search->numberOfCandidates[f];
+		}
+
+		index = 0;
+		for (f = 0; f < search->taskDepth; f++) {
+
+			c = choice[f];
+			arraySet(paths, f, search->candidates[f][c]);
+			index = index * search->numberOfCandidates[f] + c;
+
+			bound = heuristicCostLowerBound(ctx, search->graph, paths, f + 1, search->flowTimes);
+			if (f + 1 < search->numberOfFlows) bound += search->freeBound[f + 1];
+			__atomic_load(& search->incumbent, & incumbent, __ATOMIC_RELAXED);
+			if (bound > incumbent) break ;
+		}
+
+		if (f < search->taskDepth) {
+
+			__atomic_fetch_add(& search->pruned, 1, __ATOMIC_RELAXED);
+			continue ;
+		}
+
+		optimumSearch(search, ctx, paths, choice, search->taskDepth, index);
+	}
+
+	arrayFree(paths);
+	free(paths);
+	free(choice);
+	heuristicCtxFree(ctx);
+	free(ctx);
+
+	return(NULL);
+}
+
 int main(int argc, char ** argv) {
 
-	int * currentSrc, * currentDst;
-	int i, j, numberOfPairs, run;
-unsigned long asd;
+	int * currentSrc, * currentDst, * currentFlt;
+	int i, j, f, c, numberOfFlows, pathsPerFlow, opt;
+	long combinations;
 	t_graph * graph;
 	t_list * pathList;
-	t_list * src, * dst;
+	t_list * src, * dst, * flt;
 	t_prefixTreeNode * path;
-	t_array * nodePairs;
-	t_array * currentPaths, * bestPaths;
-	float * currentSimulatedCosts;
-	float currentCost, bestCost, upperBound;
-	char filename[800], * inputPrefix, * input;
+	t_array * nodePairs, * currentPaths, * candidate;
+	t_return * r;
+	t_search search;
+	pthread_t * threads;
+	float bound;
 
-	if (argc != 2 && argc != 4) {
+	pathsPerFlow = SEARCH_PATHS_PER_FLOW;
 
-		fprintf(stderr, "Use: %s [-p inputPrefix] <input>\n", argv[0]);
-		exit(1);
+	while ((opt = getopt(argc, argv, "bj:k:")) != -1) {
+
+		switch(opt) {
+
+			case 'b':
+				/*
+				 * Memory-bounded cycle detection (Brent).
+				 */
+				simulationSetCycleDetection(SIMULATION_CYCLE_BRENT);
+				break ;
+
+			case 'j':
+				numberOfThreads = atoi(optarg);
+				break ;
+
+			case 'k':
+				pathsPerFlow = atoi(optarg);
+				break ;
+
+			default:
+				fprintf(stderr, "Use: %s [-b] [-j threads] [-k pathsPerFlow] <input>\n", argv[0]);
+				exit(1);
+		}
 	}
 
-	input = argv[argc - 1];
+	if (argc - optind != 1 || pathsPerFlow < 1) {
 
-	if (argc > 2 && !strcmp(argv[1], "-p"))
-		inputPrefix = argv[2];
-	else 
-		inputPrefix = input;
+		fprintf(stderr, "Use: %s [-b] [-j threads] [-k pathsPerFlow] <input>\n", argv[0]);
+		exit(1);
+	}
 
-	graph = parserParse(input, & src, & dst);
+	graph = parserParse(argv[optind], & src, & dst, & flt);
 
-	/*
-	 * Load each list of paths (for each pair) 
-	 * from precomputed file.
-	 * Each array entry corresponds to a pair of
-	 * source and destination. Each entry is a 
-	 * handler for a list containing the paths.
-	 */
-	nodePairs = arrayNew(listLength(src));
+	numberOfFlows = listLength(src);
+	nodePairs = arrayNew(numberOfFlows);
+	search.flowTimes = arrayNew(numberOfFlows);
+	search.txDurations = arrayNew(numberOfFlows);
 
 	i = 0;
 	listBegin(src);
 	listBegin(dst);
+	listBegin(flt);
 	while(1) {
 
 		currentSrc = listCurrent(src);
 		currentDst = listCurrent(dst);
+		currentFlt = listCurrent(flt);
 
-		sprintf(filename, "%s_%d_%d.sav", inputPrefix, * currentSrc, * currentDst);
-		pathList = prefixTreeLoad(filename);
+		pathList = yen(graph, * currentSrc, * currentDst, pathsPerFlow);
 		arraySet(nodePairs, i, pathList);
+		arraySet(search.flowTimes, i, (void *) (long) * currentFlt);
+		arraySet(search.txDurations, i, (void *) 238L);
+
+		printf("%d paths were generated between nodes %d and %d\n", listLength(pathList), * currentSrc, * currentDst);
+		if (listLength(pathList) == 0) return(0);
 
-printf("%d paths were generated between nodes %d and %d:\n\n", listLength(pathList), * currentSrc, * currentDst);
-//for (path = listBegin(pathList); path; path = listNext(pathList)) prefixTreePrint(path);
 		i++;
 		if (listNext(src) == NULL) break ;
 		listNext(dst);
+		listNext(flt);
 	}
 
-	numberOfPairs = i;
+	/*
+	 * The bounds and the simulator share the link table, which must
+	 * exist before the workers start.
+	 */
+	linkTableGet(graph);
 
-	currentSimulatedCosts = malloc(numberOfPairs * sizeof(float));
+	search.graph = graph;
+	search.numberOfFlows = numberOfFlows;
+	MALLOC(search.numberOfCandidates, sizeof(int) * numberOfFlows);
+	MALLOC(search.candidates, sizeof(t_array **) * numberOfFlows);
+	MALLOC(search.candidateBounds, sizeof(float *) * numberOfFlows);
+	MALLOC(search.freeBound, sizeof(float) * numberOfFlows);
 
 	/*
-	 * Now comes the expensive part: we generate all combinations 
-	 * of paths and simulate them, storing the best combination as
-	 * we go.
+	 * Candidates of each flow, sorted by their individual bound
+	 * (insertion sort, keeping Yen's order on ties).
 	 */
-	currentPaths = arrayNew(numberOfPairs);
-	bestPaths = arrayNew(numberOfPairs);
-	bestCost = INFINITY;
-	upperBound = 0.0;
+	combinations = 1;
+	for (f = 0; f < numberOfFlows; f++) {
 
-	for (i = 0; i < numberOfPairs; i++) {
+		pathList = arrayGet(nodePairs, f);
+		search.numberOfCandidates[f] = listLength(pathList);
+		MALLOC(search.candidates[f], sizeof(t_array *) * listLength(pathList));
+		MALLOC(search.candidateBounds[f], sizeof(float) * listLength(pathList));
 
-		path = listBegin(arrayGet(nodePairs, i));
-		arraySet(currentPaths, i, prefixTreePath(path));
-		currentSimulatedCosts[i] = prefixTreeGetSimulatedCost(path);
-		upperBound += 1.0/prefixTreeGetSimulatedCost(path);
-	}
+		c = 0;
+		for (path = listBegin(pathList); path; path = listNext(pathList)) {
 
-	heuristicInit(graphSize(graph), numberOfPairs);
-asd = 0;
-	run = 1;
-	while(run) {
+			candidate = prefixTreePath(path);
+			bound = heuristicPathCostLowerBound(graph, candidate);
+			for (j = c; j > 0 && search.candidateBounds[f][j - 1] > bound; j--) {
 
-		currentCost = simulationSimulate(graph, currentPaths);
-#ifdef COMMENT
-printf("Trying path set:\n");
-for (i = 0; i < arrayLength(currentPaths); i++) {
+				search.candidates[f][j] = search.candidates[f][j - 1];
+				search.candidateBounds[f][j] = search.candidateBounds[f][j - 1];
+			}
+			search.candidates[f][j] = candidate;
+			search.candidateBounds[f][j] = bound;
+			c++;
+		}
 
-	for (j = 0; j < arrayLength(arrayGet(currentPaths, i)); j++) {
-		
-		printf("%lu ", (unsigned long) arrayGet(arrayGet(currentPaths, i), j));
+		combinations *= search.numberOfCandidates[f];
 	}
-	printf("\n");
-}
-asd++;
-printf("__: %e vs %e\n", heuristicMultiplePathNewlowerBound(graph, currentPaths, currentSimulatedCosts, bestCost), bestCost);
-#endif
 
-		if (currentCost < bestCost) {
+	search.freeBound[numberOfFlows - 1] = search.candidateBounds[numberOfFlows - 1][0];
+	for (f = numberOfFlows - 2; f >= 0; f--)
+		search.freeBound[f] = search.freeBound[f + 1] + search.candidateBounds[f][0];
 
-			for (i = 0; i < numberOfPairs; i++) {
+	if (numberOfThreads <= 0) numberOfThreads = sysconf(_SC_NPROCESSORS_ONLN);
+	if (numberOfThreads < 1) numberOfThreads = 1;
 
-				arraySet(bestPaths, i, arrayGet(currentPaths, i));
-			}
-			bestCost = currentCost;
-		}
-
-		while(1) {
+	/*
+	 * Enough subtrees to keep every thread busy while the
+	 * incumbent improves.
+	 */
+	search.taskDepth = 0;
+	search.numberOfTasks = 1;
+	while (search.taskDepth < numberOfFlows && search.numberOfTasks < 4 * numberOfThreads) {
 
-			for (i = 0; i < numberOfPairs; i++) {
-/*
-if (i > 0) {
-printf("Currently at: (");
-int z;
-for (z = 0; z < numberOfPairs - 1; z++) printf("%d,", listGetIndex(arrayGet(nodePairs, z)));
-printf("%d", listGetIndex(arrayGet(nodePairs, z)));
-printf(")\n");
-}*/
-				upperBound -= 1.0/prefixTreeGetSimulatedCost(listCurrent(arrayGet(nodePairs, i)));
-				path = listNext(arrayGet(nodePairs, i));
-				if (path == NULL) {
-
-					if (i == numberOfPairs - 1) {
-						run = 0;
-						break ;
-					}
-
-					path = listBegin(arrayGet(nodePairs, i));
-					arraySet(currentPaths, i, prefixTreePath(path));
-					currentSimulatedCosts[i] = prefixTreeGetSimulatedCost(path);
-					upperBound += 1.0/prefixTreeGetSimulatedCost(path);
-					continue ;
-				}
-				upperBound += 1.0/prefixTreeGetSimulatedCost(path);
-//printf("Upper bound is %.2f vs. best cost of %.2f\n", 1.0/upperBound, bestCost);
-				if (1.0/upperBound > bestCost) {
-
-					upperBound -= 1.0/prefixTreeGetSimulatedCost(path);
-
-					if (i == numberOfPairs - 1) {
-						run = 0;
-						break ;
-					}
-
-					path = listBegin(arrayGet(nodePairs, i));
-					arraySet(currentPaths, i, prefixTreePath(path));
-					currentSimulatedCosts[i] = prefixTreeGetSimulatedCost(path);
-					upperBound += 1.0/prefixTreeGetSimulatedCost(path);
-					continue ;
-				}
-
-				arraySet(currentPaths, i, prefixTreePath(path));
-				currentSimulatedCosts[i] = prefixTreeGetSimulatedCost(path);
-				break ;
-			}
-			if (run == 0) break ;
-/*			
-printf("Should we try path set:\n");
-for (i = 0; i < arrayLength(currentPaths); i++) {
-
-	for (j = 0; j < arrayLength(arrayGet(currentPaths, i)); j++) {
-		
-		printf("%lu ", (unsigned long) arrayGet(arrayGet(currentPaths, i), j));
+		search.numberOfTasks *= search.numberOfCandidates[search.taskDepth];
+		search.taskDepth++;
 	}
-	printf("\n");
-}
-*/
-//printf("Heuristic cost is given by %.2f\n", heuristicMultiplePathNewlowerBound(graph, currentPaths, bestCost));
+	search.nextTask = 0;
 
-			if (heuristicMultiplePathNewlowerBound(graph, currentPaths, currentSimulatedCosts, bestCost) < bestCost) break ;
-//break ;
+	/*
+	 * The combination of the individually best paths is the
+	 * initial incumbent.
+	 */
+	currentPaths = arrayNew(numberOfFlows);
+	for (f = 0; f < numberOfFlows; f++) arraySet(currentPaths, f, search.candidates[f][0]);
+	r = simulationSimulate(graph, currentPaths, search.flowTimes, search.txDurations);
+	search.incumbent = r->cost;
+	search.bestIndex = 0;
+	MALLOC(search.bestChoice, sizeof(int) * numberOfFlows);
+	memset(search.bestChoice, 0, sizeof(int) * numberOfFlows);
+	simulationReturnFree(r);
+	free(r);
+	search.simulations = 1;
+	search.pruned = 0;
+	pthread_mutex_init(& search.lock, NULL);
+
+	MALLOC(threads, sizeof(pthread_t) * numberOfThreads);
+	for (i = 1; i < numberOfThreads; i++) {
+
+		if (pthread_create(& threads[i], NULL, optimumWorker, & search)) {
+
+			fprintf(stderr, "Could not create search thread\n");
+			exit(1);
 		}
 	}
 
-	printf("Best path set has cost %.2f and is:\n", bestCost / GRAPH_MULTIPLIER);
-	for (i = 0; i < arrayLength(bestPaths); i++) {
+	optimumWorker(& search);
+
+	for (i = 1; i < numberOfThreads; i++) pthread_join(threads[i], NULL);
 
-		for (j = 0; j < arrayLength(arrayGet(bestPaths, i)); j++) {
-			
-			printf("%lu ", (unsigned long) arrayGet(arrayGet(bestPaths, i), j));
+	printf("Search space: the %d shortest paths (Yen) of each flow%s\n", pathsPerFlow,
+		pathsPerFlow == SEARCH_PATHS_PER_FLOW ? ", as in fitpath" : ", not the candidates of fitpath");
+	printf("Simulated %lu of %ld combinations (%lu subtrees pruned)\n", search.simulations, combinations, search.pruned);
+	printf("Best path set in this space has cost %.6f and is:\n", search.incumbent);
+	for (f = 0; f < numberOfFlows; f++) {
+
+		candidate = search.candidates[f][search.bestChoice[f]];
+		for (j = 0; j < arrayLength(candidate); j++) {
+
+			printf("%lu ", (unsigned long) arrayGet(candidate, j));
 		}
 		printf("\n");
 	}
@@ -208,19 +371,35 @@ for (i = 0; i < arrayLength(currentPaths); i++) {
 	 * Free everything.
 	 */
 
-	arrayFree(bestPaths);
-	free(bestPaths);
+	pthread_mutex_destroy(& search.lock);
+	free(threads);
+
+	for (f = 0; f < numberOfFlows; f++) {
+
+		free(search.candidates[f]);
+		free(search.candidateBounds[f]);
+	}
+	free(search.candidates);
+	free(search.candidateBounds);
+	free(search.numberOfCandidates);
+	free(search.freeBound);
+	free(search.bestChoice);
+
 	arrayFree(currentPaths);
 	free(currentPaths);
+	arrayFree(search.flowTimes);
+	free(search.flowTimes);
+	arrayFree(search.txDurations);
+	free(search.txDurations);
 
+	listFreeWithData(flt);
+	free(flt);
 	listFreeWithData(dst);
 	free(dst);
 	listFreeWithData(src);
 	free(src);
-	graphFree(graph);
-	free(graph);
 
-	for (i = 0; i < numberOfPairs; i++) {
+	for (i = 0; i < numberOfFlows; i++) {
 
 		pathList = arrayGet(nodePairs, i);
 		for (path = listBegin(pathList); path; path = listNext(pathList)) prefixTreePrune(path);
@@ -231,6 +410,8 @@ for (i = 0; i < arrayLength(currentPaths); i++) {
 	arrayFree(nodePairs);
 	free(nodePairs);
 
+	graphFree(graph);
+	free(graph);
+
 	return(0);
 }
-
@@ -0,0 +1,75 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "parser.h"
+#include "graph.h"
+#include "list.h"
+#include "smallVec.h"
+
+void printIntList(char * name, t_list * list) {
+
+	int * value;
+
+	printf("%s", name);
+	for (value = listBegin(list); value; value = listNext(list)) printf(" %d", * value);
+	printf("\n");
+}
+
+/*
+ * Print what the parser read from a file: the flows (or, with -p, the
+ * paths, as parserParsePaths reads them), then every link of the graph
+ * with its cost and the neighbors of every node in their order.
+ * check.sh compares it with tests/parserDump.out on the files under
+ * data/.
+ */
+int main(int argc, char ** argv) {
+
+	t_graph * graph;
+	t_list * first, * second, * third, * path;
+	t_smallVec * neighbors;
+	int * neighbor;
+	int paths, numberOfNodes, i, j;
+
+	paths = argc == 3 && !strcmp(argv[1], "-p");
+	if (argc != 2 + paths) {
+
+		fprintf(stderr, "Use: %s [-p] <input>\n", argv[0]);
+		exit(1);
+	}
+
+	if (paths) {
+
+		graph = parserParsePaths(argv[2], & first, & second, & third);
+		for (path = listBegin(first); path; path = listNext(first)) printIntList("Path", path);
+		printIntList("FlowTime", second);
+		printIntList("TxDuration", third);
+	}
+	else {
+
+		graph = parserParse(argv[1], & first, & second, & third);
+		printIntList("Source", first);
+		printIntList("Destination", second);
+		printIntList("FlowTime", third);
+	}
+
+	numberOfNodes = graphSize(graph);
+	printf("Nodes %d\n", numberOfNodes);
+	for (i = 0; i < numberOfNodes; i++) {
+
+		for (j = 0; j < numberOfNodes; j++) {
+
+			if (graphGetCost(graph, i, j) != GRAPH_INFINITY) printf("Link %d %d " WEIGHT_FORMAT "\n", i, j, graphGetCost(graph, i, j));
+		}
+	}
+
+	for (i = 0; i < numberOfNodes; i++) {
+
+		neighbors = graphGetNeighbors(graph, i);
+		printf("Neighbors %d", i);
+		for (neighbor = smallVecBegin(neighbors); neighbor < smallVecEnd(neighbors); neighbor++) printf(" %d", * neighbor);
+		printf("\n");
+	}
+
+	return(0);
+}
@@ -0,0 +1,63 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "resultFile.h"
+
+/*
+ * Print a result file written by fitpath -o as tab separated text:
+ * one line per flow of each incumbent, with the simulations and CPU
+ * time until it was found, its cost and delay, the rate, delay and
+ * loss of the flow and its path.
+ */
+int main(int argc, char ** argv) {
+
+	t_resultReader * reader;
+	t_resultBlock * block;
+	uint16_t * path;
+	uint32_t flows, row, flow, record = 0;
+	int length, j, a;
+
+	if (argc < 2) {
+
+		fprintf(stderr, "Use: %s <results> [results...]\n", argv[0]);
+		exit(1);
+	}
+
+	printf("file\tnodes\tinstance\treference\trecord\tsimulation\ttime\tcost\tdelay\tflow\trate\tflowDelay\tloss\tpath\n");
+	for (a = 1; a < argc; a++) {
+
+		reader = resultReaderOpen(argv[a]);
+		if (!reader) {
+
+			fprintf(stderr, "%s is not a result file\n", argv[a]);
+			exit(1);
+		}
+
+		flows = reader->header.numberOfFlows;
+		block = & reader->block;
+		record = 0;
+		while (resultReaderNextBlock(reader)) {
+
+			for (row = 0; row < block->rows; row++, record++) {
+
+				for (flow = 0; flow < flows; flow++) {
+
+					printf("%s\t%d\t%d\t%d\t%u\t%u\t%.0f\t%f\t%f\t%u\t%.2f\t%.2f\t%f\t", argv[a],
+						reader->header.nodes, reader->header.instance, reader->header.reference,
+						record, block->simulation[row], block->time[row], block->cost[row], block->delay[row], flow,
+						block->rate[flow * block->rows + row], block->flowDelay[flow * block->rows + row], block->loss[flow * block->rows + row]);
+
+					path = resultBlockPath(block, flows, row, flow, & length);
+					for (j = 0; j < length; j++) printf(j ? " %u" : "%u", path[j]);
+					printf("\n");
+				}
+			}
+		}
+
+		resultReaderClose(reader);
+		free(reader);
+	}
+
+	return(0);
+}
@@ -0,0 +1,69 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "surrogate.h"
+
+/*
+ * Fit a surrogate cost model to a log written by fitpath -l and
+ * report its error over the same log.
+ */
+int main(int argc, char ** argv) {
+
+	t_surrogate * surrogate;
+	FILE * log;
+	double features[SURROGATE_FEATURES], error, squaredError;
+	unsigned long numberOfSamples, i;
+	float cost, delay;
+
+	if (argc != 3) {
+
+		fprintf(stderr, "Use: %s <log> <model>\n", argv[0]);
+		exit(1);
+	}
+
+	log = fopen(argv[1], "rb");
+	if (!log) {
+
+		fprintf(stderr, "Could not open %s\n", argv[1]);
+		exit(1);
+	}
+
+	surrogate = surrogateTrain(log, & numberOfSamples);
+	if (!surrogate || numberOfSamples == 0) {
+
+		fprintf(stderr, "%s is not a valid log or has no samples\n", argv[1]);
+		exit(1);
+	}
+
+	/*
+	 * Measure the fit over the same log.
+	 */
+	rewind(log);
+	surrogateLogHeader(log);
+	squaredError = 0;
+	i = 0;
+	while (surrogateLogRead(log, features, & cost, & delay)) {
+
+		if (!isfinite(cost)) continue ;
+
+		error = surrogatePredict(surrogate, features) - cost;
+		squaredError += error * error;
+		i++;
+	}
+	fclose(log);
+
+	printf("%lu samples, RMSE %.4f\n", numberOfSamples, sqrt(squaredError / i));
+	for (i = 0; i < SURROGATE_FEATURES; i++) printf("w%lu = %g\n", i, surrogate->weights[i]);
+
+	if (!surrogateSave(surrogate, argv[2])) {
+
+		fprintf(stderr, "Could not write %s\n", argv[2]);
+		exit(1);
+	}
+
+	free(surrogate);
+
+	return(0);
+}
+
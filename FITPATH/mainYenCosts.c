@@ -0,0 +1,66 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "parser.h"
+#include "graph.h"
+#include "list.h"
+#include "prefixTree.h"
+#include "yen.h"
+
+/*
+ * Print the costs of the paths yen() finds for each flow of an input,
+ * in the order it finds them. check.sh compares them with
+ * tests/yenCosts.out. Paths of equal cost may come out in another
+ * order, the costs may not.
+ */
+int main(int argc, char ** argv) {
+
+	t_graph * graph;
+	t_list * src, * dst, * flt, * paths;
+	t_prefixTreeNode * path;
+	int * source, * destination;
+	int numberOfPaths = 100;
+	int c, flow = 0;
+
+	while ((c = getopt(argc, argv, "k:")) != -1) {
+
+		switch(c) {
+
+			case 'k':
+				/*
+				 * Paths per flow (100, as fitpath).
+				 */
+				numberOfPaths = atoi(optarg);
+				break ;
+
+			default:
+				fprintf(stderr, "Use: %s [-k paths] <input>\n", argv[0]);
+				exit(1);
+		}
+	}
+
+	if (argc - optind != 1) {
+
+		fprintf(stderr, "Use: %s [-k paths] <input>\n", argv[0]);
+		exit(1);
+	}
+
+	graph = parserParse(argv[optind], & src, & dst, & flt);
+
+	source = listBegin(src);
+	destination = listBegin(dst);
+	while(source && destination) {
+
+		paths = yen(graph, * source, * destination, numberOfPaths);
+
+		printf("Flow %d %d %d:", flow++, * source, * destination);
+		for (path = listBegin(paths); path; path = listNext(paths)) printf(" " WEIGHT_FORMAT, prefixTreeGetCost(path));
+		printf("\n");
+
+		source = listNext(src);
+		destination = listNext(dst);
+	}
+
+	return(0);
+}
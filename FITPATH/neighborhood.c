@@ -0,0 +1,176 @@
+#include <string.h>
+
+#include "neighborhood.h"
+#include "memory.h"
+
+#define FINGERPRINT_MIX(h, w) do {\
+							h ^= (uint64_t) (w);\
+							h *= 0x9E3779B97F4A7C15ull;\
+							h ^= h >> 29;\
+						} while(0)
+
+#define VISITED_INITIAL_SIZE	1024
+
+/*
+ * Key of a path used by flow i. The fingerprint of a path set is the
+ * XOR of the keys of its flows, so a step of the walk updates it for
+ * the swapped flow only.
+ */
+static uint64_t neighborhoodPathKey(t_array * path, int i) {
+
+	uint64_t h = 0xCBF29CE484222325ull;
+	int j;
+
+	FINGERPRINT_MIX(h, i);
+	for (j = 0; j < arrayLength(path); j++) FINGERPRINT_MIX(h, (long) arrayGet(path, j));
+	FINGERPRINT_MIX(h, arrayLength(path));
+
+	return(h);
+}
+
+uint64_t neighborhoodFingerprint(t_array * paths) {
+
+	uint64_t fingerprint = 0;
+	int i;
+
+	for (i = 0; i < arrayLength(paths); i++) fingerprint ^= neighborhoodPathKey(arrayGet(paths, i), i);
+
+	return(fingerprint);
+}
+
+/*
+ * Start the walk at the mix of currentPaths only, which is not
+ * visited. paths receives each mix in turn.
+ */
+void neighborhoodBegin(t_neighborhood * neighborhood, t_array * currentPaths, t_array * neighborPaths, t_array * paths) {
+
+	int i;
+
+	neighborhood->currentPaths = currentPaths;
+	neighborhood->neighborPaths = neighborPaths;
+	neighborhood->paths = paths;
+	neighborhood->numberOfPaths = arrayLength(currentPaths);
+	neighborhood->step = 0;
+	neighborhood->mask = 0;
+	neighborhood->flow = -1;
+
+	MALLOC(neighborhood->currentKeys, sizeof(uint64_t) * neighborhood->numberOfPaths);
+	MALLOC(neighborhood->neighborKeys, sizeof(uint64_t) * neighborhood->numberOfPaths);
+	neighborhood->fingerprint = 0;
+
+	for (i = 0; i < neighborhood->numberOfPaths; i++) {
+
+		neighborhood->currentKeys[i] = neighborhoodPathKey(arrayGet(currentPaths, i), i);
+		neighborhood->neighborKeys[i] = neighborhoodPathKey(arrayGet(neighborPaths, i), i);
+		neighborhood->fingerprint ^= neighborhood->currentKeys[i];
+		arraySet(paths, i, arrayGet(currentPaths, i));
+	}
+}
+
+/*
+ * Move to the next mix. Step k swaps the flow given by the lowest
+ * set bit of k. Returns 0 once all 2^n - 1 mixes have been visited.
+ */
+int neighborhoodNext(t_neighborhood * neighborhood) {
+
+	int flow;
+
+	neighborhood->step++;
+	if (neighborhood->step >= (1UL << neighborhood->numberOfPaths)) return(0);
+
+	flow = __builtin_ctzl(neighborhood->step);
+	neighborhood->mask ^= 1UL << flow;
+	neighborhood->flow = flow;
+	neighborhood->fingerprint ^= neighborhood->currentKeys[flow] ^ neighborhood->neighborKeys[flow];
+
+	if (neighborhood->mask & (1UL << flow)) arraySet(neighborhood->paths, flow, arrayGet(neighborhood->neighborPaths, flow));
+	else arraySet(neighborhood->paths, flow, arrayGet(neighborhood->currentPaths, flow));
+
+	return(1);
+}
+
+void neighborhoodFree(t_neighborhood * neighborhood) {
+
+	free(neighborhood->currentKeys);
+	free(neighborhood->neighborKeys);
+}
+
+t_visited * visitedNew(void) {
+
+	t_visited * visited;
+
+	MALLOC(visited, sizeof(t_visited));
+	visited->size = VISITED_INITIAL_SIZE;
+	visited->numberOfEntries = 0;
+	visited->hits = 0;
+	MALLOC(visited->fingerprints, sizeof(uint64_t) * visited->size);
+	memset(visited->fingerprints, 0, sizeof(uint64_t) * visited->size);
+
+	return(visited);
+}
+
+/*
+ * Slot of fingerprint: either the slot holding it or the empty
+ * slot where it would be inserted (linear probing).
+ */
+static unsigned long visitedSlot(t_visited * visited, uint64_t fingerprint) {
+
+	unsigned long slot;
+
+	slot = (fingerprint ^ (fingerprint >> 32)) & (visited->size - 1);
+	while (visited->fingerprints[slot] && visited->fingerprints[slot] != fingerprint)
+		slot = (slot + 1) & (visited->size - 1);
+
+	return(slot);
+}
+
+int visitedContains(t_visited * visited, uint64_t fingerprint) {
+
+	if (!fingerprint) fingerprint = 1;
+
+	return(visited->fingerprints[visitedSlot(visited, fingerprint)] == fingerprint);
+}
+
+/*
+ * Returns 1 if fingerprint was already in the set. Otherwise adds it
+ * and returns 0. The table doubles when it gets half full.
+ */
+int visitedCheckAndAdd(t_visited * visited, uint64_t fingerprint) {
+
+	uint64_t * old;
+	unsigned long slot, oldSize, i;
+
+	if (!fingerprint) fingerprint = 1;
+
+	slot = visitedSlot(visited, fingerprint);
+	if (visited->fingerprints[slot] == fingerprint) {
+
+		visited->hits++;
+		return(1);
+	}
+
+	visited->fingerprints[slot] = fingerprint;
+	visited->numberOfEntries++;
+
+	if (2 * visited->numberOfEntries > visited->size) {
+
+		old = visited->fingerprints;
+		oldSize = visited->size;
+		visited->size *= 2;
+		MALLOC(visited->fingerprints, sizeof(uint64_t) * visited->size);
+		memset(visited->fingerprints, 0, sizeof(uint64_t) * visited->size);
+		for (i = 0; i < oldSize; i++) {
+
+			if (old[i]) visited->fingerprints[visitedSlot(visited, old[i])] = old[i];
+		}
+		free(old);
+	}
+
+	return(0);
+}
+
+void visitedFree(t_visited * visited) {
+
+	free(visited->fingerprints);
+}
+
@@ -0,0 +1,52 @@
+#ifndef __NEIGHBORHOOD_H__
+#define __NEIGHBORHOOD_H__
+
+#include <stdint.h>
+
+#include "array.h"
+
+/*
+ * Walk over the mixes of two path sets: each flow takes its path
+ * either from currentPaths or from neighborPaths. Mixes are visited
+ * in Gray-code order, so each step swaps the path of a single flow
+ * and the fingerprint is updated for that flow only.
+ */
+typedef struct {
+
+	t_array * currentPaths;
+	t_array * neighborPaths;
+	t_array * paths;			// The mix being visited.
+	int numberOfPaths;
+	unsigned long step;
+	unsigned long mask;			// Flows taking their path from neighborPaths.
+	int flow;					// Flow swapped by the last step.
+	uint64_t * currentKeys;
+	uint64_t * neighborKeys;
+	uint64_t fingerprint;		// Fingerprint of the mix (see neighborhoodFingerprint).
+} t_neighborhood;
+
+/*
+ * Path sets already evaluated during a run, as 64-bit fingerprints
+ * in an open-addressing hash table. Two path sets with the same
+ * fingerprint are taken as equal.
+ */
+typedef struct {
+
+	uint64_t * fingerprints;	// 0 marks an empty slot.
+	unsigned long size;			// Always a power of two.
+	unsigned long numberOfEntries;
+	unsigned long hits;
+} t_visited;
+
+void neighborhoodBegin(t_neighborhood * neighborhood, t_array * currentPaths, t_array * neighborPaths, t_array * paths);
+int neighborhoodNext(t_neighborhood * neighborhood);
+void neighborhoodFree(t_neighborhood * neighborhood);
+uint64_t neighborhoodFingerprint(t_array * paths);
+
+t_visited * visitedNew(void);
+int visitedContains(t_visited * visited, uint64_t fingerprint);
+int visitedCheckAndAdd(t_visited * visited, uint64_t fingerprint);
+void visitedFree(t_visited * visited);
+
+#endif
+
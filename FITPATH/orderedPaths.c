@@ -9,7 +9,7 @@
 t_list * pathsBuild(t_graph * graph, int src, int dst) {
 
 	t_stack * stack;
-	t_list * listOfNeighbors;
+	t_smallVec * listOfNeighbors;
 	t_list * outputPaths;
 	t_floatHeap * intermediateOutput;
 	t_prefixTreeNode * prefix, * newPrefix;
@@ -21,7 +21,7 @@ t_list * pathsBuild(t_graph * graph, int src, int dst) {
 	prefix = prefixTreeNew(src);
 
 	listOfNeighbors = graphGetNeighbors(graph, src);
-	for (neighbor = listBegin(listOfNeighbors); neighbor; neighbor = listNext(listOfNeighbors)) {
+	for (neighbor = smallVecBegin(listOfNeighbors); neighbor < smallVecEnd(listOfNeighbors); neighbor++) {
 
 		newPrefix = prefixTreeAppend(prefix, * neighbor, graphGetCost(graph, src, * neighbor));
 
@@ -40,7 +40,7 @@ t_list * pathsBuild(t_graph * graph, int src, int dst) {
 		prefix = stackPop(stack);
 		currentNode = prefixTreeGetNode(prefix);
 		listOfNeighbors = graphGetNeighbors(graph, currentNode);
-		for (neighbor = listBegin(listOfNeighbors); neighbor; neighbor = listNext(listOfNeighbors)) {
+		for (neighbor = smallVecBegin(listOfNeighbors); neighbor < smallVecEnd(listOfNeighbors); neighbor++) {
 
 			if (prefixTreeNodeExists(prefix, * neighbor)) continue ;
 
@@ -0,0 +1,120 @@
+#include <stdlib.h>
+
+#include "pareto.h"
+#include "memory.h"
+
+#define PARETO_INITIAL_SIZE		16
+
+/*
+ * Whether a is no worse than b in every objective.
+ */
+static int paretoCovers(t_paretoSolution * a, float cost, float delay, float maxLoss) {
+
+	return(a->cost <= cost && a->delay <= delay && a->maxLoss <= maxLoss);
+}
+
+t_pareto * paretoNew(void) {
+
+	t_pareto * pareto;
+
+	MALLOC(pareto, sizeof(t_pareto));
+	MALLOC(pareto->solutions, sizeof(t_paretoSolution) * PARETO_INITIAL_SIZE);
+	pareto->numberOfSolutions = 0;
+	pareto->size = PARETO_INITIAL_SIZE;
+	pareto->offered = 0;
+
+	return(pareto);
+}
+
+/*
+ * Add a path set to the archive unless an archived solution is no
+ * worse in every objective, and drop the archived solutions it
+ * dominates. Returns 1 if the path set was added.
+ */
+int paretoOffer(t_pareto * pareto, t_array * paths, float cost, float delay, float maxLoss) {
+
+	t_paretoSolution * solution;
+	int i, kept;
+
+	pareto->offered++;
+
+	for (i = 0; i < pareto->numberOfSolutions; i++) {
+
+		if (paretoCovers(& pareto->solutions[i], cost, delay, maxLoss)) return(0);
+	}
+
+	kept = 0;
+	for (i = 0; i < pareto->numberOfSolutions; i++) {
+
+		solution = & pareto->solutions[i];
+		if (solution->cost >= cost && solution->delay >= delay && solution->maxLoss >= maxLoss) {
+
+			arrayFree(solution->paths);
+			free(solution->paths);
+			continue ;
+		}
+		pareto->solutions[kept++] = * solution;
+	}
+	pareto->numberOfSolutions = kept;
+
+	if (pareto->numberOfSolutions == pareto->size) {
+
+		pareto->size *= 2;
+		REALLOC(pareto->solutions, sizeof(t_paretoSolution) * pareto->size);
+	}
+
+	solution = & pareto->solutions[pareto->numberOfSolutions++];
+	solution->cost = cost;
+	solution->delay = delay;
+	solution->maxLoss = maxLoss;
+	solution->paths = arrayNew(arrayLength(paths));
+	for (i = 0; i < arrayLength(paths); i++) arraySet(solution->paths, i, arrayGet(paths, i));
+
+	return(1);
+}
+
+static int paretoCompare(const void * a, const void * b) {
+
+	const t_paretoSolution * s1 = a, * s2 = b;
+
+	if (s1->cost < s2->cost) return(-1);
+	if (s1->cost > s2->cost) return(1);
+	if (s1->delay < s2->delay) return(-1);
+	if (s1->delay > s2->delay) return(1);
+	return(0);
+}
+
+/*
+ * Print the archive sorted by cost: one header line per solution
+ * followed by the nodes of the path of each flow, one flow per line.
+ */
+void paretoPrint(FILE * stream, t_pareto * pareto) {
+
+	t_array * path;
+	int i, j, k;
+
+	qsort(pareto->solutions, pareto->numberOfSolutions, sizeof(t_paretoSolution), paretoCompare);
+
+	fprintf(stream, "Pareto front %d solutions (%lu offered)\n", pareto->numberOfSolutions, pareto->offered);
+	for (i = 0; i < pareto->numberOfSolutions; i++) {
+
+		fprintf(stream, "Pareto %d cost %f delay %f maxLoss %f\n", i, pareto->solutions[i].cost,
+			pareto->solutions[i].delay, pareto->solutions[i].maxLoss);
+		for (j = 0; j < arrayLength(pareto->solutions[i].paths); j++) {
+
+			path = arrayGet(pareto->solutions[i].paths, j);
+			for (k = 0; k < arrayLength(path); k++) fprintf(stream, "%lu ", (unsigned long) arrayGet(path, k));
+			fprintf(stream, "\n");
+		}
+	}
+}
+
+void paretoFree(t_pareto * pareto) {
+
+	for (int i = 0; i < pareto->numberOfSolutions; i++) {
+
+		arrayFree(pareto->solutions[i].paths);
+		free(pareto->solutions[i].paths);
+	}
+	free(pareto->solutions);
+}
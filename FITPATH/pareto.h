@@ -0,0 +1,35 @@
+#ifndef __PARETO_H__
+#define __PARETO_H__
+
+#include <stdio.h>
+
+#include "array.h"
+
+/*
+ * Archive of the non-dominated path sets seen during a search, under
+ * cost, mean delay and the largest packet loss of a single flow, all
+ * three minimised. A solution dominates another when it is no worse
+ * in every objective and better in at least one.
+ */
+typedef struct {
+
+	float cost;
+	float delay;
+	float maxLoss;
+	t_array * paths;			// Own copy of the path set (paths are shared).
+} t_paretoSolution;
+
+typedef struct {
+
+	t_paretoSolution * solutions;
+	int numberOfSolutions;
+	int size;
+	unsigned long offered;
+} t_pareto;
+
+t_pareto * paretoNew(void);
+int paretoOffer(t_pareto * pareto, t_array * paths, float cost, float delay, float maxLoss);
+void paretoPrint(FILE * stream, t_pareto * pareto);
+void paretoFree(t_pareto * pareto);
+
+#endif
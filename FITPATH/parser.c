@@ -1,19 +1,31 @@
+#define _XOPEN_SOURCE 700
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
 #include <string.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #include "parser.h"
 #include "graph.h"
 #include "list.h"
 #include "memory.h"
 
+/*
+ * Both input formats are read by the same tokenizer, straight from
+ * the file mapped in memory. All the state of a parse is kept in a
+ * t_parser, so several files can be parsed at the same time.
+ */
+
 typedef enum {
 
 	TOKEN_LINKS_KEYWORD,
 	TOKEN_SOURCE_KEYWORD,
 	TOKEN_DEST_KEYWORD,
 	TOKEN_FLOWTIME_KEYWORD,
+	TOKEN_PATHS_KEYWORD,
+	TOKEN_END_PATH,
 	TOKEN_INTEGER,
 	TOKEN_REAL,
 	TOKEN_EOF,
@@ -25,482 +37,456 @@ typedef enum {
 #define IS_DOT(ch) (ch == '.')
 #define IS_LETTER(ch) ((ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z'))
 #define IS_LINEBREAK(ch) (ch == '\n')
-#define IS_BLANK(ch) (ch == ' ' || ch == '\t')
+#define IS_BLANK(ch) (ch == ' ' || ch == '\t' || ch == '\r')
 #define IS_COMMENT(ch) (ch == '#')
-#define IS_EOF(ch) (ch == EOF)
+#define IS_INTERROGATION(ch) (ch == '?')
 
-int currLine = 1;
+#define MAX_EXACT_DIGITS	15		// Below 2^53: exact as a double.
 
-t_token parserNextToken(FILE * in, char ** secToken) {
+typedef struct {
 
-	char ch;
-	int state;
-	static char usefullString[1024];
-	int usefullLength;
+	char * data;
+	size_t size;
+	int mapped;
+	const char * p;
+	const char * end;
+	int line;
 
-	usefullLength = 0;
-	usefullString[0] = 0;
-	* secToken = usefullString;
-	state = 0;
-	while(1) {
+	long integer;			// Value of the last TOKEN_INTEGER.
+	double real;			// Value of the last TOKEN_INTEGER or TOKEN_REAL.
+} t_parser;
 
-		ch = fgetc(in);
+typedef struct {
 
-		if (IS_LINEBREAK(ch)) currLine++;
+	int head;
+	int tail;
+	float weight;
+} t_parsedLink;
 
-		switch(state) {
+typedef struct {
 
-			case 0:
+	t_parsedLink * links;
+	int numberOfLinks;
+	int size;
+	int numberOfNodes;
+} t_parsedLinks;
 
-				if (IS_DIGIT(ch) || IS_DOT(ch)) {
+static const double powersOf10[] = {
 
-					state = 1;
-					usefullString[0] = ch;
-					usefullString[1] = 0;
-					usefullLength = 1;
-					break ;
-				}
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
 
-				if (IS_LETTER(ch)) {
+/*
+ * Read a file that is not mapped (a pipe, an empty file or a failed
+ * mmap) to its end, into a buffer that doubles as it fills.
+ */
+static void parserRead(t_parser * parser, int fd, char * filename) {
 
-					state = 2;
-					usefullString[0] = ch;
-					usefullString[1] = 0;
-					usefullLength = 1;
-					break ;
-				}
+	size_t capacity = 65536;
+	ssize_t n;
 
-				if (IS_COMMENT(ch)) {
+	MALLOC(parser->data, capacity);
+	parser->size = 0;
+	while ((n = read(fd, parser->data + parser->size, capacity - parser->size)) != 0) {
 
-					state = 3;
-					break ;
-				}
+		if (n < 0) {
 
-				if (IS_BLANK(ch) || IS_LINEBREAK(ch)) {
+			fprintf(stderr, "Failed to open file '%s' for reading.\n", filename);
+			exit(-1);
+		}
 
-					break ;
-				}
+		parser->size += n;
+		if (parser->size == capacity) {
 
-				if (IS_EOF(ch)) {
+			capacity *= 2;
+			REALLOC(parser->data, capacity);
+		}
+	}
+}
 
-					return(TOKEN_EOF);
-				}
+static void parserOpen(t_parser * parser, char * filename) {
 
-				return(TOKEN_ERROR);
-			
-			case 1:
-	
-				if (IS_DIGIT(ch)) {
+	struct stat st;
+	int fd;
 
-					usefullString[usefullLength] = ch;
-					usefullLength++;
-					usefullString[usefullLength] = 0;
-					break;
-				}
+	if ((fd = open(filename, O_RDONLY)) < 0 || fstat(fd, & st) < 0) {
 
-				if (IS_DOT(ch)) {
+		fprintf(stderr, "Failed to open file '%s' for reading.\n", filename);
+		exit(-1);
+	}
 
-					usefullString[usefullLength] = ch;
-					usefullLength++;
-					usefullString[usefullLength] = 0;
-					state = 4;
-					break;
-				}
+	parser->size = 0;
+	parser->mapped = 0;
+	parser->data = NULL;
+	if (S_ISREG(st.st_mode) && st.st_size > 0) {
 
-				if (IS_LETTER(ch) || IS_COMMENT(ch) || IS_BLANK(ch) || IS_LINEBREAK(ch) || IS_EOF(ch)) {
+		parser->data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (parser->data != MAP_FAILED) {
 
-					ungetc(ch, in);
-					if (IS_LINEBREAK(ch)) currLine--;
-					return(TOKEN_INTEGER);
-				}
-
-				return(TOKEN_ERROR);
+			parser->size = st.st_size;
+			parser->mapped = 1;
+		}
+	}
+	if (!parser->mapped) parserRead(parser, fd, filename);
+	close(fd);
 
-			case 2:
+	parser->p = parser->data;
+	parser->end = parser->data + parser->size;
+	parser->line = 1;
+}
 
-				if (IS_LETTER(ch)) {
+static void parserClose(t_parser * parser) {
 
-					usefullString[usefullLength] = ch;
-					usefullLength++;
-					usefullString[usefullLength] = 0;
-					break ;
-				}
+	if (parser->mapped) munmap(parser->data, parser->size);
+	else free(parser->data);
+}
 
-				if (IS_DIGIT(ch) || IS_COMMENT(ch) || IS_BLANK(ch) || IS_LINEBREAK(ch) || IS_EOF(ch)) {
+/*
+ * Value of the number in [start, p), with fracDigits digits after the
+ * dot. Up to MAX_EXACT_DIGITS digits, the integer of all digits and
+ * the power of ten are exact doubles, so their quotient is correctly
+ * rounded, as strtod would give.
+ */
+static double parserReal(const char * start, const char * p, unsigned long mantissa, int digits, int fracDigits) {
 
-					ungetc(ch, in);
-					if (IS_LINEBREAK(ch)) currLine--;
-					if (!strcmp(usefullString, "Links")) return(TOKEN_LINKS_KEYWORD);
-					if (!strcmp(usefullString, "Source")) return(TOKEN_SOURCE_KEYWORD);
-					if (!strcmp(usefullString, "Destination")) return(TOKEN_DEST_KEYWORD);
-					if (!strcmp(usefullString, "FlowTime")) return(TOKEN_FLOWTIME_KEYWORD);
+	char buffer[64];
+	size_t length = p - start;
 
-					return(TOKEN_ERROR);
-				}
+	if (digits <= MAX_EXACT_DIGITS) return(mantissa / powersOf10[fracDigits]);
 
-			case 3:
+	if (length >= sizeof(buffer)) length = sizeof(buffer) - 1;
+	memcpy(buffer, start, length);
+	buffer[length] = 0;
 
-				if (IS_LINEBREAK(ch) || IS_EOF(ch)) {
+	return(strtod(buffer, NULL));
+}
 
-					state = 0;
-					break ;
-				}
+static t_token parserNextToken(t_parser * parser) {
 
-				break ;
+	const char * p = parser->p, * end = parser->end, * start;
+	unsigned long mantissa;
+	int digits, fracDigits;
+	size_t length;
 
-			case 4:
-			
-				if (IS_DIGIT(ch)) {
+	while (1) {
 
-					usefullString[usefullLength] = ch;
-					usefullLength++;
-					usefullString[usefullLength] = 0;
-					break;
-				}
+		while (p < end && (IS_BLANK(* p) || IS_LINEBREAK(* p))) {
 
-				if (IS_DOT(ch) || IS_LETTER(ch) || IS_COMMENT(ch) || IS_BLANK(ch) || IS_LINEBREAK(ch) || IS_EOF(ch)) {
+			if (IS_LINEBREAK(* p)) parser->line++;
+			p++;
+		}
 
-					ungetc(ch, in);
-					if (IS_LINEBREAK(ch)) currLine--;
-					return(TOKEN_REAL);
-				}
+		if (p < end && IS_COMMENT(* p)) {
 
-				return(TOKEN_ERROR);
+			while (p < end && !IS_LINEBREAK(* p)) p++;
+			continue ;
 		}
-	}
-}
-
-t_graph * parserParse(char * filename, t_list ** src, t_list ** dst, t_list ** flt) {
 
-	int state;
-	char * secToken = NULL;
-	t_token t;
-	FILE * in;
-	int end = 0;
-	int n_nodes = 0;
-	int * sourceNode, * destNode, *flowTime;
-	struct {
-
-		int linkHead;
-		int linkTail;
-		float linkWeight;
-	} link, * newLink;
-	t_list * links;
-	t_graph * graph;
+		break ;
+	}
 
-	* src = listNew();
-	* dst = listNew();
-	* flt = listNew();
+	if (p == end) {
 
-	if ((in = fopen(filename, "r")) == 0) {
-		
-		fprintf(stderr, "Failed to open file '%s' for reading.\n", filename);
-		exit(-1);
+		parser->p = p;
+		return(TOKEN_EOF);
 	}
 
-	links = listNew();
-	state = 0;
+	start = p;
 
-	while(!end) {
+	if (IS_DIGIT(* p) || IS_DOT(* p)) {
 
-		t = parserNextToken(in, & secToken);
+		mantissa = 0;
+		digits = 0;
+		while (p < end && IS_DIGIT(* p)) {
 
-		switch(state) {
-
-			case 0:
+			mantissa = mantissa * 10 + (* p - '0');
+			digits++;
+			p++;
+		}
 
-				if (t == TOKEN_LINKS_KEYWORD) {
+		parser->integer = (long) mantissa;
+		if (p == end || !IS_DOT(* p)) {
 
-					state = 1;
-					break ;
-				}
+			parser->p = p;
+			parser->real = digits <= MAX_EXACT_DIGITS ? (double) mantissa : parserReal(start, p, mantissa, digits, 0);
+			return(TOKEN_INTEGER);
+		}
 
-				if (t == TOKEN_DEST_KEYWORD) {
+		p++;
+		fracDigits = 0;
+		while (p < end && IS_DIGIT(* p)) {
 
-					state = 2;
-					break ;
+			mantissa = mantissa * 10 + (* p - '0');
+			digits++;
+			fracDigits++;
+			p++;
+		}
 
-				}
+		parser->p = p;
+		parser->real = parserReal(start, p, mantissa, digits, fracDigits);
+		return(TOKEN_REAL);
+	}
 
-				if (t == TOKEN_SOURCE_KEYWORD) {
+	if (IS_LETTER(* p)) {
 
-					state = 3;
-					break ;
-				}
-				
-				if (t == TOKEN_FLOWTIME_KEYWORD) {
+		while (p < end && IS_LETTER(* p)) p++;
+		parser->p = p;
+		length = p - start;
 
-					state = 6;
-					break ;
-				}
+		if (length == 5 && !memcmp(start, "Links", 5)) return(TOKEN_LINKS_KEYWORD);
+		if (length == 6 && !memcmp(start, "Source", 6)) return(TOKEN_SOURCE_KEYWORD);
+		if (length == 11 && !memcmp(start, "Destination", 11)) return(TOKEN_DEST_KEYWORD);
+		if (length == 8 && !memcmp(start, "FlowTime", 8)) return(TOKEN_FLOWTIME_KEYWORD);
+		if (length == 5 && !memcmp(start, "Paths", 5)) return(TOKEN_PATHS_KEYWORD);
 
-				if (t == TOKEN_EOF) {
+		return(TOKEN_ERROR);
+	}
 
-					end = 1;
-					break ;
-				}
+	parser->p = p + 1;
+	if (IS_INTERROGATION(* p)) return(TOKEN_END_PATH);
 
-				fclose(in);
-				fprintf(stderr, "Error at line %d: expected keyword or EOF.\n", currLine);
-				exit(-2);
+	return(TOKEN_ERROR);
+}
 
-			case 1:
-				
-				if (t == TOKEN_INTEGER) {
+static void parserError(t_parser * parser, char * message, int code) {
 
-					link.linkHead = atoi(secToken);
+	fprintf(stderr, "Error at line %d: %s\n", parser->line, message);
+	parserClose(parser);
+	exit(code);
+}
 
-					if (n_nodes <= link.linkHead) n_nodes = link.linkHead + 1;
+static void parserAddNode(t_list * list, long node) {
 
-					state = 4;
-					break ;
-				}
+	int * newNode;
 
-				if (t == TOKEN_DEST_KEYWORD) {
+	MALLOC(newNode, sizeof(int));
+	* newNode = node;
+	listAdd(list, newNode);
+}
 
-					state = 2;
-					break ;
+/*
+ * Read the destination and weight of a link whose source was just
+ * read.
+ */
+static void parserReadLink(t_parser * parser, t_parsedLinks * links) {
 
-				}
+	t_parsedLink * link;
+	t_token t;
 
-				if (t == TOKEN_SOURCE_KEYWORD) {
+	if (links->numberOfLinks == links->size) {
 
-					state = 3;
-					break ;
-				}
-				
-				if (t == TOKEN_FLOWTIME_KEYWORD) {
+		links->size = links->size ? 2 * links->size : 64;
+		REALLOC(links->links, links->size * sizeof(t_parsedLink));
+	}
+	link = & links->links[links->numberOfLinks];
 
-					state = 6;
-					break ;
-				}
+	link->head = parser->integer;
+	if (links->numberOfNodes <= link->head) links->numberOfNodes = link->head + 1;
 
-				if (t == TOKEN_EOF) {
+	if (parserNextToken(parser) != TOKEN_INTEGER) parserError(parser, "expected link destination.", -6);
+	link->tail = parser->integer;
+	if (links->numberOfNodes <= link->tail) links->numberOfNodes = link->tail + 1;
 
-					end = 1;
-					break ;
-				}
+	t = parserNextToken(parser);
+	if (t != TOKEN_INTEGER && t != TOKEN_REAL) parserError(parser, "expected link weight.", -7);
+	link->weight = parser->real;
 
-				fclose(in);
-				fprintf(stderr, "Error at line %d: expected link source, keyword or EOF.\n", currLine);
-				exit(-3);
+	links->numberOfLinks++;
+}
 
-			case 2:
+static t_graph * parserBuildGraph(t_parsedLinks * links) {
 
-				if (t == TOKEN_INTEGER) {
+	t_graph * graph;
+	int i;
 
-					MALLOC(destNode, sizeof(int));
-					* destNode = atoi(secToken);
-					listAdd(* dst, destNode);
-				
-					if (n_nodes <= * destNode) n_nodes = * destNode + 1;
+	graph = graphNew(links->numberOfNodes);
+	for (i = 0; i < links->numberOfLinks; i++) graphAddLink(graph, links->links[i].head, links->links[i].tail, links->links[i].weight);
+	free(links->links);
 
-					state = 2;
-					break ;
-				}
+	return(graph);
+}
 
-				if (t == TOKEN_LINKS_KEYWORD) {
+t_graph * parserParse(char * filename, t_list ** src, t_list ** dst, t_list ** flt) {
 
-					state = 1;
-					break ;
-				}
+	t_parser parser;
+	t_parsedLinks links = {NULL, 0, 0, 0};
+	t_token t, section = TOKEN_EOF;
+	int * flowTime;
 
-				if (t == TOKEN_DEST_KEYWORD) {
+	* src = listNew();
+	* dst = listNew();
+	* flt = listNew();
 
-					state = 2;
-					break ;
+	parserOpen(& parser, filename);
 
-				}
+	while ((t = parserNextToken(& parser)) != TOKEN_EOF) {
 
-				if (t == TOKEN_SOURCE_KEYWORD) {
+		if (t == TOKEN_LINKS_KEYWORD || t == TOKEN_SOURCE_KEYWORD || t == TOKEN_DEST_KEYWORD || t == TOKEN_FLOWTIME_KEYWORD) {
 
-					state = 3;
-					break ;
-				}
-				
-				if (t == TOKEN_FLOWTIME_KEYWORD) {
+			section = t;
+			continue ;
+		}
 
-					state = 6;
-					break ;
-				}
+		switch(section) {
 
-				if (t == TOKEN_EOF) {
+			case TOKEN_LINKS_KEYWORD:
 
-					end = 1;
-					break ;
-				}
+				if (t != TOKEN_INTEGER) parserError(& parser, "expected link source, keyword or EOF.", -3);
+				parserReadLink(& parser, & links);
+				break ;
 
-				fclose(in);
-				fprintf(stderr, "Error at line %d: expected node identifier, keyword or EOF.\n", currLine);
-				exit(-4);
+			case TOKEN_DEST_KEYWORD:
 
-			case 3:
+				if (t != TOKEN_INTEGER) parserError(& parser, "expected node identifier, keyword or EOF.", -4);
+				parserAddNode(* dst, parser.integer);
+				if (links.numberOfNodes <= parser.integer) links.numberOfNodes = parser.integer + 1;
+				break ;
 
-				if (t == TOKEN_INTEGER) {
+			case TOKEN_SOURCE_KEYWORD:
 
-					MALLOC(sourceNode, sizeof(int));
-					* sourceNode = atoi(secToken);
-					listAdd(* src, sourceNode);
+				if (t != TOKEN_INTEGER) parserError(& parser, "expected node identifier, keyword or EOF.", -5);
+				parserAddNode(* src, parser.integer);
+				if (links.numberOfNodes <= parser.integer) links.numberOfNodes = parser.integer + 1;
+				break ;
 
-					if (n_nodes <= * sourceNode) n_nodes = * sourceNode + 1;
+			case TOKEN_FLOWTIME_KEYWORD:
 
-					state = 3;
-					break ;
-				}
+				if (t != TOKEN_INTEGER) parserError(& parser, "expected flowTime identifier, keyword or EOF.", -8);
+				MALLOC(flowTime, sizeof(int));
+				* flowTime = parser.integer;
+				listAdd(* flt, flowTime);
+				break ;
 
-				if (t == TOKEN_LINKS_KEYWORD) {
+			default:
 
-					state = 1;
-					break ;
-				}
+				parserError(& parser, "expected keyword or EOF.", -2);
+		}
+	}
 
-				if (t == TOKEN_DEST_KEYWORD) {
+	parserClose(& parser);
 
-					state = 2;
-					break ;
+	if (listLength(* dst) != listLength(* src)) {
 
-				}
+		fprintf(stderr, "There must be the same number of sources and destinations!\n");
+		exit(-9);
+	}
 
-				if (t == TOKEN_SOURCE_KEYWORD) {
+	return(parserBuildGraph(& links));
+}
 
-					state = 3;
-					break ;
-				}
-				
-				if (t == TOKEN_FLOWTIME_KEYWORD) {
+/*
+ * Format of evaluateSinglePathSet: the links, then the keyword Paths
+ * and, for each flow, its nodes, a '?', its flow time and the
+ * transmission time of its frames.
+ */
+t_graph * parserParsePaths(char * filename, t_list ** paths, t_list ** flt, t_list ** ftx) {
 
-					state = 6;
-					break ;
-				}
+	t_parser parser;
+	t_parsedLinks links = {NULL, 0, 0, 0};
+	t_list * newPath = NULL;
+	t_token t;
+	int * flowTime, * txTime;
+	int state = 0;
 
-				if (t == TOKEN_EOF) {
+	* paths = listNew();
+	* flt = listNew();
+	* ftx = listNew();
 
-					end = 1;
-					break ;
-				}
+	parserOpen(& parser, filename);
 
-				fclose(in);
-				fprintf(stderr, "Error at line %d: expected node identifier, keyword or EOF.\n", currLine);
-				exit(-5);
+	while (1) {
 
-			case 4:
+		t = parserNextToken(& parser);
 
-				if (t == TOKEN_INTEGER) {
+		switch(state) {
 
-					link.linkTail = atoi(secToken);
+			case 0:		// Before any section, or after a path.
+			case 3:
 
-					if (n_nodes <= link.linkTail) n_nodes = link.linkTail + 1;
+				if (t == TOKEN_LINKS_KEYWORD) {
 
-					state = 5;
+					state = 1;
 					break ;
 				}
 
-				fclose(in);
-				fprintf(stderr, "Error at line %d: expected link destination.\n", currLine);
-				exit(-6);
-			
-			case 5:
-
-				if (t == TOKEN_INTEGER) {
+				if (t == TOKEN_PATHS_KEYWORD && state == 0) {
 
-					link.linkWeight = atoi(secToken);
-					MALLOC(newLink, sizeof(link));
-					* newLink = link;
-					listAdd(links, newLink);
-					state = 1;
+					newPath = listNew();
+					listAdd(* paths, newPath);
+					state = 2;
 					break ;
 				}
 
-				if (t == TOKEN_REAL) {
+				if (t == TOKEN_INTEGER && state == 3) {
 
-					link.linkWeight = atof(secToken);
-					MALLOC(newLink, sizeof(link));
-					* newLink = link;
-					listAdd(links, newLink);
-					state = 1;
+					newPath = listNew();
+					listAdd(* paths, newPath);
+					parserAddNode(newPath, parser.integer);
+					if (links.numberOfNodes <= parser.integer) links.numberOfNodes = parser.integer + 1;
+					state = 2;
 					break ;
 				}
 
-				fclose(in);
-				fprintf(stderr, "Error at line %d: expected link weight.\n", currLine);
-				exit(-7);
-			
-			case 6:
+				if (t == TOKEN_EOF) break ;
 
-				if (t == TOKEN_INTEGER) {
+				parserError(& parser, "expected keyword or EOF.", -2);
 
-					MALLOC(flowTime, sizeof(int));
-					* flowTime = atoi(secToken);
-					listAdd(* flt, flowTime);
+			case 1:		// Links.
 
-					//if (n_nodes <= * flowTime) n_nodes = * flowTime + 1;
+				if (t == TOKEN_INTEGER) {
 
-					state = 6;
+					parserReadLink(& parser, & links);
 					break ;
 				}
 
-				if (t == TOKEN_LINKS_KEYWORD) {
+				if (t == TOKEN_PATHS_KEYWORD) {
 
-					state = 1;
+					newPath = listNew();
+					listAdd(* paths, newPath);
+					state = 2;
 					break ;
 				}
 
-				if (t == TOKEN_DEST_KEYWORD) {
+				if (t == TOKEN_EOF) break ;
 
-					state = 2;
-					break ;
+				parserError(& parser, "expected link source, keyword or EOF.", -3);
 
-				}
+			case 2:		// Nodes of a path.
 
-				if (t == TOKEN_SOURCE_KEYWORD) {
+				if (t == TOKEN_INTEGER) {
 
-					state = 3;
+					parserAddNode(newPath, parser.integer);
+					if (links.numberOfNodes <= parser.integer) links.numberOfNodes = parser.integer + 1;
 					break ;
 				}
-				
-				if (t == TOKEN_FLOWTIME_KEYWORD) {
 
-					state = 6;
-					break ;
-				}
+				if (t != TOKEN_END_PATH) parserError(& parser, "expected node identifier or '?'.", -4);
 
-				if (t == TOKEN_EOF) {
+				if (parserNextToken(& parser) != TOKEN_INTEGER) parserError(& parser, "expected flow time.", -8);
+				MALLOC(flowTime, sizeof(int));
+				* flowTime = parser.integer;
+				listAdd(* flt, flowTime);
 
-					end = 1;
-					break ;
-				}
+				if (parserNextToken(& parser) != TOKEN_INTEGER) parserError(& parser, "expected packet TX duration.", -9);
+				MALLOC(txTime, sizeof(int));
+				* txTime = (int) parser.real;
+				listAdd(* ftx, txTime);
 
-				fclose(in);
-				fprintf(stderr, "Error at line %d: expected flowTime identifier, keyword or EOF.\n", currLine);
-				exit(-8);
-				
+				state = 3;
+				break ;
 		}
-	}
-
-	fclose(in);
-#ifdef OLD
-	if (listLength(* dst) == 0 || listLength(* src) == 0) {
 
-		fprintf(stderr, "Sources and destinations must be specified!\n");
-		exit(-8);
+		if (t == TOKEN_EOF) break ;
 	}
-#endif
-	if (listLength(* dst) != listLength(* src)) {
 
-		fprintf(stderr, "There must be the same number of sources and destinations!\n");
-		exit(-9);
-	}
+	parserClose(& parser);
 
-	graph = graphNew(n_nodes);
-	for (newLink = listBegin(links); newLink; newLink = listNext(links)) {
+	if (listLength(* paths) == 0) {
 
-		graphAddLink(graph, newLink->linkHead, newLink->linkTail, newLink->linkWeight);
-		free(newLink);
+		fprintf(stderr, "No path specified!\n");
+		exit(-8);
 	}
 
-	listFree(links);
-	free(links);
-
-	return(graph);
+	return(parserBuildGraph(& links));
 }
-
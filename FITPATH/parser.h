@@ -4,5 +4,6 @@
 #include "graph.h"
 
 t_graph * parserParse(char * filename, t_list ** src, t_list ** dst, t_list ** flt);
+t_graph * parserParsePaths(char * filename, t_list ** pathList, t_list ** flowTimeList, t_list ** packetTxTime);
 
 #endif
@@ -0,0 +1,340 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "resultFile.h"
+#include "memory.h"
+
+/*
+ * Write buffer of the result file. Blocks are written whole, so the
+ * file is touched once every RESULT_BLOCK_ROWS incumbents at most.
+ */
+#define RESULT_BUFFER_SIZE	(1 << 16)
+
+/*
+ * Expand a file name template: %n, %i and %r become the nodes,
+ * instance and reference numbers and %% a single %. Returns 0 if the
+ * name does not fit in size bytes.
+ */
+int resultPathExpand(char * buffer, size_t size, const char * template, int nodes, int instance, int reference) {
+
+	size_t length = 0;
+	int written;
+
+	for (; * template; template++) {
+
+		if (* template == '%' && template[1] && strchr("nir", template[1])) {
+
+			template++;
+			written = snprintf(buffer + length, size - length, "%d", * template == 'n' ? nodes : * template == 'i' ? instance : reference);
+			if (written < 0 || (size_t) written >= size - length) return(0);
+			length += written;
+			continue ;
+		}
+
+		if (* template == '%' && template[1] == '%') template++;
+		if (length + 1 >= size) return(0);
+		buffer[length++] = * template;
+	}
+	buffer[length] = 0;
+
+	return(1);
+}
+
+static void resultBlockAllocate(t_resultBlock * block, uint32_t rows, uint32_t numberOfFlows) {
+
+	MALLOC(block->simulation, rows * sizeof(uint32_t));
+	MALLOC(block->time, rows * sizeof(float));
+	MALLOC(block->cost, rows * sizeof(float));
+	MALLOC(block->delay, rows * sizeof(float));
+	MALLOC(block->rate, rows * numberOfFlows * sizeof(float));
+	MALLOC(block->flowDelay, rows * numberOfFlows * sizeof(float));
+	MALLOC(block->loss, rows * numberOfFlows * sizeof(float));
+	MALLOC(block->pathLengths, rows * numberOfFlows * sizeof(uint16_t));
+}
+
+static void resultBlockFree(t_resultBlock * block) {
+
+	free(block->simulation);
+	free(block->time);
+	free(block->cost);
+	free(block->delay);
+	free(block->rate);
+	free(block->flowDelay);
+	free(block->loss);
+	free(block->pathLengths);
+	free(block->pathNodes);
+	free(block->pathOffsets);
+}
+
+static void resultHeaderFree(t_resultHeader * header) {
+
+	free(header->input);
+	free(header->options);
+}
+
+static void writeString(FILE * file, char * string) {
+
+	uint32_t length = string ? strlen(string) : 0;
+
+	fwrite(& length, sizeof(uint32_t), 1, file);
+	fwrite(string, 1, length, file);
+}
+
+static char * readString(FILE * file) {
+
+	uint32_t length;
+	char * string;
+
+	if (fread(& length, sizeof(uint32_t), 1, file) != 1 || length > (1 << 20)) return(NULL);
+
+	MALLOC(string, (size_t) length + 1);
+	if (fread(string, 1, length, file) != length) {
+
+		free(string);
+		return(NULL);
+	}
+	string[length] = 0;
+
+	return(string);
+}
+
+/*
+ * Create filename and write the run header. Returns NULL if the file
+ * can not be created or node numbers do not fit the path column.
+ */
+t_resultWriter * resultWriterOpen(char * filename, t_resultHeader * header) {
+
+	t_resultWriter * writer;
+	FILE * file;
+
+	if (header->graphNodes > UINT16_MAX) return(NULL);
+
+	file = fopen(filename, "wb");
+	if (!file) return(NULL);
+
+	MALLOC(writer, sizeof(t_resultWriter));
+	writer->file = file;
+	writer->error = 0;
+	setvbuf(file, NULL, _IOFBF, RESULT_BUFFER_SIZE);
+
+	writer->header = * header;
+	MALLOC(writer->header.input, strlen(header->input ? header->input : "") + 1);
+	strcpy(writer->header.input, header->input ? header->input : "");
+	MALLOC(writer->header.options, strlen(header->options ? header->options : "") + 1);
+	strcpy(writer->header.options, header->options ? header->options : "");
+
+	memset(& writer->block, 0, sizeof(t_resultBlock));
+	resultBlockAllocate(& writer->block, RESULT_BLOCK_ROWS, header->numberOfFlows);
+	writer->allocatedPathNodes = 0;
+
+	fwrite(RESULT_MAGIC, 1, 4, file);
+	fwrite(& (uint32_t) { RESULT_VERSION }, sizeof(uint32_t), 1, file);
+	fwrite(& header->numberOfFlows, sizeof(uint32_t), 1, file);
+	fwrite(& header->graphNodes, sizeof(uint32_t), 1, file);
+	fwrite(& header->nodes, sizeof(int32_t), 1, file);
+	fwrite(& header->instance, sizeof(int32_t), 1, file);
+	fwrite(& header->reference, sizeof(int32_t), 1, file);
+	fwrite(& header->startTime, sizeof(int64_t), 1, file);
+	writeString(file, writer->header.input);
+	writeString(file, writer->header.options);
+
+	return(writer);
+}
+
+static void resultWriterFlushBlock(t_resultWriter * writer) {
+
+	t_resultBlock * block = & writer->block;
+	uint32_t rows = block->rows, cells = rows * writer->header.numberOfFlows;
+	uint32_t f;
+
+	if (rows == 0) return;
+
+	fwrite(& block->rows, sizeof(uint32_t), 1, writer->file);
+	fwrite(& block->numberOfPathNodes, sizeof(uint32_t), 1, writer->file);
+	fwrite(block->simulation, sizeof(uint32_t), rows, writer->file);
+	fwrite(block->time, sizeof(float), rows, writer->file);
+	fwrite(block->cost, sizeof(float), rows, writer->file);
+	fwrite(block->delay, sizeof(float), rows, writer->file);
+
+	/*
+	 * Rows were added flow major with a stride of RESULT_BLOCK_ROWS;
+	 * a partial block is written with a stride of rows.
+	 */
+	for (f = 0; f < writer->header.numberOfFlows; f++) fwrite(block->rate + f * RESULT_BLOCK_ROWS, sizeof(float), rows, writer->file);
+	for (f = 0; f < writer->header.numberOfFlows; f++) fwrite(block->flowDelay + f * RESULT_BLOCK_ROWS, sizeof(float), rows, writer->file);
+	for (f = 0; f < writer->header.numberOfFlows; f++) fwrite(block->loss + f * RESULT_BLOCK_ROWS, sizeof(float), rows, writer->file);
+
+	fwrite(block->pathLengths, sizeof(uint16_t), cells, writer->file);
+	fwrite(block->pathNodes, sizeof(uint16_t), block->numberOfPathNodes, writer->file);
+
+	if (ferror(writer->file)) writer->error = 1;
+
+	block->rows = 0;
+	block->numberOfPathNodes = 0;
+}
+
+/*
+ * Append the record of an incumbent. rate, flowDelay and loss hold a
+ * value per flow and paths a path per flow.
+ */
+void resultWriterAdd(t_resultWriter * writer, uint32_t simulation, float time, float cost, float delay,
+	float * rate, float * flowDelay, float * loss, t_array * paths) {
+
+	t_resultBlock * block = & writer->block;
+	uint32_t row = block->rows, numberOfFlows = writer->header.numberOfFlows;
+	uint32_t f;
+	t_array * path;
+	int j;
+
+	block->simulation[row] = simulation;
+	block->time[row] = time;
+	block->cost[row] = cost;
+	block->delay[row] = delay;
+
+	for (f = 0; f < numberOfFlows; f++) {
+
+		block->rate[f * RESULT_BLOCK_ROWS + row] = rate[f];
+		block->flowDelay[f * RESULT_BLOCK_ROWS + row] = flowDelay[f];
+		block->loss[f * RESULT_BLOCK_ROWS + row] = loss[f];
+
+		path = arrayGet(paths, f);
+		block->pathLengths[row * numberOfFlows + f] = arrayLength(path);
+		if (block->numberOfPathNodes + arrayLength(path) > writer->allocatedPathNodes) {
+
+			writer->allocatedPathNodes = 2 * (block->numberOfPathNodes + arrayLength(path));
+			REALLOC(block->pathNodes, writer->allocatedPathNodes * sizeof(uint16_t));
+		}
+		for (j = 0; j < arrayLength(path); j++) block->pathNodes[block->numberOfPathNodes++] = (long) arrayGet(path, j);
+	}
+
+	if (++block->rows == RESULT_BLOCK_ROWS) resultWriterFlushBlock(writer);
+}
+
+/*
+ * Write the last block and close the file. Returns 0 if any write
+ * failed.
+ */
+int resultWriterClose(t_resultWriter * writer) {
+
+	int ok;
+
+	resultWriterFlushBlock(writer);
+	ok = !writer->error && !ferror(writer->file);
+	if (fclose(writer->file)) ok = 0;
+
+	resultBlockFree(& writer->block);
+	resultHeaderFree(& writer->header);
+
+	return(ok);
+}
+
+/*
+ * Open a result file and read its header. Returns NULL if it is not
+ * a result file of this version.
+ */
+t_resultReader * resultReaderOpen(char * filename) {
+
+	t_resultReader * reader;
+	FILE * file;
+	char magic[4];
+	uint32_t version;
+	t_resultHeader * header;
+
+	file = fopen(filename, "rb");
+	if (!file) return(NULL);
+
+	MALLOC(reader, sizeof(t_resultReader));
+	memset(reader, 0, sizeof(t_resultReader));
+	reader->file = file;
+	header = & reader->header;
+
+	if (fread(magic, 1, 4, file) != 4 || memcmp(magic, RESULT_MAGIC, 4)
+		|| fread(& version, sizeof(uint32_t), 1, file) != 1 || version != RESULT_VERSION
+		|| fread(& header->numberOfFlows, sizeof(uint32_t), 1, file) != 1
+		|| fread(& header->graphNodes, sizeof(uint32_t), 1, file) != 1
+		|| fread(& header->nodes, sizeof(int32_t), 1, file) != 1
+		|| fread(& header->instance, sizeof(int32_t), 1, file) != 1
+		|| fread(& header->reference, sizeof(int32_t), 1, file) != 1
+		|| fread(& header->startTime, sizeof(int64_t), 1, file) != 1
+		|| (header->input = readString(file)) == NULL
+		|| (header->options = readString(file)) == NULL) {
+
+		resultReaderClose(reader);
+		free(reader);
+		return(NULL);
+	}
+
+	return(reader);
+}
+
+/*
+ * Read the next block into reader->block. Returns 0 at the end of the
+ * file, or if the block is truncated or inconsistent.
+ */
+int resultReaderNextBlock(t_resultReader * reader) {
+
+	t_resultBlock * block = & reader->block;
+	FILE * file = reader->file;
+	uint32_t rows, numberOfPathNodes, cells, offset, i;
+
+	if (fread(& rows, sizeof(uint32_t), 1, file) != 1 || rows == 0 || rows > RESULT_BLOCK_ROWS) return(0);
+	if (fread(& numberOfPathNodes, sizeof(uint32_t), 1, file) != 1) return(0);
+
+	cells = rows * reader->header.numberOfFlows;
+	if (rows > reader->allocatedRows) {
+
+		resultBlockFree(block);
+		memset(block, 0, sizeof(t_resultBlock));
+		resultBlockAllocate(block, rows, reader->header.numberOfFlows);
+		MALLOC(block->pathOffsets, (cells + 1) * sizeof(uint32_t));
+		reader->allocatedRows = rows;
+		reader->allocatedPathNodes = 0;
+	}
+	if (numberOfPathNodes > reader->allocatedPathNodes) {
+
+		REALLOC(block->pathNodes, numberOfPathNodes * sizeof(uint16_t));
+		reader->allocatedPathNodes = numberOfPathNodes;
+	}
+
+	block->rows = rows;
+	block->numberOfPathNodes = numberOfPathNodes;
+
+	if (fread(block->simulation, sizeof(uint32_t), rows, file) != rows
+		|| fread(block->time, sizeof(float), rows, file) != rows
+		|| fread(block->cost, sizeof(float), rows, file) != rows
+		|| fread(block->delay, sizeof(float), rows, file) != rows
+		|| fread(block->rate, sizeof(float), cells, file) != cells
+		|| fread(block->flowDelay, sizeof(float), cells, file) != cells
+		|| fread(block->loss, sizeof(float), cells, file) != cells
+		|| fread(block->pathLengths, sizeof(uint16_t), cells, file) != cells
+		|| fread(block->pathNodes, sizeof(uint16_t), numberOfPathNodes, file) != numberOfPathNodes) return(0);
+
+	for (offset = 0, i = 0; i < cells; i++) {
+
+		block->pathOffsets[i] = offset;
+		offset += block->pathLengths[i];
+	}
+	if (offset != numberOfPathNodes) return(0);
+
+	return(1);
+}
+
+/*
+ * Path of a flow in a row of the last block read: its nodes, source
+ * first, and their number in length.
+ */
+uint16_t * resultBlockPath(t_resultBlock * block, uint32_t numberOfFlows, uint32_t row, uint32_t flow, int * length) {
+
+	* length = block->pathLengths[row * numberOfFlows + flow];
+
+	return(block->pathNodes + block->pathOffsets[row * numberOfFlows + flow]);
+}
+
+void resultReaderClose(t_resultReader * reader) {
+
+	fclose(reader->file);
+	resultBlockFree(& reader->block);
+	resultHeaderFree(& reader->header);
+}
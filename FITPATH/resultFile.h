@@ -0,0 +1,89 @@
+#ifndef __RESULTFILE_H__
+#define __RESULTFILE_H__
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "array.h"
+
+/*
+ * Result file: a header describing the run, then blocks of up to
+ * RESULT_BLOCK_ROWS records, one per incumbent. Each block stores its
+ * records column by column, so a reader gets every cost, or every
+ * delay of a flow, as a contiguous array. Numbers are in the byte
+ * order of the machine that wrote the file; data/fitpathResults.py
+ * reads little endian files.
+ */
+#define RESULT_MAGIC		"FPRS"
+#define RESULT_VERSION		1
+#define RESULT_BLOCK_ROWS	256
+
+/*
+ * Run header. nodes, instance and reference are the command line
+ * numbers of fitpath, graphNodes the nodes of the topology read.
+ */
+typedef struct {
+
+	uint32_t numberOfFlows;
+	uint32_t graphNodes;
+	int32_t nodes;
+	int32_t instance;
+	int32_t reference;
+	int64_t startTime;		// Unix time the run started.
+	char * input;
+	char * options;			// Command line options, space separated.
+} t_resultHeader;
+
+/*
+ * Columns of a block. Per flow columns are flow major: the rate of
+ * flow f in row i is rate[f * rows + i]. pathLengths is row major,
+ * pathLengths[i * numberOfFlows + f], and the nodes of every path,
+ * source first, follow each other in pathNodes in the same order.
+ */
+typedef struct {
+
+	uint32_t rows;
+	uint32_t numberOfPathNodes;
+	uint32_t * simulation;	// Simulations run until the incumbent was found.
+	float * time;			// CPU time until then, in ms.
+	float * cost;
+	float * delay;
+	float * rate;
+	float * flowDelay;
+	float * loss;
+	uint16_t * pathLengths;
+	uint16_t * pathNodes;
+	uint32_t * pathOffsets;
+} t_resultBlock;
+
+typedef struct {
+
+	FILE * file;
+	t_resultHeader header;
+	t_resultBlock block;
+	uint32_t allocatedPathNodes;
+	int error;
+} t_resultWriter;
+
+typedef struct {
+
+	FILE * file;
+	t_resultHeader header;
+	t_resultBlock block;
+	uint32_t allocatedRows;
+	uint32_t allocatedPathNodes;
+} t_resultReader;
+
+int resultPathExpand(char * buffer, size_t size, const char * template, int nodes, int instance, int reference);
+
+t_resultWriter * resultWriterOpen(char * filename, t_resultHeader * header);
+void resultWriterAdd(t_resultWriter * writer, uint32_t simulation, float time, float cost, float delay,
+	float * rate, float * flowDelay, float * loss, t_array * paths);
+int resultWriterClose(t_resultWriter * writer);
+
+t_resultReader * resultReaderOpen(char * filename);
+int resultReaderNextBlock(t_resultReader * reader);
+uint16_t * resultBlockPath(t_resultBlock * block, uint32_t numberOfFlows, uint32_t row, uint32_t flow, int * length);
+void resultReaderClose(t_resultReader * reader);
+
+#endif
@@ -0,0 +1,683 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "search.h"
+#include "heuristics.h"
+#include "linkTable.h"
+#include "neighborhood.h"
+#include "prefixTree.h"
+#include "memory.h"
+#include "surrogate.h"
+
+/*
+ * Pre-screen of the search: heuristicCostLowerBound bounds
+ * the cost from the air time that each clique of conflicting links
+ * needs. A candidate is rejected only if the bound is above bestCost,
+ * since equal costs are still decided by the delay. Along the
+ * Gray-code walk, the bound updates the terms of the flipped flow
+ * only (heuristicBoundUpdate).
+ */
+unsigned long searchEstimatedCandidates = 0, searchRejectedCandidates = 0;
+
+int searchEstimateRejects(t_heuristicBound * bound, t_graph * graph, t_array * paths, float bestCost) {
+
+	__atomic_fetch_add(& searchEstimatedCandidates, 1, __ATOMIC_RELAXED);
+	if (heuristicBoundUpdate(bound, graph, paths) <= bestCost) return(0);
+
+	__atomic_fetch_add(& searchRejectedCandidates, 1, __ATOMIC_RELAXED);
+	return(1);
+}
+
+
+/*
+ * Multi-start search: numberOfWorkers ILS trajectories run in
+ * parallel. In each iteration a trajectory swaps the paths of its best
+ * solution with the next path of each flow and then, if the cost
+ * improved, with the previous best solution (the history), otherwise
+ * the history with the next paths. Worker 0 starts from the initial
+ * solution; the others start from a random mix and then advance
+ * through the remaining paths of each flow in Yen order. The best
+ * solution is shared by all workers. Every MIGRATION_INTERVAL
+ * iterations each worker publishes its best solution and adopts the
+ * one of the previous worker (in a ring) if it is better.
+ *
+ * Within a trajectory, every mix reaching the pre-screen is recorded
+ * in visited and not evaluated again: the best cost only improves, so
+ * a mix seen before can not replace the best solution. With a tabu
+ * tenure, flows whose path changed in an iteration are tabu for the
+ * next tenure iterations, and mixes swapping them are skipped. With a
+ * surrogate model, each neighborhood is ranked by predicted cost and
+ * only its surrogateTopK best mixes are simulated. With prefetch, the
+ * mixes of a neighborhood that pass the pre-screen are simulated at
+ * once with simulationSimulateBatch before it is explored.
+ */
+#define MIGRATION_INTERVAL	5
+#define SEARCH_TIME_LIMIT	60000	// ms
+#define MAX_PREFETCH_PATHS	16
+
+unsigned long searchVisitedEntries = 0, searchVisitedHits = 0;
+
+typedef struct {
+
+	t_graph * graph;
+	int numberOfPairs;
+	int numberOfDescriptors;
+	int numberOfPathsPerFlow;
+	int * numberOfCandidates;
+	t_array *** candidates;		// candidates[i][k]: k-th path of pair i, in Yen order.
+	t_array * flowTimes;
+	t_array * txDurations;
+	t_searchOptions * options;
+	struct timespec start;
+
+	t_array * initialPaths;		// Start of worker 0.
+	float initialCost;			// Cost of initialPaths if already simulated, INFINITY otherwise.
+	float initialDelay;
+
+	pthread_mutex_t lock;
+	float bestCost;				// Shared incumbent, read without the lock.
+	float bestDelay;
+	t_array * bestPaths;
+	int iterations;				// Most iterations done by a worker.
+	t_array ** elitePaths;		// Last solution published by each worker.
+	float * eliteCosts;
+	float * eliteDelays;
+} t_multiStart;
+
+typedef struct {
+
+	t_multiStart * shared;
+	int id;
+	int ** order;				// order[i][k]: index of the k-th path visited for pair i.
+	int * cursor;
+	t_array * auxPaths, * neighborPaths, * currentPaths, * bestPaths, * histPaths;
+	float bestCost, bestDelay;
+	t_visited * visited;
+	t_heuristicCtx * heuristicCtx;
+	t_heuristicBound * bound;	// Pre-screen bound along the walk.
+	int * tabuUntil;			// Iteration until which each flow is tabu.
+	t_array * tabuPaths;		// Best paths at the last tabu update.
+	t_visited * surrogateSelected;	// Mixes of the neighborhood selected by the surrogate.
+	t_array ** prefetchedPaths;
+	t_return ** prefetchedResults;
+	int numberOfPrefetched;
+} t_worker;
+
+typedef struct {
+
+	double prediction;
+	uint64_t fingerprint;
+} t_rankedMix;
+
+static double elapsedMilliseconds(struct timespec * start) {
+
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, & now);
+
+	return((now.tv_sec - start->tv_sec) * 1000.0 + (now.tv_nsec - start->tv_nsec) / 1000000.0);
+}
+
+static void copyPaths(t_array * to, t_array * from) {
+
+	for (int p = 0; p < arrayLength(from); p++) arraySet(to, p, arrayGet(from, p));
+}
+
+/*
+ * (cost, delay) is better than (bestCost, bestDelay), as in the
+ * tie-breaking rule of the main search.
+ */
+static int isBetter(float cost, float delay, float bestCost, float bestDelay) {
+
+	return(cost < bestCost || (cost == bestCost && delay < bestDelay));
+}
+
+static int compareRankedMixes(const void * a, const void * b) {
+
+	const t_rankedMix * mix1 = a, * mix2 = b;
+
+	if (mix1->prediction < mix2->prediction) return(-1);
+	if (mix1->prediction > mix2->prediction) return(1);
+	return(0);
+}
+
+/*
+ * Place the next path of each pair in neighborPaths.
+ */
+static void workerNext(t_worker * worker) {
+
+	t_multiStart * shared = worker->shared;
+	int c = 0;
+
+	for (int i = 0; i < shared->numberOfPairs; i++) {
+
+		worker->cursor[i]++;
+		for (int d = 0; d < shared->numberOfDescriptors; d++) {
+
+			arraySet(worker->neighborPaths, c, shared->candidates[i][worker->order[i][worker->cursor[i]]]);
+			c++;
+		}
+	}
+}
+
+/*
+ * Flows that can not be swapped in iteration.
+ */
+static unsigned long workerTabu(t_worker * worker, int iteration) {
+
+	unsigned long mask = 0;
+
+	if (!worker->shared->options->tabuTenure) return(0);
+
+	for (int k = 0; k < arrayLength(worker->bestPaths); k++) {
+
+		if (worker->tabuUntil[k] > iteration) mask |= 1UL << k;
+	}
+
+	return(mask);
+}
+
+/*
+ * Make tabu the flows whose best path changed since the last call.
+ */
+static void workerUpdateTabu(t_worker * worker, int iteration) {
+
+	int tabuTenure = worker->shared->options->tabuTenure;
+
+	if (!tabuTenure) return;
+
+	for (int k = 0; k < arrayLength(worker->bestPaths); k++) {
+
+		if (arrayGet(worker->tabuPaths, k) != arrayGet(worker->bestPaths, k)) worker->tabuUntil[k] = iteration + tabuTenure;
+		arraySet(worker->tabuPaths, k, arrayGet(worker->bestPaths, k));
+	}
+}
+
+static void workerObserve(t_worker * worker, t_array * paths, t_return * r) {
+
+	t_multiStart * shared = worker->shared;
+
+	if (!shared->options->observer) return;
+
+	pthread_mutex_lock(& shared->lock);
+	shared->options->observer(shared->options->observerContext, shared->graph, paths, shared->flowTimes, r);
+	pthread_mutex_unlock(& shared->lock);
+}
+
+/*
+ * Select the surrogateTopK mixes of auxPaths and neighborPaths with
+ * the lowest predicted cost, among those not visited and not swapping
+ * a tabu flow.
+ */
+static void workerRank(t_worker * worker, unsigned long tabu) {
+
+	t_multiStart * shared = worker->shared;
+	int numPaths = arrayLength(worker->auxPaths), numberOfMixes = 0;
+	double features[SURROGATE_FEATURES];
+	t_neighborhood neighborhood;
+	t_rankedMix * mixes;
+
+	if (!shared->options->surrogate) return;
+
+	if (worker->surrogateSelected) {
+
+		visitedFree(worker->surrogateSelected);
+		free(worker->surrogateSelected);
+	}
+	worker->surrogateSelected = visitedNew();
+
+	MALLOC(mixes, sizeof(t_rankedMix) * ((1UL << numPaths) - 1));
+	neighborhoodBegin(& neighborhood, worker->auxPaths, worker->neighborPaths, worker->currentPaths);
+	while (neighborhoodNext(& neighborhood)) {
+
+		if (neighborhood.mask & tabu) continue ;
+		if (visitedContains(worker->visited, neighborhood.fingerprint)) continue ;
+
+		surrogateFeatures(worker->heuristicCtx, shared->graph, worker->currentPaths, shared->flowTimes, features);
+		mixes[numberOfMixes].prediction = surrogatePredict(shared->options->surrogate, features);
+		mixes[numberOfMixes].fingerprint = neighborhood.fingerprint;
+		numberOfMixes++;
+	}
+	neighborhoodFree(& neighborhood);
+
+	qsort(mixes, numberOfMixes, sizeof(t_rankedMix), compareRankedMixes);
+	for (int k = 0; k < numberOfMixes && k < shared->options->surrogateTopK; k++) visitedCheckAndAdd(worker->surrogateSelected, mixes[k].fingerprint);
+	free(mixes);
+}
+
+static int workerSurrogateSkips(t_worker * worker, t_neighborhood * neighborhood) {
+
+	return(worker->shared->options->surrogate && !visitedContains(worker->surrogateSelected, neighborhood->fingerprint));
+}
+
+static void workerClearPrefetched(t_worker * worker) {
+
+	for (int k = 0; k < worker->numberOfPrefetched; k++) {
+
+		if (worker->prefetchedResults[k]) {
+
+			simulationReturnFree(worker->prefetchedResults[k]);
+			free(worker->prefetchedResults[k]);
+		}
+		arrayFree(worker->prefetchedPaths[k]);
+		free(worker->prefetchedPaths[k]);
+	}
+	free(worker->prefetchedPaths);
+	free(worker->prefetchedResults);
+	worker->prefetchedPaths = NULL;
+	worker->prefetchedResults = NULL;
+	worker->numberOfPrefetched = 0;
+}
+
+/*
+ * Simulate every mix of auxPaths and neighborPaths that workerExplore
+ * would simulate against the current best cost. The observer sees the
+ * results now; workerSimulate then takes them.
+ */
+static void workerPrefetch(t_worker * worker, unsigned long tabu) {
+
+	t_multiStart * shared = worker->shared;
+	int numPaths = arrayLength(worker->auxPaths);
+	t_neighborhood neighborhood;
+	t_array * paths;
+
+	if (!shared->options->prefetch || numPaths > MAX_PREFETCH_PATHS) return;
+
+	MALLOC(worker->prefetchedPaths, sizeof(t_array *) * ((1 << numPaths) - 1));
+	MALLOC(worker->prefetchedResults, sizeof(t_return *) * ((1 << numPaths) - 1));
+
+	neighborhoodBegin(& neighborhood, worker->auxPaths, worker->neighborPaths, worker->currentPaths);
+	while (neighborhoodNext(& neighborhood)) {
+
+		if (neighborhood.mask & tabu || workerSurrogateSkips(worker, & neighborhood)) continue ;
+		if (visitedContains(worker->visited, neighborhood.fingerprint)) continue ;
+		if (searchEstimateRejects(worker->bound, shared->graph, worker->currentPaths, worker->bestCost)) continue ;
+
+		paths = arrayNew(numPaths);
+		copyPaths(paths, worker->currentPaths);
+		worker->prefetchedPaths[worker->numberOfPrefetched++] = paths;
+	}
+	neighborhoodFree(& neighborhood);
+
+	simulationSimulateBatch(shared->graph, worker->prefetchedPaths, worker->numberOfPrefetched, shared->flowTimes, shared->txDurations, worker->prefetchedResults);
+	for (int k = 0; k < worker->numberOfPrefetched; k++) workerObserve(worker, worker->prefetchedPaths[k], worker->prefetchedResults[k]);
+}
+
+/*
+ * Simulate paths, or take the result of workerPrefetch.
+ */
+static t_return * workerSimulate(t_worker * worker, t_array * paths) {
+
+	t_multiStart * shared = worker->shared;
+	t_return * r;
+	int k, j;
+
+	for (k = 0; k < worker->numberOfPrefetched; k++) {
+
+		if (!worker->prefetchedResults[k]) continue ;
+
+		for (j = 0; j < arrayLength(paths); j++) {
+
+			if (arrayGet(worker->prefetchedPaths[k], j) != arrayGet(paths, j)) break ;
+		}
+
+		if (j == arrayLength(paths)) {
+
+			r = worker->prefetchedResults[k];
+			worker->prefetchedResults[k] = NULL;
+			return(r);
+		}
+	}
+
+	r = simulationSimulate(shared->graph, paths, shared->flowTimes, shared->txDurations);
+	workerObserve(worker, paths, r);
+
+	return(r);
+}
+
+static void workerOffer(t_worker * worker) {
+
+	t_multiStart * shared = worker->shared;
+
+	pthread_mutex_lock(& shared->lock);
+	if (isBetter(worker->bestCost, worker->bestDelay, shared->bestCost, shared->bestDelay)) {
+
+		copyPaths(shared->bestPaths, worker->bestPaths);
+		shared->bestDelay = worker->bestDelay;
+		__atomic_store(& shared->bestCost, & worker->bestCost, __ATOMIC_RELAXED);
+	}
+	pthread_mutex_unlock(& shared->lock);
+}
+
+/*
+ * Walk the mixes of auxPaths and neighborPaths that swap no flow of
+ * tabu. The best solution is moved to the history on ties and, if
+ * keepHistory is set, also on improvements. Returns 1 if the cost
+ * improved.
+ */
+static int workerExplore(t_worker * worker, int keepHistory, unsigned long tabu) {
+
+	t_multiStart * shared = worker->shared;
+	t_neighborhood neighborhood;
+	t_return * r;
+	int improved = 0;
+
+	workerRank(worker, tabu);
+	workerPrefetch(worker, tabu);
+
+	neighborhoodBegin(& neighborhood, worker->auxPaths, worker->neighborPaths, worker->currentPaths);
+	while (neighborhoodNext(& neighborhood)) {
+
+		if (neighborhood.mask & tabu || workerSurrogateSkips(worker, & neighborhood)) continue ;
+		if (visitedCheckAndAdd(worker->visited, neighborhood.fingerprint)) continue ;
+		if (searchEstimateRejects(worker->bound, shared->graph, worker->currentPaths, worker->bestCost)) continue ;
+
+		r = workerSimulate(worker, worker->currentPaths);
+
+		if (isBetter(r->cost, r->delay, worker->bestCost, worker->bestDelay)) {
+
+			if (r->cost < worker->bestCost) improved = 1;
+			if (keepHistory || r->cost == worker->bestCost) copyPaths(worker->histPaths, worker->bestPaths);
+			copyPaths(worker->bestPaths, worker->currentPaths);
+			worker->bestCost = r->cost;
+			worker->bestDelay = r->delay;
+			workerOffer(worker);
+		}
+
+		simulationReturnFree(r);
+		free(r);
+	}
+	neighborhoodFree(& neighborhood);
+	workerClearPrefetched(worker);
+
+	return(improved);
+}
+
+/*
+ * Publish the best solution of the worker and adopt the one of the
+ * previous worker if it is better.
+ */
+static void workerMigrate(t_worker * worker) {
+
+	t_multiStart * shared = worker->shared;
+	int numberOfWorkers = shared->options->numberOfWorkers;
+	int from = (worker->id + numberOfWorkers - 1) % numberOfWorkers;
+
+	pthread_mutex_lock(& shared->lock);
+	copyPaths(shared->elitePaths[worker->id], worker->bestPaths);
+	shared->eliteCosts[worker->id] = worker->bestCost;
+	shared->eliteDelays[worker->id] = worker->bestDelay;
+
+	if (isBetter(shared->eliteCosts[from], shared->eliteDelays[from], worker->bestCost, worker->bestDelay)) {
+
+		copyPaths(worker->histPaths, worker->bestPaths);
+		copyPaths(worker->bestPaths, shared->elitePaths[from]);
+		worker->bestCost = shared->eliteCosts[from];
+		worker->bestDelay = shared->eliteDelays[from];
+	}
+	pthread_mutex_unlock(& shared->lock);
+}
+
+static void * workerRun(void * arg) {
+
+	t_worker * worker = arg;
+	t_multiStart * shared = worker->shared;
+	t_return * r;
+	unsigned long tabu;
+	float sharedCost;
+	int c, iteration, improved;
+
+	if (worker->id == 0) copyPaths(worker->bestPaths, shared->initialPaths);
+	else {
+
+		c = 0;
+		for (int i = 0; i < shared->numberOfPairs; i++) {
+
+			for (int d = 0; d < shared->numberOfDescriptors; d++) {
+
+				arraySet(worker->bestPaths, c, shared->candidates[i][worker->order[i][0]]);
+				c++;
+			}
+		}
+	}
+
+	visitedCheckAndAdd(worker->visited, neighborhoodFingerprint(worker->bestPaths));
+	if (worker->id == 0 && shared->initialCost < INFINITY) {
+
+		worker->bestCost = shared->initialCost;
+		worker->bestDelay = shared->initialDelay;
+	}
+	else {
+
+		r = workerSimulate(worker, worker->bestPaths);
+		worker->bestCost = r->cost;
+		worker->bestDelay = r->delay;
+		simulationReturnFree(r);
+		free(r);
+	}
+	copyPaths(worker->histPaths, worker->bestPaths);
+	copyPaths(worker->tabuPaths, worker->bestPaths);
+	workerOffer(worker);
+
+	copyPaths(worker->auxPaths, worker->bestPaths);
+	workerNext(worker);
+	workerExplore(worker, 1, 0);
+	workerUpdateTabu(worker, 0);
+
+	iteration = 1;
+	while (1) {
+
+		__atomic_load(& shared->bestCost, & sharedCost, __ATOMIC_RELAXED);
+		if (!(sharedCost > 0 && iteration < shared->numberOfPathsPerFlow - 1 && elapsedMilliseconds(& shared->start) < SEARCH_TIME_LIMIT)) break ;
+		if (shared->options->maxIterations && iteration >= shared->options->maxIterations) break ;
+
+		tabu = workerTabu(worker, iteration);
+
+		copyPaths(worker->auxPaths, worker->bestPaths);
+		workerNext(worker);
+		improved = workerExplore(worker, 0, tabu);
+
+		if (improved) {
+
+			copyPaths(worker->auxPaths, worker->bestPaths);
+			copyPaths(worker->neighborPaths, worker->histPaths);
+		}
+		else copyPaths(worker->auxPaths, worker->histPaths);
+		workerExplore(worker, 1, tabu);
+
+		workerUpdateTabu(worker, iteration);
+		iteration++;
+		if (iteration % MIGRATION_INTERVAL == 0) workerMigrate(worker);
+	}
+
+	pthread_mutex_lock(& shared->lock);
+	if (iteration > shared->iterations) shared->iterations = iteration;
+	pthread_mutex_unlock(& shared->lock);
+
+	return(NULL);
+}
+
+/*
+ * The paths of pathList, in Yen order. Their arrays are built here,
+ * so that the search threads only read them.
+ */
+t_array ** searchCandidates(t_list * pathList, int * numberOfCandidates) {
+
+	t_prefixTreeNode * path;
+	t_array ** candidates;
+	int k;
+
+	* numberOfCandidates = listLength(pathList);
+	MALLOC(candidates, sizeof(t_array *) * listLength(pathList));
+	for (k = 0, path = listBegin(pathList); path; path = listNext(pathList), k++) candidates[k] = prefixTreePath(path);
+
+	return(candidates);
+}
+
+void searchOptionsInit(t_searchOptions * options) {
+
+	options->numberOfWorkers = 1;
+	options->maxIterations = 0;
+	options->tabuTenure = 0;
+	options->surrogate = NULL;
+	options->surrogateTopK = 8;
+	options->prefetch = 0;
+	options->observer = NULL;
+	options->observerContext = NULL;
+}
+
+/*
+ * Run the multi-start search over the candidates of each pair (see
+ * searchCandidates). bestPaths holds the initial solution, the start
+ * of worker 0, and receives the best one found. If bestCost is finite,
+ * bestCost and bestDelay are taken as those of the initial solution,
+ * which is not simulated again. The observer of options, if any, is
+ * called with every simulation, one call at a time. Returns the number
+ * of iterations of the longest trajectory. searchVisitedEntries and
+ * searchVisitedHits add up the path sets recorded and skipped by the
+ * search memory of every trajectory.
+ */
+int searchMultiStart(t_graph * graph, t_array *** candidates, int * numberOfCandidates, int numberOfPairs, int numberOfDescriptors,
+	int numberOfPathsPerFlow, t_array * flowTimes, t_array * txDurations, t_searchOptions * options,
+	t_array * bestPaths, float * bestCost, float * bestDelay) {
+
+	t_multiStart shared;
+	t_worker * workers;
+	pthread_t * threads;
+	unsigned int seed;
+	int numberOfWorkers = options->numberOfWorkers;
+	int numPaths = arrayLength(bestPaths);
+	int i, k, w;
+
+	shared.graph = graph;
+	shared.numberOfPairs = numberOfPairs;
+	shared.numberOfDescriptors = numberOfDescriptors;
+	shared.numberOfPathsPerFlow = numberOfPathsPerFlow;
+	shared.flowTimes = flowTimes;
+	shared.txDurations = txDurations;
+	shared.options = options;
+	shared.numberOfCandidates = numberOfCandidates;
+	shared.candidates = candidates;
+	shared.initialPaths = arrayNew(numPaths);
+	copyPaths(shared.initialPaths, bestPaths);
+	shared.initialCost = * bestCost;
+	shared.initialDelay = * bestDelay;
+	shared.bestCost = * bestCost;
+	shared.bestDelay = * bestDelay;
+	shared.bestPaths = bestPaths;
+	shared.iterations = 0;
+	pthread_mutex_init(& shared.lock, NULL);
+	clock_gettime(CLOCK_MONOTONIC, & shared.start);
+
+	linkTableGet(graph);
+
+	MALLOC(shared.elitePaths, sizeof(t_array *) * numberOfWorkers);
+	MALLOC(shared.eliteCosts, sizeof(float) * numberOfWorkers);
+	MALLOC(shared.eliteDelays, sizeof(float) * numberOfWorkers);
+	MALLOC(workers, sizeof(t_worker) * numberOfWorkers);
+	MALLOC(threads, sizeof(pthread_t) * numberOfWorkers);
+
+	for (w = 0; w < numberOfWorkers; w++) {
+
+		shared.elitePaths[w] = arrayNew(numPaths);
+		copyPaths(shared.elitePaths[w], bestPaths);
+		shared.eliteCosts[w] = INFINITY;
+		shared.eliteDelays[w] = INFINITY;
+
+		workers[w].shared = & shared;
+		workers[w].id = w;
+		workers[w].auxPaths = arrayNew(numPaths);
+		workers[w].neighborPaths = arrayNew(numPaths);
+		workers[w].currentPaths = arrayNew(numPaths);
+		workers[w].bestPaths = arrayNew(numPaths);
+		workers[w].histPaths = arrayNew(numPaths);
+		workers[w].tabuPaths = arrayNew(numPaths);
+		workers[w].visited = visitedNew();
+		workers[w].heuristicCtx = heuristicCtxNew(graphSize(graph));
+		workers[w].bound = heuristicBoundNew(graph, flowTimes, numPaths);
+		workers[w].surrogateSelected = NULL;
+		workers[w].prefetchedPaths = NULL;
+		workers[w].prefetchedResults = NULL;
+		workers[w].numberOfPrefetched = 0;
+		MALLOC(workers[w].tabuUntil, sizeof(int) * numPaths);
+		for (k = 0; k < numPaths; k++) workers[w].tabuUntil[k] = 0;
+		MALLOC(workers[w].cursor, sizeof(int) * numberOfPairs);
+		MALLOC(workers[w].order, sizeof(int *) * numberOfPairs);
+
+		seed = w;
+		for (i = 0; i < numberOfPairs; i++) {
+
+			int start = w ? rand_r(& seed) % shared.numberOfCandidates[i] : 0;
+
+			MALLOC(workers[w].order[i], sizeof(int) * shared.numberOfCandidates[i]);
+			workers[w].order[i][0] = start;
+			for (k = 1; k < shared.numberOfCandidates[i]; k++) workers[w].order[i][k] = k <= start ? k - 1 : k;
+			workers[w].cursor[i] = 0;
+		}
+	}
+
+	for (w = 1; w < numberOfWorkers; w++) {
+
+		if (pthread_create(& threads[w], NULL, workerRun, & workers[w])) {
+
+			fprintf(stderr, "Could not create search thread\n");
+			exit(1);
+		}
+	}
+
+	workerRun(& workers[0]);
+
+	for (w = 1; w < numberOfWorkers; w++) pthread_join(threads[w], NULL);
+
+	* bestCost = shared.bestCost;
+	* bestDelay = shared.bestDelay;
+
+	for (w = 0; w < numberOfWorkers; w++) {
+
+		searchVisitedEntries += workers[w].visited->numberOfEntries;
+		searchVisitedHits += workers[w].visited->hits;
+
+		for (i = 0; i < numberOfPairs; i++) free(workers[w].order[i]);
+		free(workers[w].order);
+		free(workers[w].cursor);
+		free(workers[w].tabuUntil);
+		arrayFree(workers[w].auxPaths);
+		free(workers[w].auxPaths);
+		arrayFree(workers[w].neighborPaths);
+		free(workers[w].neighborPaths);
+		arrayFree(workers[w].currentPaths);
+		free(workers[w].currentPaths);
+		arrayFree(workers[w].bestPaths);
+		free(workers[w].bestPaths);
+		arrayFree(workers[w].histPaths);
+		free(workers[w].histPaths);
+		arrayFree(workers[w].tabuPaths);
+		free(workers[w].tabuPaths);
+		visitedFree(workers[w].visited);
+		free(workers[w].visited);
+		if (workers[w].surrogateSelected) {
+
+			visitedFree(workers[w].surrogateSelected);
+			free(workers[w].surrogateSelected);
+		}
+		heuristicCtxFree(workers[w].heuristicCtx);
+		free(workers[w].heuristicCtx);
+		heuristicBoundFree(workers[w].bound);
+		free(workers[w].bound);
+		arrayFree(shared.elitePaths[w]);
+		free(shared.elitePaths[w]);
+	}
+	arrayFree(shared.initialPaths);
+	free(shared.initialPaths);
+	free(shared.elitePaths);
+	free(shared.eliteCosts);
+	free(shared.eliteDelays);
+	free(workers);
+	free(threads);
+	pthread_mutex_destroy(& shared.lock);
+
+	return(shared.iterations);
+}
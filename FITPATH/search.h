@@ -0,0 +1,49 @@
+#ifndef __SEARCH_H__
+#define __SEARCH_H__
+
+#include "array.h"
+#include "graph.h"
+#include "list.h"
+#include "heuristics.h"
+#include "simulationh2.h"
+#include "surrogate.h"
+
+/*
+ * Shortest paths (Yen) generated for each flow: every one of them
+ * is a candidate of the search. optimum uses the same budget, so
+ * its result is a reference for the same candidate paths.
+ */
+#define SEARCH_PATHS_PER_FLOW	100
+
+/*
+ * Called by the search with every simulated path set.
+ */
+typedef void (* t_searchObserver)(void * context, t_graph * graph, t_array * paths, t_array * flowTimes, t_return * r);
+
+/*
+ * Options of searchMultiStart; searchOptionsInit sets the defaults.
+ */
+typedef struct {
+
+	int numberOfWorkers;		// Parallel trajectories (1).
+	int maxIterations;			// Iterations of each trajectory, 0 for as many as the paths allow (0).
+	int tabuTenure;				// Iterations a changed flow stays tabu (0: no tabu).
+	t_surrogate * surrogate;	// Ranks each neighborhood (NULL: no ranking).
+	int surrogateTopK;			// Mixes simulated per ranked neighborhood (8).
+	int prefetch;				// Simulate each neighborhood at once with simulationSimulateBatch (0).
+	t_searchObserver observer;	// Called with every simulated path set (NULL).
+	void * observerContext;
+} t_searchOptions;
+
+extern unsigned long searchEstimatedCandidates, searchRejectedCandidates;
+extern unsigned long searchVisitedEntries, searchVisitedHits;
+
+void searchOptionsInit(t_searchOptions * options);
+
+int searchEstimateRejects(t_heuristicBound * bound, t_graph * graph, t_array * paths, float bestCost);
+t_array ** searchCandidates(t_list * pathList, int * numberOfCandidates);
+int searchMultiStart(t_graph * graph, t_array *** candidates, int * numberOfCandidates, int numberOfPairs, int numberOfDescriptors,
+	int numberOfPathsPerFlow, t_array * flowTimes, t_array * txDurations, t_searchOptions * options,
+	t_array * bestPaths, float * bestCost, float * bestDelay);
+
+#endif
@@ -1,5 +1,3 @@
-#define _GNU_SOURCE
-
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
@@ -7,10 +5,8 @@
 
 #include "set.h"
 #include "memory.h"
-#include "list.h"
 
-#define MIN_ENTRIES			10
-#define ENTRIES_INCREMENT 	10
+#define MIN_ENTRIES			4
 
 t_set * setNew() {
 
@@ -18,59 +14,66 @@ t_set * setNew() {
 
 	MALLOC(set, sizeof(t_set));
 
-	set->bitsPerEntry = 8 * sizeof(unsigned int);
-
 	set->entries = MIN_ENTRIES;
-	set->maxElement = set->bitsPerEntry * set->entries - 1;
 	set->numElements = 0;
-	MALLOC(set->elements, sizeof(unsigned int) * set->entries);
-	memset(set->elements, 0, set->entries * sizeof(unsigned int));
+	MALLOC(set->elements, sizeof(uint64_t) * set->entries);
+	memset(set->elements, 0, set->entries * sizeof(uint64_t));
 
 	return(set);
 }
 
-void setAdd(t_set * set, int element) {
+/*
+ * Make room for every element up to maxElement.
+ */
+void setReserve(t_set * set, int maxElement) {
 
-	int entryIndex, bitIndex;
+	int entries;
 
-	entryIndex = element / set->bitsPerEntry;
-	bitIndex = element % set->bitsPerEntry;
+	if (maxElement < set->entries * SET_BITS_PER_ENTRY) return ;
 
-	if (element > set->maxElement) {
+	entries = set->entries ? set->entries : MIN_ENTRIES;
+	while(maxElement >= entries * SET_BITS_PER_ENTRY) entries *= 2;
 
-		REALLOC(set->elements, sizeof(unsigned int) * (entryIndex + 1 + ENTRIES_INCREMENT));
-		memset(& (set->elements[set->entries]), 0, sizeof(unsigned int) * (entryIndex + 1 + ENTRIES_INCREMENT - set->entries));
-		set->entries = entryIndex + 1 + ENTRIES_INCREMENT;
-		set->maxElement = set->bitsPerEntry * set->entries - 1;
-	}
+	REALLOC(set->elements, sizeof(uint64_t) * entries);
+	memset(& (set->elements[set->entries]), 0, sizeof(uint64_t) * (entries - set->entries));
+	set->entries = entries;
+}
+
+void setAdd(t_set * set, int element) {
+
+	int entryIndex;
+	uint64_t bit;
 
-	if (set->elements[entryIndex] & (1u << bitIndex)) return;
+	if (element >= set->entries * SET_BITS_PER_ENTRY) setReserve(set, element);
 
-	set->elements[entryIndex] |= (1u << bitIndex);
+	entryIndex = element / SET_BITS_PER_ENTRY;
+	bit = 1ull << (element % SET_BITS_PER_ENTRY);
+
+	if (set->elements[entryIndex] & bit) return;
+
+	set->elements[entryIndex] |= bit;
 	set->numElements++;
 }
 
 void setDel(t_set * set, unsigned int element) {
 	
-	int entryIndex, bitIndex;
+	int entryIndex;
+	uint64_t bit;
 
-	if (element > set->maxElement) return;
+	if (!setIsElementOf(set, element)) return;
 
-	entryIndex = element / set->bitsPerEntry;
-	bitIndex = element % set->bitsPerEntry;
+	entryIndex = element / SET_BITS_PER_ENTRY;
+	bit = 1ull << (element % SET_BITS_PER_ENTRY);
 
-	if (set->elements[entryIndex] & (1u << bitIndex)) {
-		
-		set->elements[entryIndex] &= ~(1u << bitIndex);
-		set->numElements--;
-	}
+	set->elements[entryIndex] &= ~bit;
+	set->numElements--;
 }
 
 void setClear(t_set * set) {
 
-	int i;
+	if (set->numElements == 0) return ;
 
-	for (i = 0; i < set->entries; i++) set->elements[i] = 0;
+	memset(set->elements, 0, set->entries * sizeof(uint64_t));
 	set->numElements = 0;
 }
 
@@ -84,76 +87,114 @@ int setIsEmpty(t_set * set) {
 	return((set->numElements == 0));
 }
 
-int setIsElementOf(t_set * set, unsigned int element) {
+/*
+ * Smallest element greater than element, or -1 if there is none.
+ */
+int setNext(t_set * set, int element) {
 
-	int entryIndex, bitIndex;
+	int entryIndex;
+	uint64_t x;
 
-	entryIndex = element / set->bitsPerEntry;
-	bitIndex = element % set->bitsPerEntry;
+	element++;
+	entryIndex = element / SET_BITS_PER_ENTRY;
+	if (entryIndex >= set->entries) return(-1);
 
-	if (element > set->maxElement) return(0);
+	x = set->elements[entryIndex] & (~0ull << (element % SET_BITS_PER_ENTRY));
+	while(!x) {
 
-	if (set->elements[entryIndex] & (1u << bitIndex)) return(1);
+		if (++entryIndex == set->entries) return(-1);
+		x = set->elements[entryIndex];
+	}
 
-	return(0);
+	return(entryIndex * SET_BITS_PER_ENTRY + __builtin_ctzll(x));
 }
 
-void setFree(t_set * set) {
+int setFirst(t_set * set) {
 
-	if (set->entries) {
-
-		free(set->elements);
-		set->entries = 0;
-		set->maxElement = -1;
-		set->numElements = 0;
-		set->elements = NULL;
-	}
+	return(setNext(set, -1));
 }
 
-void setPrint(t_set * set) {
+/*
+ * set = set U other.
+ */
+void setUnion(t_set * set, t_set * other) {
 
-	int i, lsb, base;
-	unsigned int x;
+	int i;
 
-	printf("Set has %d elements.\nEntries = %d and maxElement = %d.\n", setSize(set), set->entries, set->maxElement);
+	if (other->entries > set->entries) setReserve(set, other->entries * SET_BITS_PER_ENTRY - 1);
 
-	base = -1;
+	set->numElements = 0;
 	for (i = 0; i < set->entries; i++) {
-	
-		x = set->elements[i];
-		while(x) {
-
-			lsb = ffsl(x);
-			printf("Element %d is present.\n", base + lsb);
-			x &= (x - 1);
-		}
 
-		base += set->bitsPerEntry;
+		if (i < other->entries) set->elements[i] |= other->elements[i];
+		set->numElements += __builtin_popcountll(set->elements[i]);
 	}
 }
 
-t_list * setGetElements(t_set * set) {
+/*
+ * set = set & other.
+ */
+void setIntersection(t_set * set, t_set * other) {
 
 	int i;
-	unsigned long lsb, base;
-	unsigned int x;
-	t_list * list;
 
-	list = listNew();
-	base = 0;
+	set->numElements = 0;
 	for (i = 0; i < set->entries; i++) {
-	
-		x = set->elements[i];
-		while(x) {
 
-			lsb = ffsl(x);
-			x &= (x - 1);
-			listAdd(list, (void *) (base + lsb));
-		}
+		if (i < other->entries) set->elements[i] &= other->elements[i];
+		else set->elements[i] = 0;
+		set->numElements += __builtin_popcountll(set->elements[i]);
+	}
+}
+
+/*
+ * set = set - other.
+ */
+void setDifference(t_set * set, t_set * other) {
+
+	int i;
+
+	set->numElements = 0;
+	for (i = 0; i < set->entries; i++) {
 
-		base += set->bitsPerEntry;
+		if (i < other->entries) set->elements[i] &= ~other->elements[i];
+		set->numElements += __builtin_popcountll(set->elements[i]);
 	}
+}
 
-	return(list);
+/*
+ * Number of elements in both sets; neither set is changed.
+ */
+int setIntersectionSize(t_set * set, t_set * other) {
+
+	int i, entries, size;
+
+	entries = set->entries < other->entries ? set->entries : other->entries;
+	size = 0;
+	for (i = 0; i < entries; i++) size += __builtin_popcountll(set->elements[i] & other->elements[i]);
+
+	return(size);
 }
 
+void setFree(t_set * set) {
+
+	if (set->entries) {
+
+		free(set->elements);
+		set->entries = 0;
+		set->numElements = 0;
+		set->elements = NULL;
+	}
+}
+
+void setPrint(t_set * set) {
+
+	int element;
+
+	printf("Set has %d elements.\nEntries = %d and maxElement = %d.\n", setSize(set), set->entries, set->entries * SET_BITS_PER_ENTRY - 1);
+
+	for (element = setFirst(set); element >= 0; element = setNext(set, element)) {
+
+		printf("Element %d is present.\n", element);
+	}
+}
@@ -1,27 +1,49 @@
 #ifndef __SET_H__
 #define __SET_H__
 
-#include "list.h"
+#include <stdint.h>
+
+/*
+ * Bitset of non negative ints, one bit per possible element in 64 bit
+ * words. The word array doubles whenever an element does not fit.
+ *
+ * Elements are visited in increasing order, without allocating:
+ *
+ *	for (element = setFirst(set); element >= 0; element = setNext(set, element)) ...
+ *
+ * The bulk operations work a word at a time and leave the result in
+ * their first argument.
+ */
+#define SET_BITS_PER_ENTRY	64
 
 typedef struct {
 
 	int entries;
-	int bitsPerEntry;
-	int maxElement;
 	int numElements;
-	unsigned int * elements;
+	uint64_t * elements;
 } t_set;
 
 t_set * setNew();
+void setReserve(t_set * set, int maxElement);
 void setAdd(t_set * set, int element);
 void setDel(t_set * set, unsigned int element);
 void setClear(t_set * set);
 int setSize(t_set * set);
 int setIsEmpty(t_set * set);
-int setIsElementOf(t_set * set, unsigned int element);
+int setFirst(t_set * set);
+int setNext(t_set * set, int element);
+void setUnion(t_set * set, t_set * other);
+void setIntersection(t_set * set, t_set * other);
+void setDifference(t_set * set, t_set * other);
+int setIntersectionSize(t_set * set, t_set * other);
 void setFree(t_set * set);
 void setPrint(t_set * set);
-t_list * setGetElements(t_set * set);
 
-#endif
+static inline int setIsElementOf(t_set * set, unsigned int element) {
+
+	if (element >= (unsigned int) set->entries * SET_BITS_PER_ENTRY) return(0);
 
+	return((set->elements[element / SET_BITS_PER_ENTRY] >> (element % SET_BITS_PER_ENTRY)) & 1);
+}
+
+#endif
@@ -281,7 +281,8 @@ float simulationSimulate(t_graph * graph, t_array * paths) {
 	int * linkIndexBase;
 	t_graph * conflict;
 	t_array * path;
-	t_list * neighbors, * nodeQueue;
+	t_smallVec * neighbors;
+	t_list * nodeQueue;
 	t_list * waitingNodes, * onTransmissionPackets;
 	t_array * blockedLinks, * priorityBlockedLinks;
 	t_packet * newPacket, * packet, * codedPacket;
@@ -421,7 +422,7 @@ float simulationSimulate(t_graph * graph, t_array * paths) {
 			 * Block links.
 			 */
 			neighbors = graphGetNeighbors(conflict, simulationConflictNodeIndex(linkIndexBase, i, 0));
-			for (link = listBegin(neighbors); link; link = listNext(neighbors)) {
+			for (link = smallVecBegin(neighbors); link < smallVecEnd(neighbors); link++) {
 
 				arrayInc(blockedLinks, * link);
 			}
@@ -487,7 +488,7 @@ statePrint(state);
 				 * blocked.
 				 */
 				neighbors = graphGetNeighbors(conflict, simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop - 1));
-				for (link = listBegin(neighbors); link; link = listNext(neighbors)) {
+				for (link = smallVecBegin(neighbors); link < smallVecEnd(neighbors); link++) {
 
 					arrayDec(blockedLinks, * link);
 				}
@@ -583,7 +584,7 @@ printf("Node %d\n", node);
 				 * Place a block on the priorityBlock.
 				 */
 				neighbors = graphGetNeighbors(conflict, simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop));
-				for (link = listBegin(neighbors); link; link = listNext(neighbors)) {
+				for (link = smallVecBegin(neighbors); link < smallVecEnd(neighbors); link++) {
 
 					arrayInc(priorityBlockedLinks, * link);
 				}
@@ -611,7 +612,7 @@ printf("Node %d\n", node);
 				 * Place a block on the priorityBlock.
 				 */
 				neighbors = graphGetNeighbors(conflict, simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop));
-				for (link = listBegin(neighbors); link; link = listNext(neighbors)) {
+				for (link = smallVecBegin(neighbors); link < smallVecEnd(neighbors); link++) {
 
 					arrayInc(priorityBlockedLinks, * link);
 				}
@@ -649,7 +650,7 @@ printf("Node %d\n", node);
 			 */
 
 			neighbors = graphGetNeighbors(conflict, simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop));
-			for (link = listBegin(neighbors); link; link = listNext(neighbors)) {
+			for (link = smallVecBegin(neighbors); link < smallVecEnd(neighbors); link++) {
 
 				arrayInc(blockedLinks, * link);
 			}
@@ -695,7 +696,7 @@ printf("Node %d\n", node);
 				 */
 
 				neighbors = graphGetNeighbors(conflict, simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop));
-				for (link = listBegin(neighbors); link; link = listNext(neighbors)) {
+				for (link = smallVecBegin(neighbors); link < smallVecEnd(neighbors); link++) {
 
 					arrayInc(blockedLinks, * link);
 				}
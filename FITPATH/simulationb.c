@@ -249,7 +249,7 @@ float simulationSimulate(t_graph * graph, t_array * paths) {
 	int * linkIndexBase;
 	t_graph * conflict;
 	t_array * path;
-	t_list * neighbors;
+	t_smallVec * neighbors;
 	t_list * onBufferPackets, * onTransmissionPackets;
 	t_array * blockedLinks, * priorityBlockedLinks;
 	t_packet * newPacket, * packet, * codedPacket;
@@ -384,7 +384,7 @@ float simulationSimulate(t_graph * graph, t_array * paths) {
 			 * Block links.
 			 */
 			neighbors = graphGetNeighbors(conflict, simulationConflictNodeIndex(linkIndexBase, i, 0));
-			for (link = listBegin(neighbors); link; link = listNext(neighbors)) {
+			for (link = smallVecBegin(neighbors); link < smallVecEnd(neighbors); link++) {
 
 				arrayInc(blockedLinks, * link);
 			}
@@ -448,7 +448,7 @@ float simulationSimulate(t_graph * graph, t_array * paths) {
 				 * blocked.
 				 */
 				neighbors = graphGetNeighbors(conflict, simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop - 1));
-				for (link = listBegin(neighbors); link; link = listNext(neighbors)) {
+				for (link = smallVecBegin(neighbors); link < smallVecEnd(neighbors); link++) {
 
 					arrayDec(blockedLinks, * link);
 				}
@@ -530,7 +530,7 @@ float simulationSimulate(t_graph * graph, t_array * paths) {
 				 * Place a block on the priorityBlock.
 				 */
 				neighbors = graphGetNeighbors(conflict, simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop));
-				for (link = listBegin(neighbors); link; link = listNext(neighbors)) {
+				for (link = smallVecBegin(neighbors); link < smallVecEnd(neighbors); link++) {
 
 					arrayInc(priorityBlockedLinks, * link);
 				}
@@ -548,7 +548,7 @@ float simulationSimulate(t_graph * graph, t_array * paths) {
 				 * Place a block on the priorityBlock.
 				 */
 				neighbors = graphGetNeighbors(conflict, simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop));
-				for (link = listBegin(neighbors); link; link = listNext(neighbors)) {
+				for (link = smallVecBegin(neighbors); link < smallVecEnd(neighbors); link++) {
 
 					arrayInc(priorityBlockedLinks, * link);
 				}
@@ -576,7 +576,7 @@ float simulationSimulate(t_graph * graph, t_array * paths) {
 			 */
 
 			neighbors = graphGetNeighbors(conflict, simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop));
-			for (link = listBegin(neighbors); link; link = listNext(neighbors)) {
+			for (link = smallVecBegin(neighbors); link < smallVecEnd(neighbors); link++) {
 
 				arrayInc(blockedLinks, * link);
 			}
@@ -621,7 +621,7 @@ float simulationSimulate(t_graph * graph, t_array * paths) {
 				 */
 
 				neighbors = graphGetNeighbors(conflict, simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop));
-				for (link = listBegin(neighbors); link; link = listNext(neighbors)) {
+				for (link = smallVecBegin(neighbors); link < smallVecEnd(neighbors); link++) {
 
 					arrayInc(blockedLinks, * link);
 				}
@@ -242,7 +242,7 @@ float simulationSimulate(t_graph * graph, t_array * paths) {
 	int * linkIndexBase;
 	t_graph * conflict;
 	t_array * path;
-	t_list * neighbors;
+	t_smallVec * neighbors;
 	t_list * onBufferPackets, * onTransmissionPackets;
 	t_array * blockedLinks, * priorityBlockedLinks;
 	t_packet * newPacket, * packet, * codedPacket;
@@ -376,7 +376,7 @@ float simulationSimulate(t_graph * graph, t_array * paths) {
 			 * Block links.
 			 */
 			neighbors = graphGetNeighbors(conflict, simulationConflictNodeIndex(linkIndexBase, i, 0));
-			for (link = listBegin(neighbors); link; link = listNext(neighbors)) {
+			for (link = smallVecBegin(neighbors); link < smallVecEnd(neighbors); link++) {
 
 				arrayInc(blockedLinks, * link);
 			}
@@ -440,7 +440,7 @@ float simulationSimulate(t_graph * graph, t_array * paths) {
 				 * blocked.
 				 */
 				neighbors = graphGetNeighbors(conflict, simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop - 1));
-				for (link = listBegin(neighbors); link; link = listNext(neighbors)) {
+				for (link = smallVecBegin(neighbors); link < smallVecEnd(neighbors); link++) {
 
 					arrayDec(blockedLinks, * link);
 				}
@@ -522,7 +522,7 @@ float simulationSimulate(t_graph * graph, t_array * paths) {
 				 * Place a block on the priorityBlock.
 				 */
 				neighbors = graphGetNeighbors(conflict, simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop));
-				for (link = listBegin(neighbors); link; link = listNext(neighbors)) {
+				for (link = smallVecBegin(neighbors); link < smallVecEnd(neighbors); link++) {
 
 					arrayInc(priorityBlockedLinks, * link);
 				}
@@ -540,7 +540,7 @@ float simulationSimulate(t_graph * graph, t_array * paths) {
 				 * Place a block on the priorityBlock.
 				 */
 				neighbors = graphGetNeighbors(conflict, simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop));
-				for (link = listBegin(neighbors); link; link = listNext(neighbors)) {
+				for (link = smallVecBegin(neighbors); link < smallVecEnd(neighbors); link++) {
 
 					arrayInc(priorityBlockedLinks, * link);
 				}
@@ -568,7 +568,7 @@ float simulationSimulate(t_graph * graph, t_array * paths) {
 			 */
 
 			neighbors = graphGetNeighbors(conflict, simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop));
-			for (link = listBegin(neighbors); link; link = listNext(neighbors)) {
+			for (link = smallVecBegin(neighbors); link < smallVecEnd(neighbors); link++) {
 
 				arrayInc(blockedLinks, * link);
 			}
@@ -613,7 +613,7 @@ float simulationSimulate(t_graph * graph, t_array * paths) {
 				 */
 
 				neighbors = graphGetNeighbors(conflict, simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop));
-				for (link = listBegin(neighbors); link; link = listNext(neighbors)) {
+				for (link = smallVecBegin(neighbors); link < smallVecEnd(neighbors); link++) {
 
 					arrayInc(blockedLinks, * link);
 				}
@@ -279,7 +279,8 @@ float simulationSimulate(t_graph * graph, t_array * paths) {
 	int * linkIndexBase;
 	t_graph * conflict;
 	t_array * path;
-	t_list * neighbors, * nodeQueue;
+	t_smallVec * neighbors;
+	t_list * nodeQueue;
 	t_list * waitingNodes, * onTransmissionPackets;
 	t_array * blockedLinks, * priorityBlockedLinks;
 	t_packet * newPacket, * packet, * codedPacket;
@@ -444,7 +445,7 @@ printf("\n");
 			 * Block links.
 			 */
 			neighbors = graphGetNeighbors(conflict, simulationConflictNodeIndex(linkIndexBase, i, 0));
-			for (link = listBegin(neighbors); link; link = listNext(neighbors)) {
+			for (link = smallVecBegin(neighbors); link < smallVecEnd(neighbors); link++) {
 
 				arrayInc(blockedLinks, * link);
 			}
@@ -520,7 +521,7 @@ printf("\n");
 				 * blocked.
 				 */
 				neighbors = graphGetNeighbors(conflict, simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop - 1));
-				for (link = listBegin(neighbors); link; link = listNext(neighbors)) {
+				for (link = smallVecBegin(neighbors); link < smallVecEnd(neighbors); link++) {
 
 					arrayDec(blockedLinks, * link);
 				}
@@ -618,7 +619,7 @@ printf("\n");
 				 * Place a block on the priorityBlock.
 				 */
 				neighbors = graphGetNeighbors(conflict, simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop));
-				for (link = listBegin(neighbors); link; link = listNext(neighbors)) {
+				for (link = smallVecBegin(neighbors); link < smallVecEnd(neighbors); link++) {
 
 					arrayInc(priorityBlockedLinks, * link);
 				}
@@ -647,7 +648,7 @@ printf("\n");
 				 * Place a block on the priorityBlock.
 				 */
 				neighbors = graphGetNeighbors(conflict, simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop));
-				for (link = listBegin(neighbors); link; link = listNext(neighbors)) {
+				for (link = smallVecBegin(neighbors); link < smallVecEnd(neighbors); link++) {
 
 					arrayInc(priorityBlockedLinks, * link);
 				}
@@ -686,7 +687,7 @@ printf("\n");
 			 */
 
 			neighbors = graphGetNeighbors(conflict, simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop));
-			for (link = listBegin(neighbors); link; link = listNext(neighbors)) {
+			for (link = smallVecBegin(neighbors); link < smallVecEnd(neighbors); link++) {
 
 				arrayInc(blockedLinks, * link);
 			}
@@ -732,7 +733,7 @@ printf("\n");
 				 */
 
 				neighbors = graphGetNeighbors(conflict, simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop));
-				for (link = listBegin(neighbors); link; link = listNext(neighbors)) {
+				for (link = smallVecBegin(neighbors); link < smallVecEnd(neighbors); link++) {
 
 					arrayInc(blockedLinks, * link);
 				}
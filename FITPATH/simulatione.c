@@ -298,7 +298,8 @@ float simulationSimulate(t_graph * graph, t_array * paths) {
 	int * linkIndexBase;
 	t_graph * conflict;
 	t_array * path;
-	t_list * neighbors, * nodeQueue;
+	t_smallVec * neighbors;
+	t_list * nodeQueue;
 	t_list * waitingNodes, * onTransmissionPackets;
 	t_array * blockedLinks, * priorityBlockedLinks;
 	t_packet * newPacket, * packet, * codedPacket;
@@ -483,7 +484,7 @@ float simulationSimulate(t_graph * graph, t_array * paths) {
 			 * Block links.
 			 */
 			neighbors = graphGetNeighbors(conflict, simulationConflictNodeIndex(linkIndexBase, i, 0));
-			for (link = listBegin(neighbors); link; link = listNext(neighbors)) {
+			for (link = smallVecBegin(neighbors); link < smallVecEnd(neighbors); link++) {
 
 				arrayInc(blockedLinks, * link);
 			}
@@ -562,7 +563,7 @@ printf("At time %d, Packet just arrived at hop %d for flow %d\n", time, packet->
 				 * blocked.
 				 */
 				neighbors = graphGetNeighbors(conflict, simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop - 1));
-				for (link = listBegin(neighbors); link; link = listNext(neighbors)) {
+				for (link = smallVecBegin(neighbors); link < smallVecEnd(neighbors); link++) {
 
 					arrayDec(blockedLinks, * link);
 				}
@@ -660,7 +661,7 @@ printf("Packet just delivered for flow %d\n", packet->flow);
 				 * Place a block on the priorityBlock.
 				 */
 				neighbors = graphGetNeighbors(conflict, simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop));
-				for (link = listBegin(neighbors); link; link = listNext(neighbors)) {
+				for (link = smallVecBegin(neighbors); link < smallVecEnd(neighbors); link++) {
 
 					arrayInc(priorityBlockedLinks, * link);
 				}
@@ -689,7 +690,7 @@ printf("Packet just delivered for flow %d\n", packet->flow);
 				 * Place a block on the priorityBlock.
 				 */
 				neighbors = graphGetNeighbors(conflict, simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop));
-				for (link = listBegin(neighbors); link; link = listNext(neighbors)) {
+				for (link = smallVecBegin(neighbors); link < smallVecEnd(neighbors); link++) {
 
 					arrayInc(priorityBlockedLinks, * link);
 				}
@@ -728,7 +729,7 @@ printf("Packet just delivered for flow %d\n", packet->flow);
 			 */
 
 			neighbors = graphGetNeighbors(conflict, simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop));
-			for (link = listBegin(neighbors); link; link = listNext(neighbors)) {
+			for (link = smallVecBegin(neighbors); link < smallVecEnd(neighbors); link++) {
 
 				arrayInc(blockedLinks, * link);
 			}
@@ -780,7 +781,7 @@ printf("Packet just delivered for flow %d\n", packet->flow);
 				 */
 
 				neighbors = graphGetNeighbors(conflict, simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop));
-				for (link = listBegin(neighbors); link; link = listNext(neighbors)) {
+				for (link = smallVecBegin(neighbors); link < smallVecEnd(neighbors); link++) {
 
 					arrayInc(blockedLinks, * link);
 				}
@@ -1,29 +1,87 @@
+#define _GNU_SOURCE
 #define _ISOC99_SOURCE
 #include <math.h>
 #include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <time.h>
 
 //#include <sys/times.h>
 
 #include "simulationh2.h"
 #include "memory.h"
 #include "list.h"
+#include "slabList.h"
 #include "graph.h"
 #include "array.h"
+#include "intVec.h"
 #include "stack.h"
 #include "stateh2.h"
+#include "linkTable.h"
+
+/*
+ * Traffic model, chosen at compile time. By default each flow sends a
+ * packet every flow time (CBR). Built with SIMULATION_VBR (the object
+ * simulationhvbr.o), each flow replays the bursts of its Evalvid trace
+ * instead, and its flow time is only the time of its first packet.
+ */
+#ifdef SIMULATION_VBR
+#include "vbrTrace.h"
+
+typedef t_vbrCursor t_traffic;
+
+static inline void trafficInit(t_traffic * traffic, int flow) {
+
+	if (!vbrFlowTrace(flow)) {
+
+		fprintf(stderr, "No VBR trace set for flow %d\n", flow);
+		exit(1);
+	}
+	vbrCursorInit(traffic, vbrFlowTrace(flow));
+}
+
+static inline long trafficNext(t_traffic * traffic, const t_intVec * flowTimes, int flow) {
+
+	return(vbrCursorNext(traffic));
+}
+
+static inline long trafficPosition(const t_traffic * traffic) {
+
+	return((((long) traffic->burst) << 32) | traffic->packetsLeft);
+}
+#else
+typedef char t_traffic;
+
+static inline void trafficInit(t_traffic * traffic, int flow) {
+
+}
+
+static inline long trafficNext(t_traffic * traffic, const t_intVec * flowTimes, int flow) {
+
+	return(intVecGet(flowTimes, flow));
+}
+
+static inline long trafficPosition(const t_traffic * traffic) {
+
+	return(0);
+}
+#endif
 
 typedef struct {
 
-	t_list * packets;
-	t_array * individualFlowCounts;
+	t_slabList packets;		// packets.slab is NULL until the node is added.
+	t_intVec individualFlowCounts;
 } t_local_queue;
 
 typedef struct {
 
 	t_local_queue * localQueue;
-	t_list * activeNodes;
+	t_slab slab;
+	t_smallVec activeNodes;
 	int numberOfNodes;
 	int queueLimit;
+	unsigned long droppedPackets;
+	int * maxDepth;
 } t_queues;
 
 typedef struct {
@@ -37,6 +95,7 @@ typedef struct {
 	int maxRetries;
 	double deliveryProbability;
 	t_weight waitingSince;
+	t_slabNode * queueNode;		// Where the packet is in its node's queue.
 } t_packet;
 
 int simulationConflictNodeIndex(int * linkIndexBase, int pathIndex, int linkIndex) {
@@ -44,6 +103,21 @@ int simulationConflictNodeIndex(int * linkIndexBase, int pathIndex, int linkInde
 	return(linkIndexBase[pathIndex] + linkIndex);
 }
 
+/*
+ * A link makes at most 4 attempts (see linkTableCompute), so a packet
+ * goes through at most 4 backoffs on each hop.
+ */
+#define SIMULATION_BACKOFF_STAGES	4
+
+/*
+ * Backoff before attempt 'retries' (0 for the first) on the hop with
+ * conflict node index 'link', in simulation time units.
+ */
+static inline t_weight simulationBackoff(t_weight * backoffTicks, int link, int retries) {
+
+	return(backoffTicks[link * SIMULATION_BACKOFF_STAGES + retries]);
+}
+
 t_queues * queuesNew(int numberOfNodes, int queueLimit) {
 
 	t_queues * queues;
@@ -52,10 +126,14 @@ t_queues * queuesNew(int numberOfNodes, int queueLimit) {
 	MALLOC(queues->localQueue, numberOfNodes * sizeof(t_local_queue));
 	memset(queues->localQueue, 0, numberOfNodes * sizeof(t_local_queue));
 
-	queues->activeNodes = listNew();
+	slabInit(& queues->slab);
+	smallVecInit(& queues->activeNodes);
 
 	queues->numberOfNodes = numberOfNodes;
 	queues->queueLimit = queueLimit;
+	queues->droppedPackets = 0;
+	MALLOC(queues->maxDepth, numberOfNodes * sizeof(int));
+	memset(queues->maxDepth, 0, numberOfNodes * sizeof(int));
 
 	//printf("queueLimit %d\n",queueLimit);
 
@@ -64,85 +142,88 @@ t_queues * queuesNew(int numberOfNodes, int queueLimit) {
 
 void queuesAddNode(t_queues * queues, unsigned long node, unsigned long nflows) {
 
-	if (queues->localQueue[node].packets) return;
+	if (queues->localQueue[node].packets.slab) return;
 
-	queues->localQueue[node].packets = listNew();
-	queues->localQueue[node].individualFlowCounts = arrayNew(nflows);
-	arrayClear(queues->localQueue[node].individualFlowCounts);
+	slabListInit(& queues->localQueue[node].packets, & queues->slab);
+	intVecInit(& queues->localQueue[node].individualFlowCounts, nflows);
 
-	/*
-	 * Avoid 0, as it would be confusing with NULL (end of list).
-	 */
-	listAdd(queues->activeNodes, (void *) (node + 1));
+	smallVecAdd(& queues->activeNodes, node);
 }
 
-t_list * queuesActiveNodes(t_queues * queues) {
+t_smallVec * queuesActiveNodes(t_queues * queues) {
 
-	return(queues->activeNodes);
+	return(& queues->activeNodes);
 }
 
-void queuesAddPaths(t_queues * queues, t_array * paths) {
+void queuesAddPaths(t_queues * queues, t_u16Path * paths, int numberOfPaths) {
 
-	int numberOfPaths, numberOfNodes;
+	int numberOfNodes;
 	int i, j;
-	t_array * path;
-
-	numberOfPaths = arrayLength(paths);
+	t_u16Path * path;
 
 	for (i = 0; i < numberOfPaths; i++) {
 
-		path = arrayGet(paths, i);
-		numberOfNodes = arrayLength(path) - 1;
+		path = & paths[i];
+		numberOfNodes = u16PathLength(path) - 1;
 
 		for (j = 0; j < numberOfNodes; j++) {
 
-			queuesAddNode(queues, (unsigned long) arrayGet(path, j), numberOfPaths);
+			queuesAddNode(queues, u16PathNode(path, j), numberOfPaths);
 		}
 	}
 }
 
 void queuesFree(t_queues * queues) {
 
-	unsigned long i;
+	int * node;
 
-	for (i = (unsigned long) listBegin(queues->activeNodes);
-		i; i = (unsigned long) listNext(queues->activeNodes)) {
+	for (node = smallVecBegin(& queues->activeNodes); node < smallVecEnd(& queues->activeNodes); node++) {
 
-		listFreeWithData(queues->localQueue[i-1].packets);
-		free(queues->localQueue[i-1].packets);
-		arrayFree(queues->localQueue[i-1].individualFlowCounts);
-		free(queues->localQueue[i-1].individualFlowCounts);
+		slabListFreeWithData(& queues->localQueue[* node].packets);
+		intVecFree(& queues->localQueue[* node].individualFlowCounts);
 	}
 	free(queues->localQueue);
-	listFree(queues->activeNodes);
-	free(queues->activeNodes);
+	free(queues->maxDepth);
+	slabFree(& queues->slab);
+	smallVecFree(& queues->activeNodes);
 }
 
 int queuesSize(t_queues * queues, int node) {
 
-	return(listLength(queues->localQueue[node].packets));
+	return(slabListLength(& queues->localQueue[node].packets));
 }
 
 t_packet * queuesFirst(t_queues * queues, int node) {
 
-	return(listBegin(queues->localQueue[node].packets));
+	t_slabNode * first;
+
+	first = slabListFirst(& queues->localQueue[node].packets);
+	if (first == NULL) return(NULL);
+
+	return(slabNodeData(first));
 }
 
 void queuesAddPacket(t_queues * queues, t_packet * packet, int node) {
 
+	t_slabList * nodeQueue;
+	t_slabNode * queueNode;
 	t_packet * last;
 
-	//printf("Queue Size: %ld\n",(unsigned long) arrayGet(queues->localQueue[node].individualFlowCounts, packet->flow));
+	nodeQueue = & queues->localQueue[node].packets;
+
+	//printf("Queue Size: %ld\n",intVecGet(& queues->localQueue[node].individualFlowCounts, packet->flow));
 
 //#ifdef OLD
-	if ((unsigned long) arrayGet(queues->localQueue[node].individualFlowCounts, packet->flow) == queues->queueLimit) {
+	if (intVecGet(& queues->localQueue[node].individualFlowCounts, packet->flow) == queues->queueLimit) {
 
-		for (last = listEnd(queues->localQueue[node].packets); last; last = listPrev(queues->localQueue[node].packets)) {
+		for (queueNode = slabListLast(nodeQueue); queueNode; queueNode = slabNodePrev(queueNode)) {
 
+			last = slabNodeData(queueNode);
 			if (last->flow == packet->flow) {
 //printf("Discarding packet from flow %d at node %d due to overflow\n", last->flow, node);
-				listDelCurrent(queues->localQueue[node].packets);
+				slabListDel(nodeQueue, queueNode);
 				free(last);
+				queues->droppedPackets++;
 				break ;
 			}
 		}
@@ -151,29 +232,32 @@ void queuesAddPacket(t_queues * queues, t_packet * packet, int node) {
 	}
 	else {
 
-		arrayInc(queues->localQueue[node].individualFlowCounts, packet->flow);
+		intVecInc(& queues->localQueue[node].individualFlowCounts, packet->flow);
 	}
 //#endif
 #ifdef DROPTAIL
-	if (listLength(queues->localQueue[node].packets) == queues->queueLimit) {
+	if (slabListLength(nodeQueue) == queues->queueLimit) {
 
-		last = listEnd(queues->localQueue[node].packets);
-		listDelCurrent(queues->localQueue[node].packets);
+		last = slabNodeData(slabListLast(nodeQueue));
+		slabListDel(nodeQueue, slabListLast(nodeQueue));
 		free(last);
+		queues->droppedPackets++;
 	}
 #endif
-	listAdd(queues->localQueue[node].packets, packet);
+	packet->queueNode = slabListAdd(nodeQueue, packet);
+	if (slabListLength(nodeQueue) > queues->maxDepth[node])
+		queues->maxDepth[node] = slabListLength(nodeQueue);
 }
 
 void queuesDelPacket(t_queues * queues, t_packet * packet, int node) {
 
-	arrayDec(queues->localQueue[node].individualFlowCounts, packet->flow);
-	listDel(queues->localQueue[node].packets, packet);
+	intVecDec(& queues->localQueue[node].individualFlowCounts, packet->flow);
+	slabListDel(& queues->localQueue[node].packets, packet->queueNode);
 }
 
-t_list * queuesNodeQueue(t_queues * queues, int node) {
+t_slabList * queuesNodeQueue(t_queues * queues, int node) {
 
-	return(queues->localQueue[node].packets);
+	return(& queues->localQueue[node].packets);
 }
 
 /*
@@ -182,23 +266,26 @@ t_list * queuesNodeQueue(t_queues * queues, int node) {
  * be coded together.
  * This condition can be overcome by inserting a heavier processing.
  */
-t_packet * queuesFindCodingPartner(t_graph * graph, t_queues * queues, t_packet * packet, t_array * paths, int node,
-									t_array * blockedLinks, t_array * priorityBlockedLinks, 
+t_packet * queuesFindCodingPartner(t_graph * graph, t_queues * queues, t_packet * packet, t_u16Path * paths, int node,
+									t_intVec * blockedLinks, t_intVec * priorityBlockedLinks, 
 									int * linkIndexBase,
 									double * successProb1,
 									double * successProb2) {
 return(NULL);
 	t_packet * p;
-	t_list * nodeQueue;
+	t_slabList * nodeQueue;
+	t_slabNode * queueNode;
 	unsigned long prevHopP1, prevHopP2, nextHopP1, nextHopP2;
 //printf("Trying to find coding partner at node %d\n", node);
 	if (packet->currentHop == 0) return(NULL);
 //printf("Current hop is not 0. Continuing...\n");
-	prevHopP1 = (unsigned long) arrayGet(arrayGet(paths, packet->flow), packet->currentHop - 1);
-	nextHopP1 = (unsigned long) arrayGet(arrayGet(paths, packet->flow), packet->currentHop + 1);
+	prevHopP1 = u16PathNode(& paths[packet->flow], packet->currentHop - 1);
+	nextHopP1 = u16PathNode(& paths[packet->flow], packet->currentHop + 1);
 
-	nodeQueue = queues->localQueue[node].packets;
-	for (p = listBegin(nodeQueue); p; p = listNext(nodeQueue)) {
+	nodeQueue = & queues->localQueue[node].packets;
+	for (queueNode = slabListFirst(nodeQueue); queueNode; queueNode = slabNodeNext(queueNode)) {
+
+		p = slabNodeData(queueNode);
 //printf("Evaluating packet %p\n", p);
 		if (p == packet) continue ;
 
@@ -206,7 +293,7 @@ return(NULL);
 		if (p->currentHop == 0) continue ;
 //printf("Not in its first hop\n");
 
-		prevHopP2 = (unsigned long) arrayGet(arrayGet(paths, p->flow), p->currentHop - 1);
+		prevHopP2 = u16PathNode(& paths[p->flow], p->currentHop - 1);
 		if (prevHopP2 != nextHopP1)
 			* successProb1 = sqrt((double) GRAPH_MULTIPLIER / (double) graphGetCost(graph, prevHopP2, nextHopP1));
 		else
@@ -214,17 +301,17 @@ return(NULL);
 		if (* successProb1 < 0.8) continue ;
 		//printf("Previous hop match 1\n");
 
-		nextHopP2 = (unsigned long) arrayGet(arrayGet(paths, p->flow), p->currentHop + 1);
+		nextHopP2 = u16PathNode(& paths[p->flow], p->currentHop + 1);
 		if (prevHopP1 != nextHopP2)
 			* successProb2 = sqrt((double) GRAPH_MULTIPLIER / (double) graphGetCost(graph, prevHopP1, nextHopP2));
 		else
 			* successProb2 = 1;
 		if (* successProb2 < 0.8) continue ;
 
-		if (arrayGet(blockedLinks, simulationConflictNodeIndex(linkIndexBase, p->flow, p->currentHop))) continue ;
+		if (intVecGet(blockedLinks, simulationConflictNodeIndex(linkIndexBase, p->flow, p->currentHop))) continue ;
 //printf("Packet is not blocked\n");
 
-		if (arrayGet(priorityBlockedLinks, simulationConflictNodeIndex(linkIndexBase, p->flow, p->currentHop))) continue ;
+		if (intVecGet(priorityBlockedLinks, simulationConflictNodeIndex(linkIndexBase, p->flow, p->currentHop))) continue ;
 //printf("Packet is not priority blocked\n");
 
 		return(p);
@@ -233,38 +320,38 @@ return(NULL);
 	return(NULL);
 }
 
-t_graph * simulationConflictGraph(t_graph * graph, t_array * paths, int * linkIndexBase) {
+t_graph * simulationConflictGraph(t_graph * graph, t_u16Path * paths, int numberOfPaths, int * linkIndexBase) {
 
 	t_graph * conflict;
-	t_array * path1, * path2;
+	t_u16Path * path1, * path2;
 	int numberOfLinks;
 	int i, j, k, l;
 	long head1, head2, tail1, tail2;
 
 	numberOfLinks = 0;
-	for (i = 0; i < arrayLength(paths); i++) {
+	for (i = 0; i < numberOfPaths; i++) {
 
-		path1 = arrayGet(paths, i);
+		path1 = & paths[i];
 		linkIndexBase[i] = numberOfLinks;
-		numberOfLinks += (arrayLength(path1) - 1);
+		numberOfLinks += (u16PathLength(path1) - 1);
 	}
 
 	conflict = graphNew(numberOfLinks);
 
-	for (i = 0; i < arrayLength(paths); i++) {
+	for (i = 0; i < numberOfPaths; i++) {
 
-		path1 = arrayGet(paths, i);
-		for (j = 0; j < arrayLength(path1) - 1; j++) {
+		path1 = & paths[i];
+		for (j = 0; j < u16PathLength(path1) - 1; j++) {
 
-			head1 = (long) arrayGet(path1, j);
-			tail1 = (long) arrayGet(path1, j+1);
-			for (k = i; k < arrayLength(paths); k++) {
+			head1 = u16PathNode(path1, j);
+			tail1 = u16PathNode(path1, j+1);
+			for (k = i; k < numberOfPaths; k++) {
 
-				path2 = arrayGet(paths, k);
-				for (l = (k == i) ? j : 0; l < arrayLength(path2) - 1; l++) {
+				path2 = & paths[k];
+				for (l = (k == i) ? j : 0; l < u16PathLength(path2) - 1; l++) {
 
-					head2 = (long) arrayGet(path2, l);
-					tail2 = (long) arrayGet(path2, l+1);
+					head2 = u16PathNode(path2, l);
+					tail2 = u16PathNode(path2, l+1);
 #define CONFLICT_LIMIAR		(GRAPH_MULTIPLIER / 0.01)
 //#define CONFLICT_LIMIAR		GRAPH_INFINITY
 					if (graphGetCost(graph, head1, head2) < CONFLICT_LIMIAR) {
@@ -329,6 +416,60 @@ t_graph * simulationConflictGraph(t_graph * graph, t_array * paths, int * linkIn
 #define STATE_HASH_SIZE		(1 << 24)
 //#define STATE_HASH_SIZE		8388608
 
+#ifdef CYCLE_BRENT
+static t_cycleDetection cycleDetection = SIMULATION_CYCLE_BRENT;
+#else
+static t_cycleDetection cycleDetection = SIMULATION_CYCLE_HASH;
+#endif
+
+/*
+ * Select how repeated states are found. SIMULATION_CYCLE_HASH keeps
+ * every saved state in a hash table; SIMULATION_CYCLE_BRENT keeps a
+ * single checkpoint (Brent's algorithm) and bounds memory per simulation.
+ */
+void simulationSetCycleDetection(t_cycleDetection mode) {
+
+	cycleDetection = mode;
+}
+
+/*
+ * Whether simulations fill t_return's stats.
+ */
+static int collectStats = 0;
+
+void simulationSetStats(int enabled) {
+
+	collectStats = enabled;
+}
+
+static double simulationElapsed(struct timespec * start, struct timespec * end) {
+
+	return((end->tv_sec - start->tv_sec) + (end->tv_nsec - start->tv_nsec) / 1e9);
+}
+
+/*
+ * Store the state and look for a previous equal one, using the
+ * selected cycle detection.
+ */
+static t_state * simulationLookupAndStore(t_state * state, t_stateStorage * stateStorage, t_stateCycle * stateCycle) {
+
+	if (stateCycle) return(stateCycleLookupAndStore(state, stateCycle));
+
+	return(stateLookupAndStore(state, stateStorage));
+}
+
+/*
+ * Record in the state, for each flow, the time to its next packet
+ * and its position in its traffic.
+ */
+static void simulationSetArrivals(t_state * state, t_longVec * scheduleFlowTime, t_traffic * traffic, int numberOfFlows) {
+
+	int i;
+
+	for (i = 0; i < numberOfFlows; i++)
+		stateSetArrival(state, i, longVecGet(scheduleFlowTime, i), trafficPosition(& traffic[i]));
+}
+
 void printPaths(t_array * paths) {
 
 	t_array * path;
@@ -350,48 +491,58 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 
 	int * linkIndexBase;
 	t_graph * conflict;
-	t_array * path;
-	t_array * backoff;
-	t_list * neighbors, * nodeQueue;
-	t_list * waitingNodes, * onTransmissionPackets;
-	t_array * blockedLinks, * priorityBlockedLinks, * priorityBlockedNodes;
+	t_u16Path * flowPaths, * path;
+	t_intVec intFlowTimes, intTxDurations;
+	t_packet ** backoff;
+	t_smallVec * neighbors;
+	t_slabList * nodeQueue;
+	t_slab slab;
+	t_slabList waitingNodes, onTransmissionPackets;
+	t_slabNode * listNode, * nextNode, * transmission;
+	t_intVec blockedLinks, priorityBlockedLinks, priorityBlockedNodes;
 	t_packet * newPacket, * packet, * codedPacket, * otherPacket;
 	t_state * oldState, * state;
-	t_stateStorage * stateStorage;
-	t_array * deliveredPacketsFlows;
+	t_stateStorage * stateStorage = NULL;
+	t_stateCycle * stateCycle = NULL;
+	t_intVec deliveredPacketsFlows;
 	t_weight time, oldTime, delta, oldDelta;
-	int i, j, k;
+	int i, j, k, l;
 	int * link;
 	double deliveredPackets, oldDeliveredPackets;
 	int slots;
 	int numberOfFlows;
 	long node, lastNode, node2;
-	int * nodep;
+	int * nodep, numberOfNeighbors;
 	float meanInterval, oldMeanInterval, meanTime, meanDelivery;
 	t_queues * queues;
 	int lookAhead = 1;
 	int maxDeliveredPerFlow = 100;
 	float alfa = 0.8;
-	double tmp;
 	int maxFlowsPerNode = 0;
-	t_array * flowsPerNode;
+	t_intVec flowsPerNode;
 	int haveToSaveState;
 	int numberOfStates = 1;
 	//float slotTime = 0.00002; //20us
 	float slotTime = 0.000009; //9us
 	//float txTime = frameTxDuration; //12ms
 	//float txTime = 0.012; //12ms
-	t_weight * airTime;
-	double * backoffUnit;
-	unsigned char * numberOfRetries;
+	t_linkTable * linkTable;
+	t_linkParams ** hopLink;
+	t_weight * backoffTicks;
 	int numberOfLinks = 0;
 	double successProb1, successProb2;
 	t_weight targetTime = GRAPH_INFINITY;
-	t_list * activeNodes;
-	t_array * scheduleFlowTime;
+	t_smallVec * activeNodes;
+	int * activeNode;
+	t_longVec scheduleFlowTime;
+	t_traffic * traffic;
 	int scheduleTime;
-	t_array * idPacketFlows, * delayFlows;
-	t_array * permanentDeliveredPacketsFlows, * permanentSentPacketsFlows;
+	t_longVec idPacketFlows, delayFlows;
+	t_longVec permanentDeliveredPacketsFlows, permanentSentPacketsFlows;
+	struct timespec setupStart, loopStart, loopEnd, teardownEnd;
+	unsigned long iterations = 0, statesSaved = 0, cycleStates = 0;
+	t_weight cycleTime = 0;
+	int timedOut = 0;
 	
 	t_return * r;
 
@@ -399,24 +550,32 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 		  * meanIntervalPerFlow, * oldMeanIntervalPerFlow, * meanSentPerFlow, * oldSentPacketsPerFlow, * meanDelayFlows, * oldDelayFlows;
 
 
+	if (collectStats) clock_gettime(CLOCK_MONOTONIC, & setupStart);
+
 	numberOfFlows = arrayLength(paths);
 
-	scheduleFlowTime = arrayNew(numberOfFlows);
+	/*
+	 * The main loop reads paths and per flow parameters at every
+	 * event, so they are unboxed into typed vectors once here.
+	 */
+	MALLOC(flowPaths, sizeof(t_u16Path) * numberOfFlows);
+	intVecInit(& intFlowTimes, numberOfFlows);
+	intVecInit(& intTxDurations, numberOfFlows);
+	for (i = 0; i < numberOfFlows; i++) {
 
-	deliveredPacketsFlows = arrayNew(numberOfFlows);
-	for (i = 0; i < numberOfFlows; i++) arraySet(deliveredPacketsFlows, i, 0);
+		u16PathInit(& flowPaths[i], arrayGet(paths, i));
+		intVecSet(& intFlowTimes, i, (long) arrayGet(flowTimes, i));
+		intVecSet(& intTxDurations, i, (long) arrayGet(frameTxDurations, i));
+	}
 
-	idPacketFlows = arrayNew(numberOfFlows);
-	for (i = 0; i < numberOfFlows; i++) arraySet(idPacketFlows, i, 0);
+	longVecInit(& scheduleFlowTime, numberOfFlows);
+	MALLOC(traffic, sizeof(t_traffic) * numberOfFlows);
 
-	permanentDeliveredPacketsFlows = arrayNew(numberOfFlows);
-	for (i = 0; i < numberOfFlows; i++) arraySet(permanentDeliveredPacketsFlows, i, 0);
-	
-	delayFlows = arrayNew(numberOfFlows);
-	for (i = 0; i < numberOfFlows; i++) arraySet(delayFlows, i, 0);
-	
-	permanentSentPacketsFlows = arrayNew(numberOfFlows);
-	for (i = 0; i < numberOfFlows; i++) arraySet(permanentSentPacketsFlows, i, 0);
+	intVecInit(& deliveredPacketsFlows, numberOfFlows);
+	longVecInit(& idPacketFlows, numberOfFlows);
+	longVecInit(& permanentDeliveredPacketsFlows, numberOfFlows);
+	longVecInit(& delayFlows, numberOfFlows);
+	longVecInit(& permanentSentPacketsFlows, numberOfFlows);
 
 	MALLOC(deliveredPacketsPerFlow, sizeof(float) * numberOfFlows);
 	MALLOC(oldDeliveredPacketsPerFlow, sizeof(float) * numberOfFlows);
@@ -442,75 +601,84 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 		oldDelayFlows[i] = 0.0f;
 	}
 
-	flowsPerNode = arrayNew(graphSize(graph));
-	arrayClear(flowsPerNode);
+	intVecInit(& flowsPerNode, graphSize(graph));
 	for (i = 0; i < numberOfFlows; i++) {
-		//printf("Flow %d - FlowTime=%d FrameTxDuration=%d ms\n" , i, (int) arrayGet(flowTimes, i), (int) arrayGet(frameTxDurations, i));
-		arraySet(scheduleFlowTime,i,arrayGet(flowTimes, i));
+		//printf("Flow %d - FlowTime=%d FrameTxDuration=%d ms\n" , i, (int) intVecGet(& intFlowTimes, i), (int) intVecGet(& intTxDurations, i));
+		longVecSet(& scheduleFlowTime, i, intVecGet(& intFlowTimes, i));
+		trafficInit(& traffic[i], i);
 
-		node = (long) arrayGet(arrayGet(paths, i), 0);
-		arrayInc(flowsPerNode, node);
-		if ((long) arrayGet(flowsPerNode, node) > maxFlowsPerNode) maxFlowsPerNode = (long) arrayGet(flowsPerNode, node);
+		node = u16PathNode(& flowPaths[i], 0);
+		intVecInc(& flowsPerNode, node);
+		if (intVecGet(& flowsPerNode, node) > maxFlowsPerNode) maxFlowsPerNode = intVecGet(& flowsPerNode, node);
 
-		numberOfLinks += (arrayLength(arrayGet(paths, i)) - 1);
+		numberOfLinks += (u16PathLength(& flowPaths[i]) - 1);
 	}
 
-	arrayFree(flowsPerNode);
-	free(flowsPerNode);
+	intVecFree(& flowsPerNode);
 
-	MALLOC(airTime, sizeof(t_weight) * numberOfLinks);
-	MALLOC(numberOfRetries, sizeof(unsigned char) * numberOfLinks);
-	MALLOC(backoffUnit, sizeof(double) * numberOfLinks);
+	/*
+	 * Per-hop MAC parameters come from the graph's link table,
+	 * which is built once and shared by every simulation.
+	 */
+	linkTable = linkTableGet(graph);
+	MALLOC(hopLink, sizeof(t_linkParams *) * numberOfLinks);
+	MALLOC(backoffTicks, sizeof(t_weight) * numberOfLinks * SIMULATION_BACKOFF_STAGES);
 	k = 0;
 	for (i = 0; i < numberOfFlows; i++) {
 
-		for (j = 1; j < arrayLength(arrayGet(paths, i)); j++) {
-
-			lastNode = (long) arrayGet(arrayGet(paths, i), j - 1);
-			node = (long) arrayGet(arrayGet(paths, i), j);
-			tmp = (double) GRAPH_MULTIPLIER / (double) graphGetCost(graph, lastNode, node);
-			airTime[k] = GRAPH_MULTIPLIER * ((tmp * (1 + (1-tmp) * (2 + (1-tmp) * 3))) + 4 * (1-tmp) * (1-tmp) * (1-tmp));
-			numberOfRetries[k] = round((double) airTime[k] / (double) GRAPH_MULTIPLIER);
-			// backoffUnit[k] = ((tmp * (15.5 + (1-tmp) * (47 + (1-tmp) * 110.5))) + 238 * (1-tmp) * (1-tmp) * (1-tmp)); //802.11b
-			backoffUnit[k] = ((tmp * (7.5 + (1-tmp) * (23 + (1-tmp) * 54.5))) + 118 * (1-tmp) * (1-tmp) * (1-tmp)); //802.11g
-			backoffUnit[k] /= ((1 << numberOfRetries[k]) - 1);
-			airTime[k] /= numberOfRetries[k];
-//			airTime[k] = GRAPH_MULTIPLIER;
-//printf("Airtime = %lu, numberOfRetries = %hhu, backoffUnit = %f, tmp = %f\n", airTime[k], numberOfRetries[k], backoffUnit[k], tmp);
+		for (j = 1; j < u16PathLength(& flowPaths[i]); j++) {
+
+			lastNode = u16PathNode(& flowPaths[i], j - 1);
+			node = u16PathNode(& flowPaths[i], j);
+			hopLink[k] = linkTableLink(linkTable, lastNode, node);
+//printf("Airtime = %lu, numberOfRetries = %hhu, backoffUnit = %f\n", hopLink[k]->airTime, hopLink[k]->numberOfRetries, hopLink[k]->backoffUnit);
+
+			/*
+			 * The backoffs of the hop in time units, so that the main
+			 * loop does not go through floating point to schedule
+			 * them. The backoff unit is given in slots and doubles at
+			 * each retry; the expression is the one the main loop
+			 * used to evaluate, so the times are the same.
+			 */
+			for (l = 0; l < SIMULATION_BACKOFF_STAGES; l++) {
+
+				backoffTicks[k * SIMULATION_BACKOFF_STAGES + l] = ((hopLink[k]->backoffUnit * 
+					(1 << l)) * slotTime / ((int) intVecGet(& intTxDurations, i)/1000000.0)) * GRAPH_MULTIPLIER;
+			}
 			k++;
 		}
 	}
 
-	backoff = arrayNew(graphSize(graph));
-	arrayClear(backoff);
+	MALLOC(backoff, sizeof(t_packet *) * graphSize(graph));
+	memset(backoff, 0, sizeof(t_packet *) * graphSize(graph));
 
 	/*
 	 * Compute conflict graph for the input paths.
 	 */
 	MALLOC(linkIndexBase, sizeof(int) * numberOfFlows);
-	conflict = simulationConflictGraph(graph, paths, linkIndexBase);
+	conflict = simulationConflictGraph(graph, flowPaths, numberOfFlows, linkIndexBase);
 //graphPrint(conflict);
 	/*
 	 * Allocate queueing information.
 	 */
 	queues = queuesNew(graphSize(graph), 2 * maxFlowsPerNode);
-	queuesAddPaths(queues, paths);
+	queuesAddPaths(queues, flowPaths, numberOfFlows);
 	activeNodes = queuesActiveNodes(queues);
 
 	/*
 	 * We'll keep an updated state of the links which 
 	 * are currently blocked.
 	 */
-	blockedLinks = arrayNew(graphSize(conflict));
-	priorityBlockedLinks = arrayNew(graphSize(conflict));
-	priorityBlockedNodes = arrayNew(graphSize(graph));
-	arrayClear(blockedLinks);
+	intVecInit(& blockedLinks, graphSize(conflict));
+	intVecInit(& priorityBlockedLinks, graphSize(conflict));
+	intVecInit(& priorityBlockedNodes, graphSize(graph));
 
 	/*
 	 * We'll keep track of the states here.
 	 */
-	stateStorage = stateStorageNew(STATE_HASH_SIZE);
-	slots = linkIndexBase[arrayLength(paths) - 1] + arrayLength(arrayGet(paths, arrayLength(paths) - 1)) - 1;
+	if (cycleDetection == SIMULATION_CYCLE_BRENT) stateCycle = stateCycleNew();
+	else stateStorage = stateStorageNew(STATE_HASH_SIZE);
+	slots = linkIndexBase[numberOfFlows - 1] + u16PathLength(& flowPaths[numberOfFlows - 1]) - 1;
 
 	/*
 	 * We'll keep track of the time here.
@@ -534,8 +702,9 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 	 * We'll have a list for nodes waiting to 
 	 * transmit and a list for packets on transmission.
 	 */
-	waitingNodes = listNew();
-	onTransmissionPackets = listNew();
+	slabInit(& slab);
+	slabListInit(& waitingNodes, & slab);
+	slabListInit(& onTransmissionPackets, & slab);
 
 	/*
 	 * Build an initial state.
@@ -560,20 +729,21 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 	 */
 	for (i = 0; i < numberOfFlows; i++) {
 
-		path = arrayGet(paths, i);
+		path = & flowPaths[i];
 
 		MALLOC(newPacket, sizeof(t_packet));
-		arrayInc(idPacketFlows, i);
-		newPacket->id = arrayGet(idPacketFlows, i);
+		longVecInc(& idPacketFlows, i);
+		newPacket->id = longVecGet(& idPacketFlows, i);
 		newPacket->initialTime = time;
+		newPacket->waitingSince = time;
 		newPacket->flow = i;
 		newPacket->deliveryProbability = 1.0;
-		newPacket->ETA = airTime[simulationConflictNodeIndex(linkIndexBase, i, 0)]; //adicionado com base no simularionh
+		newPacket->ETA = hopLink[simulationConflictNodeIndex(linkIndexBase, i, 0)]->airTime; //adicionado com base no simularionh
 				
 		/*
 		 * Is the necessary link blocked?
 		 */
-		if (arrayGet(blockedLinks, simulationConflictNodeIndex(linkIndexBase, i, 0))) {
+		if (intVecGet(& blockedLinks, simulationConflictNodeIndex(linkIndexBase, i, 0))) {
 
 			/*
 			 * Yes, packet stays in hop 0.
@@ -598,28 +768,28 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 			 * backoff buffer) might already be occupied. In this case, 
 			 * we leave the packet at the node's regular buffer.
 			 */
-			if (arrayGet(backoff, (long) arrayGet(path, 0))) {
+			if (backoff[u16PathNode(path, 0)]) {
 
 				/*
 				 * Case 1: backoff buffer is already taken.
 				 * Add the packet to the node's queue.
 				 */
-				queuesAddPacket(queues, newPacket, (long) arrayGet(path, 0));
+				queuesAddPacket(queues, newPacket, u16PathNode(path, 0));
 
 				/*
 				 * Add the information about this packet staying on the
 				 * buffer to the current state.
 				 */
-				stateAddBuffer(state, simulationConflictNodeIndex(linkIndexBase, i, newPacket->currentHop));
+				stateAddBuffer(state, simulationConflictNodeIndex(linkIndexBase, i, newPacket->currentHop), time - newPacket->initialTime);
 			}
 			else {
 
 				newPacket->retries = 0;
-				newPacket->maxRetries = numberOfRetries[simulationConflictNodeIndex(linkIndexBase, newPacket->flow, newPacket->currentHop)];
+				newPacket->maxRetries = hopLink[simulationConflictNodeIndex(linkIndexBase, newPacket->flow, newPacket->currentHop)]->numberOfRetries;
 				newPacket->ETA = 0; // First backoff is already done.
 				newPacket->waitingSince = 0;
-				arraySet(backoff, (long) arrayGet(path, 0), newPacket);
-				listAdd(waitingNodes, (void *) (((long) arrayGet(path, 0)) + 1));
+				backoff[u16PathNode(path, 0)] = newPacket;
+				slabListAdd(& waitingNodes, (void *) u16PathNode(path, 0));
 
 				stateAddTransmission(state, simulationConflictNodeIndex(linkIndexBase, i, 0), newPacket->ETA, 1, newPacket->retries, 0);
 			}
@@ -631,17 +801,16 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 			 * by saying the packet is in the -1 hop.
 			 */
 			newPacket->currentHop = -1;
-//printf("Acessing pos %d with value %lu\n", simulationConflictNodeIndex(linkIndexBase, i, 0), airTime[simulationConflictNodeIndex(linkIndexBase, i, 0)]);
-			newPacket->ETA = airTime[simulationConflictNodeIndex(linkIndexBase, i, 0)];
-			tmp = 1 - sqrt((double) GRAPH_MULTIPLIER / (double) graphGetCost(graph, (long) arrayGet(path, 0), (long) arrayGet(path, 1)));
-			newPacket->deliveryProbability *= (1 - tmp * tmp * tmp * tmp);
+//printf("Acessing pos %d with value %lu\n", simulationConflictNodeIndex(linkIndexBase, i, 0), hopLink[simulationConflictNodeIndex(linkIndexBase, i, 0)]->airTime);
+			newPacket->ETA = hopLink[simulationConflictNodeIndex(linkIndexBase, i, 0)]->airTime;
+			newPacket->deliveryProbability *= hopLink[simulationConflictNodeIndex(linkIndexBase, i, 0)]->deliveryFactor;
 
 			/*
 			 * Fill also information regarding the backoff.
 			 */
 			newPacket->retries = 0;
-			newPacket->maxRetries = numberOfRetries[simulationConflictNodeIndex(linkIndexBase, i, 0)];
-			arraySet(backoff, (long) arrayGet(path, 0), newPacket);
+			newPacket->maxRetries = hopLink[simulationConflictNodeIndex(linkIndexBase, i, 0)]->numberOfRetries;
+			backoff[u16PathNode(path, 0)] = newPacket;
 
 			/*
 			 * Update delta, if necessary.
@@ -655,9 +824,9 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 			 * Block links.
 			 */
 			neighbors = graphGetNeighbors(conflict, simulationConflictNodeIndex(linkIndexBase, i, 0));
-			for (link = listBegin(neighbors); link; link = listNext(neighbors)) {
+			for (link = smallVecBegin(neighbors); link < smallVecEnd(neighbors); link++) {
 
-				arrayInc(blockedLinks, * link);
+				intVecInc(& blockedLinks, * link);
 			}
 
 			/*
@@ -670,7 +839,7 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 			 * so that we know this packet is disputing
 			 * the wireless medium.
 			 */
-			listAdd(onTransmissionPackets, newPacket);
+			slabListAdd(& onTransmissionPackets, newPacket);
 
 			//Cannot generate another packet imediatelly, since the next packet will arrive only at the next Flow Time.
 			///*
@@ -678,8 +847,8 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 			// */
 			//
 			//MALLOC(newPacket, sizeof(t_packet));
-			//arrayInc(idPacketFlows, i);
-			//newPacket->id = arrayGet(idPacketFlows, i);
+			//longVecInc(& idPacketFlows, i);
+			//newPacket->id = longVecGet(& idPacketFlows, i);
 			//newPacket->initialTime = time;
 			//newPacket->currentHop = 0;
 			//newPacket->flow = i;
@@ -689,7 +858,7 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 			// * Place it on the ordinary buffer.
 			// */
 //
-			//queuesAddPacket(queues, newPacket, (long) arrayGet(arrayGet(paths, newPacket->flow), 0));
+			//queuesAddPacket(queues, newPacket, u16PathNode(& flowPaths[newPacket->flow], 0));
 			//stateAddBuffer(state, simulationConflictNodeIndex(linkIndexBase, newPacket->flow, newPacket->currentHop));
 			
 		}
@@ -697,12 +866,16 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 
 	stateSetCurrentTime(state, 0.0);
 	stateSetDeliveredPackets(state, 0);
-	stateSetDeliveredPacketsFlows(state, permanentDeliveredPacketsFlows);
-	stateSetSentPacketsFlows(state, permanentSentPacketsFlows);
-	stateSetDelayFlows(state, delayFlows);
+	stateSetDeliveredPacketsFlows(state, & permanentDeliveredPacketsFlows);
+	stateSetSentPacketsFlows(state, & permanentSentPacketsFlows);
+	stateSetDelayFlows(state, & delayFlows);
+	simulationSetArrivals(state, & scheduleFlowTime, traffic, numberOfFlows);
 //printf("At " WEIGHT_FORMAT ":", time);
 //statePrint(state);
-	stateLookupAndStore(state, stateStorage);
+	simulationLookupAndStore(state, stateStorage, stateCycle);
+	statesSaved++;
+
+	if (collectStats) clock_gettime(CLOCK_MONOTONIC, & loopStart);
 
 	/*
 	 * Main loop:
@@ -715,14 +888,15 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 	 */
 	while(1) {
 
+		iterations++;
 		haveToSaveState = 0;
 
 		/*
 		 * Clear some variables.
 		 */
 		state = stateNew(slots, numberOfFlows);
-		arrayClear(priorityBlockedLinks);
-		arrayClear(priorityBlockedNodes);
+		intVecClear(& priorityBlockedLinks);
+		intVecClear(& priorityBlockedNodes);
 
 		/*
 		 * Update time variables.
@@ -734,11 +908,11 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 		/*
 		 * Update backoffs.
 		 */
-		for (node = (long) listBegin(activeNodes); node; node = (long) listNext(activeNodes)) {
+		for (activeNode = smallVecBegin(activeNodes); activeNode < smallVecEnd(activeNodes); activeNode++) {
 
-			node--;
+			node = * activeNode;
 
-			if ((packet = arrayGet(backoff, node)) == NULL) continue ;
+			if ((packet = backoff[node]) == NULL) continue ;
 
 			/*
 			 * The packet in the backoff buffer can be under transmission.
@@ -753,16 +927,17 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 			 * the backoff counter (prevents it from decreasing).
 			 */
 
-			for (otherPacket = listBegin(onTransmissionPackets); otherPacket; otherPacket = listNext(onTransmissionPackets)) {
+			for (transmission = slabListFirst(& onTransmissionPackets); transmission; transmission = slabNodeNext(transmission)) {
 
-				node2 = (long) arrayGet(arrayGet(paths, otherPacket->flow), -otherPacket->currentHop - 1);
+				otherPacket = slabNodeData(transmission);
+				node2 = u16PathNode(& flowPaths[otherPacket->flow], -otherPacket->currentHop - 1);
 
 				// printf(">> GRAPH COST: %d, CONFLICT LIMIAR: %d", graphGetCost(graph, node, node2), CONFLICT_LIMIAR);
 				
 				if (graphGetCost(graph, node, node2) < CONFLICT_LIMIAR) break ;
 			}
 
-			if (!otherPacket) {
+			if (!transmission) {
 
 				/*
 				 * No neighbor was transmitting.
@@ -777,8 +952,10 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 		 * Update status of the packets being transmitted.
 		 */
 
-		for (packet = listBegin(onTransmissionPackets); packet; packet = listNext(onTransmissionPackets)) {
+		for (listNode = slabListFirst(& onTransmissionPackets); listNode; listNode = nextNode) {
 
+			nextNode = slabNodeNext(listNode);
+			packet = slabNodeData(listNode);
 			packet->ETA -= oldDelta;
 
 			if (packet->ETA <= 0) {
@@ -796,15 +973,15 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 				 * blocked.
 				 */
 				neighbors = graphGetNeighbors(conflict, simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop - 1));
-				for (link = listBegin(neighbors); link; link = listNext(neighbors)) {
+				for (link = smallVecBegin(neighbors); link < smallVecEnd(neighbors); link++) {
 
-					arrayDec(blockedLinks, * link);
+					intVecDec(& blockedLinks, * link);
 				}
 
 				/*
 				 * Remove the packet from the onTransmissionPackets list.
 				 */
-				listDelCurrent(onTransmissionPackets);
+				slabListDel(& onTransmissionPackets, listNode);
 
 				/*
 				 * But did the packet really arrive, or do we need more
@@ -821,11 +998,10 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 
 					packet->currentHop--;
 //					packet->ETA = (((32 * (1 << packet->retries) - 1) / 2.0) * slotTime / txTime) * GRAPH_MULTIPLIER;
-					packet->ETA = ((backoffUnit[simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop)] * 
-							(1 << packet->retries)) * slotTime / ((int) arrayGet(frameTxDurations,packet->flow)/1000000.0)) * GRAPH_MULTIPLIER;
+					packet->ETA = simulationBackoff(backoffTicks, simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop), packet->retries);
 					packet->waitingSince = time;
 
-					listAdd(waitingNodes, (void *) (((long) arrayGet(arrayGet(paths, packet->flow), packet->currentHop)) + 1));
+					slabListAdd(& waitingNodes, (void *) u16PathNode(& flowPaths[packet->flow], packet->currentHop));
 
 					stateAddTransmission(state, simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop), packet->ETA, 1, packet->retries, time - packet->waitingSince);
 				}
@@ -837,51 +1013,50 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 					 * of the source node (if one exists).
 					 */
 
-					node = (long) arrayGet(arrayGet(paths, packet->flow), packet->currentHop - 1);
+					node = u16PathNode(& flowPaths[packet->flow], packet->currentHop - 1);
 					if (queuesSize(queues, node) > 0) {
 
 						otherPacket = queuesFirst(queues, node);
 						queuesDelPacket(queues, otherPacket, node);
-						arraySet(backoff, node, otherPacket);
+						backoff[node] = otherPacket;
 
 //						otherPacket->ETA = 0.025833333 * GRAPH_MULTIPLIER; // First backoff: 15.5 slots.
-						otherPacket->ETA = (backoffUnit[simulationConflictNodeIndex(linkIndexBase, otherPacket->flow, otherPacket->currentHop)] * 
-								slotTime / ((int) arrayGet(frameTxDurations,otherPacket->flow)/1000000.0)) * GRAPH_MULTIPLIER; // First backoff.
+						otherPacket->ETA = simulationBackoff(backoffTicks, simulationConflictNodeIndex(linkIndexBase, otherPacket->flow, otherPacket->currentHop), 0); // First backoff.
 						otherPacket->waitingSince = time;
 						otherPacket->retries = 0;
-						otherPacket->maxRetries = numberOfRetries[simulationConflictNodeIndex(linkIndexBase, otherPacket->flow, otherPacket->currentHop)];
-						listAdd(waitingNodes, (void *) (((long) arrayGet(arrayGet(paths, packet->flow), packet->currentHop - 1)) + 1));
+						otherPacket->maxRetries = hopLink[simulationConflictNodeIndex(linkIndexBase, otherPacket->flow, otherPacket->currentHop)]->numberOfRetries;
+						slabListAdd(& waitingNodes, (void *) u16PathNode(& flowPaths[packet->flow], packet->currentHop - 1));
 
 						stateAddTransmission(state, simulationConflictNodeIndex(linkIndexBase, otherPacket->flow, otherPacket->currentHop), otherPacket->ETA, 1, otherPacket->retries, time - otherPacket->waitingSince);
 					}
 					else {
 
-						arraySet(backoff, node, NULL);
+						backoff[node] = NULL;
 					}
 
 					/*
 					 * Has the packet arrived in its final
 					 * destination?
 					 */
-					if (packet->currentHop == arrayLength(arrayGet(paths, packet->flow)) - 1) {
+					if (packet->currentHop == u16PathLength(& flowPaths[packet->flow]) - 1) {
 
 						/*
 						 * Yes. Update the number of delivered packets and
 						 * free the packet.
 						 */
-						//arrayInc(permanentDeliveredPacketsFlows, packet->flow);
-						arraySet(permanentDeliveredPacketsFlows, packet->flow, ((long) (packet->deliveryProbability * GRAPH_MULTIPLIER)) + ((long) arrayGet(permanentDeliveredPacketsFlows, packet->flow)));
-						//printf("Packet of Flow %d delivered with probability %f. (Total Delivered:%f)\n", packet->flow, packet->deliveryProbability, ((long) arrayGet(permanentDeliveredPacketsFlows, packet->flow)) / GRAPH_MULTIPLIER);
+						//longVecInc(& permanentDeliveredPacketsFlows, packet->flow);
+						longVecSet(& permanentDeliveredPacketsFlows, packet->flow, ((long) (packet->deliveryProbability * GRAPH_MULTIPLIER)) + (longVecGet(& permanentDeliveredPacketsFlows, packet->flow)));
+						//printf("Packet of Flow %d delivered with probability %f. (Total Delivered:%f)\n", packet->flow, packet->deliveryProbability, (longVecGet(& permanentDeliveredPacketsFlows, packet->flow)) / GRAPH_MULTIPLIER);
 
-						arraySet(permanentSentPacketsFlows, packet->flow, packet->id);
-						// printf("Packet of Flow %d sent. (Total Sent:%d)\n",packet->flow, arrayGet(permanentSentPacketsFlows, packet->flow));
-						//printf("DELAY FLOW %d: %ld",packet->flow, (long) arrayGet(delayFlows, packet->flow));
+						longVecSet(& permanentSentPacketsFlows, packet->flow, packet->id);
+						// printf("Packet of Flow %d sent. (Total Sent:%d)\n",packet->flow, longVecGet(& permanentSentPacketsFlows, packet->flow));
+						//printf("DELAY FLOW %d: %ld",packet->flow, longVecGet(& delayFlows, packet->flow));
 
-						arraySet(delayFlows, packet->flow, (long) arrayGet(delayFlows, packet->flow) + (time - packet->initialTime));
+						longVecSet(& delayFlows, packet->flow, longVecGet(& delayFlows, packet->flow) + (time - packet->initialTime));
 						
-						//printf("DELAY FLOW AFTER %d:  %ld",packet->flow, (long) arrayGet(delayFlows, packet->flow));
+						//printf("DELAY FLOW AFTER %d:  %ld",packet->flow, longVecGet(& delayFlows, packet->flow));
 
-						arrayInc(deliveredPacketsFlows, packet->flow);
+						intVecInc(& deliveredPacketsFlows, packet->flow);
 						deliveredPackets += packet->deliveryProbability;
 
 						deliveredPacketsPerFlow[packet->flow] = packet->deliveryProbability + deliveredPacketsPerFlow[packet->flow];
@@ -896,24 +1071,23 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 						 * is not currently performing a backoff, take the
 						 * first packet on the queue and start the backoff procedure. 
 						 */
-						queuesAddPacket(queues, packet, (long) arrayGet(arrayGet(paths, packet->flow), packet->currentHop));
-						if (!arrayGet(backoff, (long) arrayGet(arrayGet(paths, packet->flow), packet->currentHop))) {
+						queuesAddPacket(queues, packet, u16PathNode(& flowPaths[packet->flow], packet->currentHop));
+						if (!backoff[u16PathNode(& flowPaths[packet->flow], packet->currentHop)]) {
 
-							otherPacket = queuesFirst(queues, (long) arrayGet(arrayGet(paths, packet->flow), packet->currentHop));
-							queuesDelPacket(queues, otherPacket, (long) arrayGet(arrayGet(paths, packet->flow), packet->currentHop));
-							arraySet(backoff, (long) arrayGet(arrayGet(paths, packet->flow), packet->currentHop), otherPacket);
+							otherPacket = queuesFirst(queues, u16PathNode(& flowPaths[packet->flow], packet->currentHop));
+							queuesDelPacket(queues, otherPacket, u16PathNode(& flowPaths[packet->flow], packet->currentHop));
+							backoff[u16PathNode(& flowPaths[packet->flow], packet->currentHop)] = otherPacket;
 
 							/* 
 							 * Fill data regarding backoff.
 							 */
 //							otherPacket->ETA = 0.025833333 * GRAPH_MULTIPLIER; // First backoff: 15.5 slots.
-							otherPacket->ETA = (backoffUnit[simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop)] 
-									* slotTime / ((int) arrayGet(frameTxDurations,packet->flow)/1000000.0)) * GRAPH_MULTIPLIER; // First backoff.
+							otherPacket->ETA = simulationBackoff(backoffTicks, simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop), 0); // First backoff.
 							otherPacket->waitingSince = time;
 							otherPacket->retries = 0;
-							otherPacket->maxRetries = numberOfRetries[simulationConflictNodeIndex(linkIndexBase, otherPacket->flow, otherPacket->currentHop)];
+							otherPacket->maxRetries = hopLink[simulationConflictNodeIndex(linkIndexBase, otherPacket->flow, otherPacket->currentHop)]->numberOfRetries;
 
-							listAdd(waitingNodes, (void *) (((long) arrayGet(arrayGet(paths, packet->flow), packet->currentHop)) + 1));
+							slabListAdd(& waitingNodes, (void *) u16PathNode(& flowPaths[packet->flow], packet->currentHop));
 							stateAddTransmission(state, simulationConflictNodeIndex(linkIndexBase, otherPacket->flow, otherPacket->currentHop), otherPacket->ETA, 1, otherPacket->retries, time - otherPacket->waitingSince);
 						}
 					}
@@ -939,42 +1113,41 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 		/* Schedule */	
 		// printf("Time %ld, OldDelta %ld\n", time, oldDelta);
 		for (i = 0; i < numberOfFlows; i++) {
-			scheduleTime = (int) arrayGet(scheduleFlowTime,i) - (int) oldDelta;
+			scheduleTime = (int) longVecGet(& scheduleFlowTime, i) - (int) oldDelta;
 			if(scheduleTime <= 0){
-				arrayInc(idPacketFlows, i); 
+				longVecInc(& idPacketFlows, i); 
 		
 				MALLOC(newPacket, sizeof(t_packet));
-				newPacket->id = arrayGet(idPacketFlows, i); 
+				newPacket->id = longVecGet(& idPacketFlows, i); 
 				newPacket->initialTime = time;
 				newPacket->currentHop = 0;
 				newPacket->flow = i;
 				newPacket->deliveryProbability = 1.0;
-				newPacket->ETA = airTime[simulationConflictNodeIndex(linkIndexBase, i, 0)]; //adicionado com base no simularionh
-				//newPacket->ETA = graphGetCost(graph, (long) arrayGet(arrayGet(paths, newPacket->flow), 0), (long) arrayGet(arrayGet(paths, newPacket->flow), 1)); //DOES THAT MAKE SENSE?
+				newPacket->ETA = hopLink[simulationConflictNodeIndex(linkIndexBase, i, 0)]->airTime; //adicionado com base no simularionh
+				//newPacket->ETA = graphGetCost(graph, u16PathNode(& flowPaths[newPacket->flow], 0), u16PathNode(& flowPaths[newPacket->flow], 1)); //DOES THAT MAKE SENSE?
 				 //printf("New Packet Created - Time: %lu Flow: %d\n", time, newPacket->flow);
-				queuesAddPacket(queues, newPacket, (long) arrayGet(arrayGet(paths, newPacket->flow), 0));
-				if (!arrayGet(backoff, (long) arrayGet(arrayGet(paths, newPacket->flow), 0))) {
-					otherPacket = queuesFirst(queues, (long) arrayGet(arrayGet(paths, newPacket->flow), 0));
-					queuesDelPacket(queues, otherPacket, (long) arrayGet(arrayGet(paths, newPacket->flow), 0));
-					arraySet(backoff, (long) arrayGet(arrayGet(paths, newPacket->flow), 0), otherPacket);
+				queuesAddPacket(queues, newPacket, u16PathNode(& flowPaths[newPacket->flow], 0));
+				if (!backoff[u16PathNode(& flowPaths[newPacket->flow], 0)]) {
+					otherPacket = queuesFirst(queues, u16PathNode(& flowPaths[newPacket->flow], 0));
+					queuesDelPacket(queues, otherPacket, u16PathNode(& flowPaths[newPacket->flow], 0));
+					backoff[u16PathNode(& flowPaths[newPacket->flow], 0)] = otherPacket;
 
 					// Fill data regarding backoff. ??
-					otherPacket->ETA = (backoffUnit[simulationConflictNodeIndex(linkIndexBase, newPacket->flow, newPacket->currentHop)] 
-							* slotTime / ((int) arrayGet(frameTxDurations, newPacket->flow)/1000000.0)) * GRAPH_MULTIPLIER; // First backoff.
+					otherPacket->ETA = simulationBackoff(backoffTicks, simulationConflictNodeIndex(linkIndexBase, newPacket->flow, newPacket->currentHop), 0); // First backoff.
 					otherPacket->waitingSince = time;
 					otherPacket->retries = 0;
-					otherPacket->maxRetries = numberOfRetries[simulationConflictNodeIndex(linkIndexBase, otherPacket->flow, otherPacket->currentHop)];
+					otherPacket->maxRetries = hopLink[simulationConflictNodeIndex(linkIndexBase, otherPacket->flow, otherPacket->currentHop)]->numberOfRetries;
 
-					listAdd(waitingNodes, (void *) (((long) arrayGet(arrayGet(paths, newPacket->flow), newPacket->currentHop)) + 1));
+					slabListAdd(& waitingNodes, (void *) u16PathNode(& flowPaths[newPacket->flow], newPacket->currentHop));
 					stateAddTransmission(state, simulationConflictNodeIndex(linkIndexBase, otherPacket->flow, otherPacket->currentHop), otherPacket->ETA, 1, otherPacket->retries, time - otherPacket->waitingSince);
 				}
-				arraySet(scheduleFlowTime,i,arrayGet(flowTimes, i));	
+				longVecSet(& scheduleFlowTime, i, trafficNext(& traffic[i], & intFlowTimes, i));
 			} else {
-				arraySet(scheduleFlowTime,i, scheduleTime);
+				longVecSet(& scheduleFlowTime, i, scheduleTime);
 			}
 			
-			if(delta > arrayGet(scheduleFlowTime,i)){
-				delta = arrayGet(scheduleFlowTime,i);
+			if(delta > longVecGet(& scheduleFlowTime, i)){
+				delta = longVecGet(& scheduleFlowTime, i);
 				//printf("2.delta %d\n", delta);
 			}	
 		}
@@ -983,18 +1156,16 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 		 * Now we loop through the list of the waiting nodes
 		 * to see if we can transmit their packets.
 		 */
-		for (node = (long) listBegin(waitingNodes); node; node = (long) listNext(waitingNodes)) {
+		for (listNode = slabListFirst(& waitingNodes); listNode; listNode = nextNode) {
 
-			/*
-			 * Node is stored as node + 1 to avoid NULL values.
-			 */
-			node--;
+			nextNode = slabNodeNext(listNode);
+			node = (long) slabNodeData(listNode);
 			//printf("Node %d\n", node);
 			/* 
 			 * Always take the packet on the node's backoff buffer.
 			 */
-			//packet = arrayGet(backoff, node);
-			if ((packet = arrayGet(backoff, node)) == NULL) continue ;
+			//packet = backoff[node];
+			if ((packet = backoff[node]) == NULL) continue ;
 			
 
 			/*
@@ -1021,14 +1192,15 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 				 * there are not, we place a priority block on
 				 * every link rooted at neighbors of this node.
 				 */
-				for (otherPacket = listBegin(onTransmissionPackets); otherPacket; otherPacket = listNext(onTransmissionPackets)) {
+				for (transmission = slabListFirst(& onTransmissionPackets); transmission; transmission = slabNodeNext(transmission)) {
 
-					node2 = (long) arrayGet(arrayGet(paths, otherPacket->flow), -otherPacket->currentHop - 1);
+					otherPacket = slabNodeData(transmission);
+					node2 = u16PathNode(& flowPaths[otherPacket->flow], -otherPacket->currentHop - 1);
 
 					if (graphGetCost(graph, node, node2) < CONFLICT_LIMIAR) break ;
 				}
 
-				if (otherPacket) continue ;
+				if (transmission) continue ;
 
 				if (delta > packet->ETA) {
 
@@ -1036,11 +1208,11 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 				}
 
 //#ifdef OLD
-				neighbors = graphGetNeighbors(graph, node);
+				nodep = linkTableNeighbors(linkTable, node, & numberOfNeighbors);
 				i = 0;
-				for (nodep = listBegin(neighbors); nodep; nodep = listNext(neighbors)) {
+				for (j = 0; j < numberOfNeighbors; j++) {
 
-					if (arrayGet(backoff, * nodep)) i++;
+					if (backoff[nodep[j]]) i++;
 				}
 
 				if (time - packet->waitingSince <= i * 2 * GRAPH_MULTIPLIER) continue ;
@@ -1048,9 +1220,9 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 				/*
 				 * Lets priority block all neighbors.
 				 */
-				for (nodep = listBegin(neighbors); nodep; nodep = listNext(neighbors)) {
+				for (j = 0; j < numberOfNeighbors; j++) {
 
-					arraySet(priorityBlockedNodes, * nodep, (void *) 1);
+					intVecSet(& priorityBlockedNodes, nodep[j], 1);
 				}
 //#endif				
 				continue ;
@@ -1059,15 +1231,15 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 			/*
 			 * Is the necessary link blocked?
 			 */
-			if (arrayGet(blockedLinks, simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop))) {
+			if (intVecGet(& blockedLinks, simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop))) {
 
 				/*
 				 * Place a block on the priorityBlock.
 				 */
 				neighbors = graphGetNeighbors(conflict, simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop));
-				for (link = listBegin(neighbors); link; link = listNext(neighbors)) {
+				for (link = smallVecBegin(neighbors); link < smallVecEnd(neighbors); link++) {
 
-					arrayInc(priorityBlockedLinks, * link);
+					intVecInc(& priorityBlockedLinks, * link);
 				}
 
 				stateAddTransmission(state, simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop), packet->ETA, 1, packet->retries, time - packet->waitingSince);
@@ -1077,15 +1249,15 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 			/*
 			 * is the link priority blocked?
 			 */
-			if (arrayGet(priorityBlockedLinks, simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop))) {
+			if (intVecGet(& priorityBlockedLinks, simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop))) {
 
 				/*
 				 * Place a block on the priorityBlock.
 				 */
 				neighbors = graphGetNeighbors(conflict, simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop));
-				for (link = listBegin(neighbors); link; link = listNext(neighbors)) {
+				for (link = smallVecBegin(neighbors); link < smallVecEnd(neighbors); link++) {
 
-					arrayInc(priorityBlockedLinks, * link);
+					intVecInc(& priorityBlockedLinks, * link);
 				}
 
 				stateAddTransmission(state, simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop), packet->ETA, 1, packet->retries, time - packet->waitingSince);
@@ -1095,15 +1267,15 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 			/*
 			 * is the source node priority blocked?
 			 */
-			if (arrayGet(priorityBlockedNodes, (long) arrayGet(arrayGet(paths, packet->flow), packet->currentHop))) {
+			if (intVecGet(& priorityBlockedNodes, u16PathNode(& flowPaths[packet->flow], packet->currentHop))) {
 
 				/*
 				 * Place a block on the priorityBlock.
 				 */
 				neighbors = graphGetNeighbors(conflict, simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop));
-				for (link = listBegin(neighbors); link; link = listNext(neighbors)) {
+				for (link = smallVecBegin(neighbors); link < smallVecEnd(neighbors); link++) {
 
-					arrayInc(priorityBlockedLinks, * link);
+					intVecInc(& priorityBlockedLinks, * link);
 				}
 
 				stateAddTransmission(state, simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop), packet->ETA, 1, packet->retries, time - packet->waitingSince);
@@ -1114,11 +1286,11 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 			 * If we got here, the link is not blocked in any way. Transmit the packet.
 			 * See if there is a coding partner.
 			 */
-			path = arrayGet(paths, packet->flow);
+			path = & flowPaths[packet->flow];
 			
-			codedPacket = queuesFindCodingPartner(graph, queues, packet, paths,
-					(unsigned long) arrayGet(path, packet->currentHop),
-					blockedLinks, priorityBlockedLinks, linkIndexBase,
+			codedPacket = queuesFindCodingPartner(graph, queues, packet, flowPaths,
+					u16PathNode(path, packet->currentHop),
+					& blockedLinks, & priorityBlockedLinks, linkIndexBase,
 					& successProb1, & successProb2);
 			
 			/*
@@ -1126,9 +1298,9 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 			 */
 
 			neighbors = graphGetNeighbors(conflict, simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop));
-			for (link = listBegin(neighbors); link; link = listNext(neighbors)) {
+			for (link = smallVecBegin(neighbors); link < smallVecEnd(neighbors); link++) {
 
-				arrayInc(blockedLinks, * link);
+				intVecInc(& blockedLinks, * link);
 			}
 
 			/*
@@ -1141,19 +1313,19 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 			/*
 			 * Update hop and ETA.
 			 */
-//printf("Acessing pos %d with value %lu\n", simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop), airTime[simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop)]);
-			packet->ETA = airTime[simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop)];
+//printf("Acessing pos %d with value %lu\n", simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop), hopLink[simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop)]->airTime);
+			packet->ETA = hopLink[simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop)]->airTime;
 			packet->currentHop = -(packet->currentHop + 1);
-			// printf("FLOW: %d, NEXT PACKET IN: %d\n", packet->flow, (int) arrayGet(scheduleFlowTime, packet->flow));
+			// printf("FLOW: %d, NEXT PACKET IN: %d\n", packet->flow, (int) longVecGet(& scheduleFlowTime, packet->flow));
 			stateAddTransmission(state, simulationConflictNodeIndex(linkIndexBase, packet->flow, -packet->currentHop - 1), packet->ETA, 0, packet->retries, time - packet->waitingSince);
-//printf("time %.2f: transmiting packet between %d and %d\n", time, (long) arrayGet(path, packet->currentHop), (long) arrayGet(path, packet->currentHop + 1));
+//printf("time %.2f: transmiting packet between %d and %d\n", time, u16PathNode(path, packet->currentHop), u16PathNode(path, packet->currentHop + 1));
 			/*
 			 * Move the packet to 
 			 * the onTransmission list.
 			 * Remove the node from the waitingNodes list.
 			 */
-			listAdd(onTransmissionPackets, packet);
-			listDelCurrent(waitingNodes);
+			slabListAdd(& onTransmissionPackets, packet);
+			slabListDel(& waitingNodes, listNode);
 
 			/*
 			 * Update delta, if necessary.
@@ -1168,36 +1340,32 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 			 */
 			if (codedPacket) {
 
-				tmp = sqrt((double) GRAPH_MULTIPLIER / (double) graphGetCost(graph, (long) arrayGet(path, -packet->currentHop - 1),
-				                                        (long) arrayGet(path, -packet->currentHop)));
-				packet->deliveryProbability *= tmp * successProb1;
+				packet->deliveryProbability *= hopLink[simulationConflictNodeIndex(linkIndexBase, packet->flow, -packet->currentHop - 1)]->successProbability * successProb1;
 				packet->ETA = GRAPH_MULTIPLIER;
 				stateAddTransmission(state, simulationConflictNodeIndex(linkIndexBase, packet->flow, -packet->currentHop - 1), packet->ETA, 0, packet->retries, time - packet->waitingSince);
 				packet->maxRetries = 1;
 
 				packet = codedPacket;
-				path = arrayGet(paths, packet->flow);
-				queuesDelPacket(queues, packet, (unsigned long) arrayGet(path, packet->currentHop));
+				path = & flowPaths[packet->flow];
+				queuesDelPacket(queues, packet, u16PathNode(path, packet->currentHop));
 
 				/*
 				 * Block links.
 				 */
 
 				neighbors = graphGetNeighbors(conflict, simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop));
-				for (link = listBegin(neighbors); link; link = listNext(neighbors)) {
+				for (link = smallVecBegin(neighbors); link < smallVecEnd(neighbors); link++) {
 
-					arrayInc(blockedLinks, * link);
+					intVecInc(& blockedLinks, * link);
 				}
 
 				/*
 				 * Update hop and ETA.
 				 */
 
-//printf("Acessing pos %d with value %lu\n", simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop), airTime[simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop)]);
-//				packet->ETA = airTime[simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop)];
-				tmp = sqrt((double) GRAPH_MULTIPLIER / (double) graphGetCost(graph, (long) arrayGet(path, packet->currentHop),
-				                                        (long) arrayGet(path, packet->currentHop + 1)));
-				packet->deliveryProbability *= tmp * successProb2;
+//printf("Acessing pos %d with value %lu\n", simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop), hopLink[simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop)]->airTime);
+//				packet->ETA = hopLink[simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop)]->airTime;
+				packet->deliveryProbability *= hopLink[simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop)]->successProbability * successProb2;
 				packet->ETA = GRAPH_MULTIPLIER;
 				packet->waitingSince = 0;
 				packet->currentHop = -(packet->currentHop + 1);
@@ -1214,7 +1382,7 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 				 * Move the packet to 
 				 * the onTransmission list.
 				 */
-				listAdd(onTransmissionPackets, packet);
+				slabListAdd(& onTransmissionPackets, packet);
 
 				/*
 				 * Update delta, if necessary.
@@ -1228,9 +1396,7 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 
 				if (packet->retries == 0) {
 
-					tmp = 1 - sqrt((double) GRAPH_MULTIPLIER / (double) graphGetCost(graph, (long) arrayGet(path, -packet->currentHop - 1),
-										(long) arrayGet(path, -packet->currentHop)));
-					packet->deliveryProbability *= (1 - tmp * tmp * tmp * tmp);
+					packet->deliveryProbability *= hopLink[simulationConflictNodeIndex(linkIndexBase, packet->flow, -packet->currentHop - 1)]->deliveryFactor;
 				}
 			}
 
@@ -1242,7 +1408,7 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 			//	newPacket->currentHop = 0;
 			//	newPacket->flow = packet->flow;
 			//	newPacket->deliveryProbability = 1.0;
-			//	queuesAddPacket(queues, newPacket, (long) arrayGet(arrayGet(paths, newPacket->flow), 0));
+			//	queuesAddPacket(queues, newPacket, u16PathNode(& flowPaths[newPacket->flow], 0));
 			//}
 			
 		}
@@ -1250,9 +1416,9 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 
 		if (haveToSaveState) {
 
-			for (i = (long) listBegin(activeNodes); i; i = (long) listNext(activeNodes)) {
+			for (activeNode = smallVecBegin(activeNodes); activeNode < smallVecEnd(activeNodes); activeNode++) {
 
-				node = i - 1;
+				node = * activeNode;
 
 				/* 
 				 * If the queue of the node is not empty,
@@ -1262,8 +1428,11 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 				if (queuesSize(queues, node) > 0) {
 
 					nodeQueue = queuesNodeQueue(queues, node);
-					for (packet = listBegin(nodeQueue); packet; packet = listNext(nodeQueue)) 
-						stateAddBuffer(state, simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop));
+					for (listNode = slabListFirst(nodeQueue); listNode; listNode = slabNodeNext(listNode)) {
+
+						packet = slabNodeData(listNode);
+						stateAddBuffer(state, simulationConflictNodeIndex(linkIndexBase, packet->flow, packet->currentHop), time - packet->initialTime);
+					}
 				}
 			}
 		}
@@ -1278,9 +1447,10 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 				stateSetCurrentTime(state, time);
 				stateSetDeliveredPackets(state, deliveredPackets);
 
-				stateSetDeliveredPacketsFlows(state, permanentDeliveredPacketsFlows);
-				stateSetSentPacketsFlows(state, permanentSentPacketsFlows);
-				stateSetDelayFlows(state, delayFlows);
+				stateSetDeliveredPacketsFlows(state, & permanentDeliveredPacketsFlows);
+				stateSetSentPacketsFlows(state, & permanentSentPacketsFlows);
+				stateSetDelayFlows(state, & delayFlows);
+				simulationSetArrivals(state, & scheduleFlowTime, traffic, numberOfFlows);
 				//printf("State saved! Time: %d\n", state->currentTime);
 //if (time > 10000){
 //printf(WEIGHT_FORMAT "(%d) ", time, deliveredPackets);		
@@ -1289,14 +1459,16 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 //}
 //printf("At " WEIGHT_FORMAT ":", time);
 //statePrint(state);
-				oldState = stateLookupAndStore(state, stateStorage);
+				oldState = simulationLookupAndStore(state, stateStorage, stateCycle);
+				statesSaved++;
 
 				if (oldState != NULL) {
 					for (i = 0; i < numberOfFlows; i++) {
-					//	printf("Flow %d: %d pkts delivered\n",i,(unsigned long) arrayGet(deliveredPacketsFlows, i));
-						if ((unsigned long) arrayGet(deliveredPacketsFlows, i) < 1) break ;
+					//	printf("Flow %d: %d pkts delivered\n",i,intVecGet(& deliveredPacketsFlows, i));
+						if (intVecGet(& deliveredPacketsFlows, i) < 1) break ;
 					}
 					targetTime = time + stateGetCurrentTime(state) - stateGetCurrentTime(oldState);
+					cycleTime = stateGetCurrentTime(state) - stateGetCurrentTime(oldState);
 					oldState = state;
 //printf("setting targetTime to %lu\n", targetTime);
 					continue ;
@@ -1325,13 +1497,13 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 			 */
 			
 			for (i = 0; i < numberOfFlows; i++) {
-			//	printf(">>>> Flow %d: %d pkts delivered\n",i,(unsigned long) arrayGet(deliveredPacketsFlows, i));
-				if ((unsigned long) arrayGet(deliveredPacketsFlows, i) < 1) break ;
+			//	printf(">>>> Flow %d: %d pkts delivered\n",i,intVecGet(& deliveredPacketsFlows, i));
+				if (intVecGet(& deliveredPacketsFlows, i) < 1) break ;
 			}
 
 			if (i == numberOfFlows) {
 
-				for (i = 0; i < numberOfFlows; i++) arraySet(deliveredPacketsFlows, i, 0);
+				for (i = 0; i < numberOfFlows; i++) intVecSet(& deliveredPacketsFlows, i, 0);
 //printf("Closing cicle %d at time %ld with %f delivered packets\n", lookAhead, time, deliveredPackets);
 				if (lookAhead > 1) {
 
@@ -1346,8 +1518,8 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 						//printf("FLOW %d - Mean delivered: %f (Diff: %f)\n", j, meanDPF, (deliveredPacketsPerFlow[j] - oldDeliveredPacketsPerFlow[j]));
 						//printf("Flow: %d - Mean Delivery: %ld - DPF: %ld - OLD DPF: %ld\n", j, (long) arrayGet(meanDeliveryPerFlow, j), (long) arrayGet(deliveredPacketsPerFlow, j), (long) arrayGet(oldDeliveredPacketsPerFlow, j));
 						meanDeliveryPerFlow[j] = meanDPF;
-						meanSentPerFlow[j] = meanSentPerFlow[j] * (1 - alfa) + ((long) arrayGet(permanentSentPacketsFlows,j) - oldSentPacketsPerFlow[j]) * alfa;
-						meanDelayFlows[j] = meanDelayFlows[j] + ((long) arrayGet(delayFlows,j) - oldDelayFlows[j]);
+						meanSentPerFlow[j] = meanSentPerFlow[j] * (1 - alfa) + (longVecGet(& permanentSentPacketsFlows, j) - oldSentPacketsPerFlow[j]) * alfa;
+						meanDelayFlows[j] = meanDelayFlows[j] + (longVecGet(& delayFlows, j) - oldDelayFlows[j]);
 					}
 				}
 				else {
@@ -1356,8 +1528,8 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 					//meanDelivery = deliveredPackets;
 					for (int j = 0; j < numberOfFlows; j++) {
 						meanDeliveryPerFlow[j] = deliveredPacketsPerFlow[j];
-						meanSentPerFlow[j] = (long) arrayGet(permanentSentPacketsFlows,j);
-						meanDelayFlows[j] = (long) arrayGet(delayFlows,j);
+						meanSentPerFlow[j] = longVecGet(& permanentSentPacketsFlows, j);
+						meanDelayFlows[j] = longVecGet(& delayFlows, j);
 					}
 				}
 				oldTime = time;
@@ -1365,8 +1537,8 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 				//meanInterval = meanTime / meanDelivery; 
 				for (int j = 0; j < numberOfFlows; j++) {
 					oldDeliveredPacketsPerFlow[j] = deliveredPacketsPerFlow[j];
-					oldSentPacketsPerFlow[j] = (long) arrayGet(permanentSentPacketsFlows,j);	
-					oldDelayFlows[j] = (long) arrayGet(delayFlows,j);
+					oldSentPacketsPerFlow[j] = longVecGet(& permanentSentPacketsFlows, j);	
+					oldDelayFlows[j] = longVecGet(& delayFlows, j);
 					r->meanIntervalPerFlow[j] = meanTime / meanDeliveryPerFlow[j];
 					//printf("FLOW: %d MEANDPF: %ld MEANIPF: %ld\n", j, arrayGet(meanDeliveryPerFlow, j), arrayGet(meanIntervalPerFlow,j));
 				}
@@ -1384,6 +1556,7 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 					} 
 
 					if (lookAhead > maxDeliveredPerFlow || intervalsSmallDiff) {
+							timedOut = 1;
 //printf("Search for cycle timed-out\n");
 							r->cost=0;
 							r->delay=0;
@@ -1393,7 +1566,7 @@ t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTi
 								r->packetsLossPerFlow[f] = 100 * (1 - (meanDeliveryPerFlow[f] / meanSentPerFlow[f]));	
 								r->delayFlows[f] = meanDelayFlows[f] / meanDeliveryPerFlow[f];	
 
-								float flowTime=(int) arrayGet(flowTimes, f);
+								float flowTime=(int) intVecGet(& intFlowTimes, f);
 								float meanInterval = r->meanIntervalPerFlow[f];
 								r->cost= r->cost + ((meanInterval-flowTime)/meanInterval);
 								r->rateFlows[f]= 8000/(r->meanIntervalPerFlow[f]*0.000054978);
@@ -1425,14 +1598,16 @@ printf("meanInterval = %f\n", meanInterval);
 //#endif
 		} else {
 
+			if (haveToSaveState) cycleStates++;
+
 			if (targetTime <= time) {
 				//printf("Found perfect solution. Cicle between %lu and %lu\n", stateGetCurrentTime(oldState), time);
 				if (deliveredPackets) {
 					r->cost=0;
 					r->delay=0;
 					for (int f = 0; f < numberOfFlows; f++){ 
-						double deliveredPacketsFlowsBetweenStates = (((long) arrayGet(permanentDeliveredPacketsFlows,f)) / (float) GRAPH_MULTIPLIER) - (((long) arrayGet(stateGetDeliveredPacketsFlows(oldState),f)) / (float) GRAPH_MULTIPLIER);
-						long sentPacketsFlowsBetweenStates = (long) (arrayGet(permanentSentPacketsFlows,f) - arrayGet(stateGetSentPacketsFlows(oldState),f));
+						double deliveredPacketsFlowsBetweenStates = (longVecGet(& permanentDeliveredPacketsFlows, f) - longVecGet(stateGetDeliveredPacketsFlows(oldState), f)) / (float) GRAPH_MULTIPLIER;
+						long sentPacketsFlowsBetweenStates = (long) (longVecGet(& permanentSentPacketsFlows, f) - longVecGet(stateGetSentPacketsFlows(oldState), f));
 
 						//printf("lossPacketsFlowsBetweenStates = %d ,  deliveredPacketsFlowsBetweenStates = %f\n", lossPacketsFlowsBetweenStates, deliveredPacketsFlowsBetweenStates);
 						//printf("Flow %d, deliveredPacketsFlowsBetweenStates = %.0f\n", f, deliveredPacketsFlowsBetweenStates);
@@ -1443,13 +1618,13 @@ printf("meanInterval = %f\n", meanInterval);
 
 							r->meanIntervalPerFlow[f] = timeBetweenStates / deliveredPacketsFlowsBetweenStates;
 							r->packetsLossPerFlow[f] = 100 * (1 - deliveredPacketsFlowsBetweenStates / sentPacketsFlowsBetweenStates);
-							//r->delayFlows[f] = ((long) delayFlows - ((long) arrayGet(stateGetDelayFlows(oldState),f))) / deliveredPacketsFlowsBetweenStates;
-							//r->delayFlows[f]=(long) (arrayGet(stateGetDelayFlows(state),f) - arrayGet(stateGetDelayFlows(oldState),f))/deliveredPacketsFlowsBetweenStates;
-							r->delayFlows[f]=(long) (arrayGet(delayFlows,f) - arrayGet(stateGetDelayFlows(oldState),f))/deliveredPacketsFlowsBetweenStates;
+							//r->delayFlows[f] = ((long) delayFlows - (longVecGet(stateGetDelayFlows(oldState), f))) / deliveredPacketsFlowsBetweenStates;
+							//r->delayFlows[f]=(long) (longVecGet(stateGetDelayFlows(state), f) - longVecGet(stateGetDelayFlows(oldState), f))/deliveredPacketsFlowsBetweenStates;
+							r->delayFlows[f]=(long) (longVecGet(& delayFlows, f) - longVecGet(stateGetDelayFlows(oldState), f))/deliveredPacketsFlowsBetweenStates;
 							
 
 
-							//long d = ((long) delayFlows - ((long) arrayGet(stateGetDelayFlows(oldState),f))) / deliveredPacketsFlowsBetweenStates;
+							//long d = ((long) delayFlows - (longVecGet(stateGetDelayFlows(oldState), f))) / deliveredPacketsFlowsBetweenStates;
 
 							//printf("Current STATE Time: %f\n", (float) stateGetCurrentTime(state));
 							//printf("Last saved STATE Time: %f\n", (float) stateGetCurrentTime(oldState));
@@ -1460,8 +1635,8 @@ printf("meanInterval = %f\n", meanInterval);
 
 							//printf(">>>> MeanIntervalPerFlow = %f\n", r->meanIntervalPerFlow[f]);
 
-							//printf(">>>> SentPacketsFlowsBetweenStates = %ld (%ld-%ld)\n", sentPacketsFlowsBetweenStates, (long) arrayGet(permanentSentPacketsFlows,f), (long) arrayGet(stateGetSentPacketsFlows(oldState),f));
-							//printf(">>>> DeliveredPacketsFlowsBetweenStates = %.4f (%.4f-%.4f)\n", deliveredPacketsFlowsBetweenStates, (((long) arrayGet(permanentDeliveredPacketsFlows,f)) / (float) GRAPH_MULTIPLIER) , (((long) arrayGet(stateGetDeliveredPacketsFlows(oldState),f)) / (float) GRAPH_MULTIPLIER));
+							//printf(">>>> SentPacketsFlowsBetweenStates = %ld (%ld-%ld)\n", sentPacketsFlowsBetweenStates, longVecGet(& permanentSentPacketsFlows, f), longVecGet(stateGetSentPacketsFlows(oldState), f));
+							//printf(">>>> DeliveredPacketsFlowsBetweenStates = %.4f (%.4f-%.4f)\n", deliveredPacketsFlowsBetweenStates, ((longVecGet(& permanentDeliveredPacketsFlows, f)) / (float) GRAPH_MULTIPLIER) , ((longVecGet(stateGetDeliveredPacketsFlows(oldState), f)) / (float) GRAPH_MULTIPLIER));
 							//printf(">>>> TimeBetweenStates = %.0f (%.0f - %.0f)\n", timeBetweenStates, (float) time, (float) stateGetCurrentTime(oldState));
 						} else {
 						    r->meanIntervalPerFlow[f] = GRAPH_INFINITY;
@@ -1469,7 +1644,7 @@ printf("meanInterval = %f\n", meanInterval);
 							r->delayFlows[f] = 0;
 							
 						}
-						float flowTime=(int) arrayGet(flowTimes, f);
+						float flowTime=(int) intVecGet(& intFlowTimes, f);
 						float meanInterval = r->meanIntervalPerFlow[f];
 						if (meanInterval<flowTime) meanInterval=flowTime;
 						r->cost= r->cost + ((meanInterval-flowTime)/meanInterval);
@@ -1480,7 +1655,7 @@ printf("meanInterval = %f\n", meanInterval);
 						
 						//r->rateFlows[f]=r->meanIntervalPerFlow[f];
 //printf("meanIntervalFlow = %f\n", r->meanIntervalFlow[f]);
-//printf("meanIntervalFlowPermanent = %f\n",(float) (time/correctionFactors[f]/(long)arrayGet(permanentDeliveredPacketsFlows, f)));
+//printf("meanIntervalFlowPermanent = %f\n",(float) (time/correctionFactors[f]/(long)longVecGet(& permanentDeliveredPacketsFlows, f)));
 			
 					}
 
@@ -1519,9 +1694,29 @@ printf("meanInterval = %f\n", meanInterval);
 
 	}
 
+	r->stats = NULL;
+	if (collectStats) {
+
+		clock_gettime(CLOCK_MONOTONIC, & loopEnd);
+
+		MALLOC(r->stats, sizeof(t_simulationStats));
+		r->stats->iterations = iterations;
+		r->stats->statesSaved = statesSaved;
+		r->stats->collisions = stateCycle ? stateCycle->collisions : stateStorage->collisions;
+		r->stats->cycleStates = cycleStates;
+		r->stats->cycleTime = cycleTime;
+		r->stats->timedOut = timedOut;
+		r->stats->droppedPackets = queues->droppedPackets;
+		r->stats->numberOfNodes = graphSize(graph);
+		MALLOC(r->stats->maxQueueDepth, sizeof(int) * graphSize(graph));
+		memcpy(r->stats->maxQueueDepth, queues->maxDepth, sizeof(int) * graphSize(graph));
+		r->stats->setupTime = simulationElapsed(& setupStart, & loopStart);
+		r->stats->loopTime = simulationElapsed(& loopStart, & loopEnd);
+	}
+
 	for (i = 0; i < graphSize(graph); i++) {
 
-		if ((packet = arrayGet(backoff, i)) == NULL) continue ;
+		if ((packet = backoff[i]) == NULL) continue ;
 
 		free(packet);
 	}
@@ -1539,41 +1734,48 @@ printf("meanInterval = %f\n", meanInterval);
 	free(meanDelayFlows);
 	free(oldDelayFlows);
 
-	arrayFree(permanentDeliveredPacketsFlows);
-	free(permanentDeliveredPacketsFlows);
-	arrayFree(permanentSentPacketsFlows);
-	free(permanentSentPacketsFlows);
+	longVecFree(& permanentDeliveredPacketsFlows);
+	longVecFree(& permanentSentPacketsFlows);
 
-	arrayFree(delayFlows);
-	free(delayFlows);
-	arrayFree(idPacketFlows);
-	free(idPacketFlows);
+	longVecFree(& delayFlows);
+	longVecFree(& idPacketFlows);
+	longVecFree(& scheduleFlowTime);
+	free(traffic);
 
 
-	free(backoffUnit);
-	free(numberOfRetries);
-	arrayFree(backoff);
 	free(backoff);
-	arrayFree(deliveredPacketsFlows);
-	free(deliveredPacketsFlows);
-	arrayFree(blockedLinks);
-	free(blockedLinks);
-	arrayFree(priorityBlockedNodes);
-	free(priorityBlockedNodes);
-	arrayFree(priorityBlockedLinks);
-	free(priorityBlockedLinks);
+	intVecFree(& deliveredPacketsFlows);
+	intVecFree(& blockedLinks);
+	intVecFree(& priorityBlockedNodes);
+	intVecFree(& priorityBlockedLinks);
+	for (i = 0; i < numberOfFlows; i++) u16PathFree(& flowPaths[i]);
+	free(flowPaths);
+	intVecFree(& intFlowTimes);
+	intVecFree(& intTxDurations);
 	free(linkIndexBase);
-	stateStorageFreeWithData(stateStorage);
-	free(stateStorage);
+	if (stateCycle) {
+
+		stateCycleFreeWithData(stateCycle);
+		free(stateCycle);
+	}
+	else {
+
+		stateStorageFreeWithData(stateStorage);
+		free(stateStorage);
+	}
 	graphFree(conflict);
 	free(conflict);
 	queuesFree(queues);
 	free(queues);
-	listFree(waitingNodes);
-	free(waitingNodes);
-	listFree(onTransmissionPackets);
-	free(onTransmissionPackets);
-	free(airTime);
+	slabFree(& slab);
+	free(hopLink);
+	free(backoffTicks);
+
+	if (r->stats) {
+
+		clock_gettime(CLOCK_MONOTONIC, & teardownEnd);
+		r->stats->teardownTime = simulationElapsed(& loopEnd, & teardownEnd);
+	}
 //printf("Leaving at %lu and returning %.2f\n", times(NULL), meanInterval);
 //printf("We had %u packets at %llu and %u packets at %llu\n", stateGetDeliveredPackets(oldState), stateGetCurrentTime(oldState), stateGetDeliveredPackets(state), stateGetCurrentTime(state));
 
@@ -1585,4 +1787,122 @@ printf("meanInterval = %f\n", meanInterval);
 }
 		
 
+/*
+ * Number of worker threads used by simulationSimulateBatch.
+ * 0 means one per online processor, but at most BATCH_HASH_THREADS in
+ * SIMULATION_CYCLE_HASH mode: there each simulation holds a hash table
+ * of STATE_HASH_SIZE slots (128 MB), and the search workers may run
+ * batches at the same time.
+ */
+#define BATCH_HASH_THREADS	4
+
+static int batchThreads = 0;
+
+void simulationSetBatchThreads(int numberOfThreads) {
+
+	batchThreads = numberOfThreads;
+}
+
+typedef struct {
+
+	t_graph * graph;
+	t_array ** pathSets;
+	int numberOfPathSets;
+	t_array * flowTimes;
+	t_array * frameTxDurations;
+	t_return ** results;
+	int next;
+	pthread_mutex_t lock;
+} t_batch;
+
+static void * simulationBatchWorker(void * arg) {
+
+	t_batch * batch = arg;
+	int i;
+
+	while (1) {
+
+		pthread_mutex_lock(& batch->lock);
+		i = batch->next++;
+		pthread_mutex_unlock(& batch->lock);
+
+		if (i >= batch->numberOfPathSets) break ;
+
+		batch->results[i] = simulationSimulate(batch->graph, batch->pathSets[i], batch->flowTimes, batch->frameTxDurations);
+	}
+
+	return(NULL);
+}
+
+/*
+ * Simulate n path sets, storing the result of pathSets[i] in results[i].
+ * Path sets are handed to the workers in input order. The link table
+ * of the graph is built before the workers start, so they share it
+ * read-only. In SIMULATION_CYCLE_HASH mode each worker holds its own
+ * state hash table, so memory grows with the number of threads.
+ */
+void simulationSimulateBatch(t_graph * graph, t_array * pathSets[], int n, t_array * flowTimes, t_array * frameTxDurations, t_return * results[]) {
+
+	t_batch batch;
+	pthread_t * threads;
+	int numberOfThreads, i;
+
+	if (n <= 0) return ;
+
+	linkTableGet(graph);
 
+	batch.graph = graph;
+	batch.pathSets = pathSets;
+	batch.numberOfPathSets = n;
+	batch.flowTimes = flowTimes;
+	batch.frameTxDurations = frameTxDurations;
+	batch.results = results;
+	batch.next = 0;
+	pthread_mutex_init(& batch.lock, NULL);
+
+	numberOfThreads = batchThreads;
+	if (numberOfThreads <= 0) {
+
+		numberOfThreads = sysconf(_SC_NPROCESSORS_ONLN);
+		if (cycleDetection == SIMULATION_CYCLE_HASH && numberOfThreads > BATCH_HASH_THREADS) numberOfThreads = BATCH_HASH_THREADS;
+	}
+	if (numberOfThreads > n) numberOfThreads = n;
+	if (numberOfThreads < 1) numberOfThreads = 1;
+
+	/*
+	 * The calling thread is one of the workers.
+	 */
+	MALLOC(threads, sizeof(pthread_t) * numberOfThreads);
+	for (i = 1; i < numberOfThreads; i++) {
+
+		if (pthread_create(& threads[i], NULL, simulationBatchWorker, & batch)) {
+
+			fprintf(stderr, "Could not create simulation thread\n");
+			exit(1);
+		}
+	}
+
+	simulationBatchWorker(& batch);
+
+	for (i = 1; i < numberOfThreads; i++) pthread_join(threads[i], NULL);
+
+	pthread_mutex_destroy(& batch.lock);
+	free(threads);
+}
+
+void simulationReturnFree(t_return * r) {
+
+	free(r->meanIntervalPerFlow);
+	free(r->packetsLossPerFlow);
+	free(r->delayFlows);
+	free(r->rateFlows);
+	free(r->optimal->packetDeliveredBetweenStates);
+	free(r->optimal->packetSentBetweenStates);
+	free(r->optimal->timeBetweenStates);
+	free(r->optimal);
+	if (r->stats) {
+
+		free(r->stats->maxQueueDepth);
+		free(r->stats);
+	}
+}
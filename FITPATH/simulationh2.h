@@ -10,6 +10,26 @@ typedef struct {
 		float * timeBetweenStates;
 } t_optimal_cycle;
 
+/*
+ * Counters of a single simulation, filled only after
+ * simulationSetStats(1). Times are wall-clock seconds.
+ */
+typedef struct {
+
+	unsigned long iterations;		// Main loop iterations.
+	unsigned long statesSaved;		// States handed to cycle detection.
+	unsigned long collisions;		// Equal hash (or fingerprint), different state.
+	unsigned long cycleStates;		// States saved along the repeating cycle.
+	t_weight cycleTime;				// Length of the repeating cycle.
+	int timedOut;					// The cycle search gave up (lookAhead limit).
+	unsigned long droppedPackets;	// Packets discarded on queue overflow.
+	int numberOfNodes;
+	int * maxQueueDepth;			// Longest queue seen at each node.
+	double setupTime;
+	double loopTime;
+	double teardownTime;
+} t_simulationStats;
+
 typedef struct {
 		float * meanIntervalPerFlow;
 		float * packetsLossPerFlow;
@@ -21,9 +41,21 @@ typedef struct {
         float delay;
         float * rateFlows;
         t_optimal_cycle * optimal;
+        t_simulationStats * stats;
 } t_return;
 
+typedef enum {
+
+	SIMULATION_CYCLE_HASH,
+	SIMULATION_CYCLE_BRENT,
+} t_cycleDetection;
+
+void simulationSetCycleDetection(t_cycleDetection mode);
+void simulationSetStats(int enabled);
 t_return * simulationSimulate(t_graph * graph, t_array * paths, t_array * flowTimes, t_array * txDurations);
+void simulationSetBatchThreads(int numberOfThreads);
+void simulationSimulateBatch(t_graph * graph, t_array * pathSets[], int n, t_array * flowTimes, t_array * txDurations, t_return * results[]);
+void simulationReturnFree(t_return * r);
 
 #endif
 
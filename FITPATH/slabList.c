@@ -0,0 +1,117 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "slabList.h"
+#include "memory.h"
+
+void slabInit(t_slab * slab) {
+
+	slab->freeNodes = NULL;
+	slab->chunks = NULL;
+	slab->numberOfChunks = 0;
+}
+
+/*
+ * Release every chunk. Lists still using the slab become invalid.
+ */
+void slabFree(t_slab * slab) {
+
+	int i;
+
+	for (i = 0; i < slab->numberOfChunks; i++) free(slab->chunks[i]);
+	free(slab->chunks);
+	slabInit(slab);
+}
+
+static t_slabNode * slabAlloc(t_slab * slab) {
+
+	t_slabNode * chunk, * node;
+	int i;
+
+	if (slab->freeNodes == NULL) {
+
+		MALLOC(chunk, sizeof(t_slabNode) * SLAB_CHUNK_NODES);
+		REALLOC(slab->chunks, sizeof(t_slabNode *) * (slab->numberOfChunks + 1));
+		slab->chunks[slab->numberOfChunks++] = chunk;
+
+		for (i = 0; i < SLAB_CHUNK_NODES - 1; i++) chunk[i].next = & chunk[i + 1];
+		chunk[i].next = NULL;
+		slab->freeNodes = chunk;
+	}
+
+	node = slab->freeNodes;
+	slab->freeNodes = node->next;
+
+	return(node);
+}
+
+static void slabRelease(t_slab * slab, t_slabNode * node) {
+
+	node->next = slab->freeNodes;
+	slab->freeNodes = node;
+}
+
+void slabListInit(t_slabList * list, t_slab * slab) {
+
+	list->slab = slab;
+	list->first = NULL;
+	list->last = NULL;
+	list->length = 0;
+}
+
+t_slabNode * slabListAdd(t_slabList * list, void * data) {
+
+	t_slabNode * node;
+
+	node = slabAlloc(list->slab);
+	node->data = data;
+	node->next = NULL;
+	node->prev = list->last;
+
+	if (list->last) list->last->next = node;
+	else list->first = node;
+
+	list->last = node;
+	list->length++;
+
+	return(node);
+}
+
+void slabListDel(t_slabList * list, t_slabNode * node) {
+
+	if (node->prev) node->prev->next = node->next;
+	else list->first = node->next;
+
+	if (node->next) node->next->prev = node->prev;
+	else list->last = node->prev;
+
+	list->length--;
+	slabRelease(list->slab, node);
+}
+
+/*
+ * Return every node to the slab. The elements are left alone.
+ */
+void slabListClear(t_slabList * list) {
+
+	t_slabNode * node, * next;
+
+	for (node = list->first; node; node = next) {
+
+		next = node->next;
+		slabRelease(list->slab, node);
+	}
+
+	list->first = NULL;
+	list->last = NULL;
+	list->length = 0;
+}
+
+void slabListFreeWithData(t_slabList * list) {
+
+	t_slabNode * node;
+
+	for (node = list->first; node; node = node->next) free(node->data);
+	slabListClear(list);
+}
@@ -0,0 +1,85 @@
+#ifndef __SLABLIST_H__
+#define __SLABLIST_H__
+
+/*
+ * Doubly linked list whose nodes come from a slab: chunks of
+ * SLAB_CHUNK_NODES nodes, recycled through a free list. Lists that
+ * share a slab (e.g., all the queues of a simulation) stop paying a
+ * malloc per element once the slab has warmed up.
+ *
+ * slabListAdd returns the node holding the element. The node stays
+ * valid until it is deleted, so an element can keep its node and be
+ * removed in constant time. There is no cursor in the list; callers
+ * walk the nodes themselves, and may delete the node they are on
+ * provided they fetched the next one first:
+ *
+ *	for (node = slabListFirst(list); node; node = next) {
+ *
+ *		next = slabNodeNext(node);
+ *		...
+ *	}
+ */
+#define SLAB_CHUNK_NODES	256
+
+typedef struct t_slabNode {
+
+	void * data;
+	struct t_slabNode * next;
+	struct t_slabNode * prev;
+} t_slabNode;
+
+typedef struct {
+
+	t_slabNode * freeNodes;
+	t_slabNode ** chunks;
+	int numberOfChunks;
+} t_slab;
+
+typedef struct {
+
+	t_slab * slab;
+	t_slabNode * first;
+	t_slabNode * last;
+	int length;
+} t_slabList;
+
+void slabInit(t_slab * slab);
+void slabFree(t_slab * slab);
+
+void slabListInit(t_slabList * list, t_slab * slab);
+t_slabNode * slabListAdd(t_slabList * list, void * data);
+void slabListDel(t_slabList * list, t_slabNode * node);
+void slabListClear(t_slabList * list);
+void slabListFreeWithData(t_slabList * list);
+
+static inline t_slabNode * slabListFirst(t_slabList * list) {
+
+	return(list->first);
+}
+
+static inline t_slabNode * slabListLast(t_slabList * list) {
+
+	return(list->last);
+}
+
+static inline int slabListLength(t_slabList * list) {
+
+	return(list->length);
+}
+
+static inline t_slabNode * slabNodeNext(t_slabNode * node) {
+
+	return(node->next);
+}
+
+static inline t_slabNode * slabNodePrev(t_slabNode * node) {
+
+	return(node->prev);
+}
+
+static inline void * slabNodeData(t_slabNode * node) {
+
+	return(node->data);
+}
+
+#endif
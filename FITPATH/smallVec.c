@@ -0,0 +1,29 @@
+#include <string.h>
+
+#include "smallVec.h"
+#include "memory.h"
+
+void smallVecInit(t_smallVec * vec) {
+
+	vec->data = vec->inlineData;
+	vec->length = 0;
+	vec->capacity = SMALLVEC_INLINE;
+}
+
+void smallVecGrow(t_smallVec * vec) {
+
+	int * data;
+
+	MALLOC(data, sizeof(int) * 2 * vec->capacity);
+	memcpy(data, vec->data, sizeof(int) * vec->length);
+	if (vec->data != vec->inlineData) free(vec->data);
+
+	vec->data = data;
+	vec->capacity *= 2;
+}
+
+void smallVecFree(t_smallVec * vec) {
+
+	if (vec->data != vec->inlineData) free(vec->data);
+	smallVecInit(vec);
+}
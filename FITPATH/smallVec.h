@@ -0,0 +1,61 @@
+#ifndef __SMALLVEC_H__
+#define __SMALLVEC_H__
+
+/*
+ * Growable vector of ints for lists that are only appended to and
+ * iterated, like neighborhoods and state buffer lists. The first
+ * SMALLVEC_INLINE elements live in the struct itself, so most of
+ * them never allocate; beyond that, storage doubles. Since data may
+ * point into the struct, a t_smallVec must not be copied or moved
+ * after smallVecInit.
+ *
+ * Iteration uses a pointer owned by the caller:
+ *
+ *	for (p = smallVecBegin(vec); p < smallVecEnd(vec); p++) ...
+ */
+#define SMALLVEC_INLINE		4
+
+typedef struct {
+
+	int * data;
+	int length;
+	int capacity;
+	int inlineData[SMALLVEC_INLINE];
+} t_smallVec;
+
+void smallVecInit(t_smallVec * vec);
+void smallVecGrow(t_smallVec * vec);
+void smallVecFree(t_smallVec * vec);
+
+static inline void smallVecAdd(t_smallVec * vec, int value) {
+
+	if (vec->length == vec->capacity) smallVecGrow(vec);
+	vec->data[vec->length++] = value;
+}
+
+static inline int smallVecGet(const t_smallVec * vec, int index) {
+
+	return(vec->data[index]);
+}
+
+static inline int smallVecLength(const t_smallVec * vec) {
+
+	return(vec->length);
+}
+
+static inline int * smallVecBegin(t_smallVec * vec) {
+
+	return(vec->data);
+}
+
+static inline int * smallVecEnd(t_smallVec * vec) {
+
+	return(vec->data + vec->length);
+}
+
+static inline void smallVecClear(t_smallVec * vec) {
+
+	vec->length = 0;
+}
+
+#endif
@@ -61,12 +61,12 @@ void stateSetCurrentTime(t_state * state, t_weight currentTime) {
 	state->currentTime = currentTime;
 }
 
-void stateSetDeliveredPackets(t_state * state, unsigned int deliveredPackets) {
+void stateSetDeliveredPackets(t_state * state, t_deliveredPackets deliveredPackets) {
 
 	state->deliveredPackets = deliveredPackets;
 }
 
-unsigned int stateGetDeliveredPackets(t_state * state) {
+t_deliveredPackets stateGetDeliveredPackets(t_state * state) {
 
 	return(state->deliveredPackets);
 }
@@ -129,6 +129,7 @@ t_stateStorage * stateStorageNew(int hashSize) {
 	arrayClear(stateStorage->hashTable);
 
 	stateStorage->usedSlots = setNew();
+	setReserve(stateStorage->usedSlots, hashSize - 1);
 
 	return(stateStorage);
 }
@@ -167,15 +168,12 @@ void stateFree(t_state * state) {
 
 void stateStorageFreeWithData(t_stateStorage * stateStorage) {
 
-	t_list * list;
 	t_list * hashEntry;
 	t_state * state;
-	unsigned long i;
+	int i;
 
-	list = setGetElements(stateStorage->usedSlots);
-	for (i = (unsigned long) listBegin(list); i; i = (unsigned long) listNext(list)) {
+	for (i = setFirst(stateStorage->usedSlots); i >= 0; i = setNext(stateStorage->usedSlots, i)) {
 
-		i = i - 1;
 		hashEntry = arrayGet(stateStorage->hashTable, i);
 
 		for (state = listBegin(hashEntry); state; state = listNext(hashEntry)) {
@@ -185,8 +183,6 @@ void stateStorageFreeWithData(t_stateStorage * stateStorage) {
 		listFreeWithData(hashEntry);
 		free(hashEntry);
 	}
-	listFree(list);
-	free(list);
 	setFree(stateStorage->usedSlots);
 	free(stateStorage->usedSlots);
 	arrayFree(stateStorage->hashTable);
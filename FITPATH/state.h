@@ -6,6 +6,17 @@
 #include "graph.h"
 #include "list.h"
 
+/*
+ * Delivered packets are counted whole, or weighted by their delivery
+ * probability when built with STATE_FRACTIONAL_DELIVERY (stateh.o,
+ * for simulationh).
+ */
+#ifdef STATE_FRACTIONAL_DELIVERY
+typedef double t_deliveredPackets;
+#else
+typedef unsigned int t_deliveredPackets;
+#endif
+
 typedef struct {
 
 	unsigned long * transmissionBitmap;
@@ -14,7 +25,7 @@ typedef struct {
 	unsigned long slots;
 	t_weight * times;
 	t_weight currentTime;
-	unsigned int deliveredPackets;
+	t_deliveredPackets deliveredPackets;
 	unsigned long hash;
 } t_state;
 
@@ -29,8 +40,8 @@ t_state * stateNew(unsigned int slots);
 void stateAddTransmission(t_state * state, unsigned long index, t_weight time);
 void stateAddBuffer(t_state * state, unsigned long index);
 void stateSetCurrentTime(t_state * state, t_weight currentTime);
-void stateSetDeliveredPackets(t_state * state, unsigned int deliveredPackets);
-unsigned int stateGetDeliveredPackets(t_state * state);
+void stateSetDeliveredPackets(t_state * state, t_deliveredPackets deliveredPackets);
+t_deliveredPackets stateGetDeliveredPackets(t_state * state);
 t_weight stateGetCurrentTime(t_state * state);
 t_state * stateLookupAndStore(t_state * state, t_stateStorage * stateStorage);
 t_stateStorage * stateStorageNew(int hashSize);
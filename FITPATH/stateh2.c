@@ -6,6 +6,7 @@
 
 #include <string.h>
 #include <strings.h>
+#include <limits.h>
 
 t_state * stateNew(unsigned int slots, int numberOfFlows) {
 
@@ -20,29 +21,35 @@ t_state * stateNew(unsigned int slots, int numberOfFlows) {
 	MALLOC(state->transmissionBitmap, bytesNeeded);
 	MALLOC(state->backoffBitmap, bytesNeeded);
 	MALLOC(state->retries, 2 * bytesNeeded);
-	MALLOC(state->times, sizeof(t_weight) * slots);
-	MALLOC(state->waitingSince, sizeof(t_weight) * slots);
-	state->bufferList = listNew();
+	MALLOC(state->times, sizeof(t_stateTime) * slots);
+	MALLOC(state->waitingSince, sizeof(t_stateTime) * slots);
+	MALLOC(state->arrivals, 2 * sizeof(long) * numberOfFlows);
+	smallVecInit(& state->bufferList);
 
 	memset(state->transmissionBitmap, 0, bytesNeeded);
 	memset(state->backoffBitmap, 0, bytesNeeded);
 	memset(state->retries, 0, 2 * bytesNeeded);
-	memset(state->times, 0, sizeof(t_weight) * slots);
-	memset(state->waitingSince, 0, sizeof(t_weight) * slots);
+	memset(state->times, 0, sizeof(t_stateTime) * slots);
+	memset(state->waitingSince, 0, sizeof(t_stateTime) * slots);
+	memset(state->arrivals, 0, 2 * sizeof(long) * numberOfFlows);
+	state->wide = 0;
+	state->numberOfFlows = numberOfFlows;
 
 	state->deliveredPackets = 0;
 	state->currentTime = 0.0;
 	state->entries = entriesNeeded;
 	state->slots = slots;
 
-	state->deliveredPacketsFlows = arrayNew(numberOfFlows);
-	for (int i = 0; i < numberOfFlows; i++) arraySet(state->deliveredPacketsFlows, i, 0);
-	
-	state->sentPacketsFlows = arrayNew(numberOfFlows);
-	for (int i = 0; i < numberOfFlows; i++) arraySet(state->sentPacketsFlows, i, 0);
-	
-	state->delayFlows = arrayNew(numberOfFlows);
-	for (int i = 0; i < numberOfFlows; i++) arraySet(state->delayFlows, i, 0);
+	/*
+	 * A state is built on every step of the simulation, so the
+	 * three per flow totals take a single allocation.
+	 */
+	longVecInit(& state->deliveredPacketsFlows, 3 * numberOfFlows);
+	state->deliveredPacketsFlows.length = numberOfFlows;
+	state->sentPacketsFlows.data = state->deliveredPacketsFlows.data + numberOfFlows;
+	state->sentPacketsFlows.length = numberOfFlows;
+	state->delayFlows.data = state->deliveredPacketsFlows.data + 2 * numberOfFlows;
+	state->delayFlows.length = numberOfFlows;
 
 	return(state);
 }
@@ -56,6 +63,9 @@ void stateAddTransmission(t_state * state, unsigned long index, t_weight time, u
 
 	state->transmissionBitmap[entryIndex] |= (1 << bitIndex);
 
+#ifdef USE_INT_WEIGHT
+	if (time > STATE_TIME_MAX || waitingSince > STATE_TIME_MAX) state->wide = 1;
+#endif
 	state->times[index] = time;
 	state->waitingSince[index] = waitingSince;
 
@@ -68,9 +78,28 @@ void stateAddTransmission(t_state * state, unsigned long index, t_weight time, u
 	state->retries[entryIndex] |= (retries << bitIndex);
 }
 
-void stateAddBuffer(t_state * state, unsigned long index) {
+/*
+ * The age of a queued packet decides the delay and the packet
+ * id it will be delivered with, so it is part of the state too.
+ */
+void stateAddBuffer(t_state * state, unsigned long index, t_weight age) {
+
+#ifdef USE_INT_WEIGHT
+	if (age > INT_MAX) state->wide = 1;
+#endif
+	smallVecAdd(& state->bufferList, index);
+	smallVecAdd(& state->bufferList, age);
+}
+
+/*
+ * Where each flow is in its traffic: two states with the same packets
+ * in the network but a different time to the next arrival of some flow
+ * do not repeat each other.
+ */
+void stateSetArrival(t_state * state, int flow, long nextArrival, long trafficPosition) {
 
-	listAdd(state->bufferList, (void *) index + 1);
+	state->arrivals[2 * flow] = nextArrival;
+	state->arrivals[2 * flow + 1] = trafficPosition;
 }
 
 void stateSetCurrentTime(t_state * state, t_weight currentTime) {
@@ -88,37 +117,34 @@ double stateGetDeliveredPackets(t_state * state) {
 	return(state->deliveredPackets);
 }
 
-void stateSetDeliveredPacketsFlows(t_state * state, t_array * deliveredPacketsFlows) {
+void stateSetDeliveredPacketsFlows(t_state * state, t_longVec * deliveredPacketsFlows) {
 
-	for (int i = 0; i < arrayLength(deliveredPacketsFlows); i++)
-		arraySet(state->deliveredPacketsFlows, i, arrayGet(deliveredPacketsFlows,i));
+	longVecCopy(& state->deliveredPacketsFlows, deliveredPacketsFlows);
 }
 
-t_array * stateGetDeliveredPacketsFlows(t_state * state) {
+t_longVec * stateGetDeliveredPacketsFlows(t_state * state) {
 
-	return(state->deliveredPacketsFlows);
+	return(& state->deliveredPacketsFlows);
 }
 
-void stateSetSentPacketsFlows(t_state * state, t_array * sentPacketsFlows) {
+void stateSetSentPacketsFlows(t_state * state, t_longVec * sentPacketsFlows) {
 
-	for (int i = 0; i < arrayLength(sentPacketsFlows); i++) 
-		arraySet(state->sentPacketsFlows, i, arrayGet(sentPacketsFlows,i));
+	longVecCopy(& state->sentPacketsFlows, sentPacketsFlows);
 }
 
-t_array * stateGetSentPacketsFlows(t_state * state) {
+t_longVec * stateGetSentPacketsFlows(t_state * state) {
 
-	return(state->sentPacketsFlows);
+	return(& state->sentPacketsFlows);
 }
 
-void stateSetDelayFlows(t_state * state, t_array * delayFlows) {
+void stateSetDelayFlows(t_state * state, t_longVec * delayFlows) {
 
-	for (int i = 0; i < arrayLength(delayFlows); i++) 
-		arraySet(state->delayFlows, i, arrayGet(delayFlows,i));
+	longVecCopy(& state->delayFlows, delayFlows);
 }
 
-t_array * stateGetDelayFlows(t_state * state) {
+t_longVec * stateGetDelayFlows(t_state * state) {
 
-	return(state->delayFlows);
+	return(& state->delayFlows);
 }
 
 t_weight stateGetCurrentTime(t_state * state) {
@@ -196,6 +222,7 @@ unsigned long stateComputeHash(t_state * state) {
 	};
 	unsigned long crc = 0;
 	unsigned long element;
+	int * buffer;
 	int i;
 	int j;
 	unsigned char * data;
@@ -224,21 +251,27 @@ unsigned long stateComputeHash(t_state * state) {
 	for (i = 0; i < state->slots; i++) {
 
 		data = & (state->times[i]);
-		for (j = 0; j < sizeof(t_weight); j++)
+		for (j = 0; j < sizeof(t_stateTime); j++)
 			crc = table[data[j] ^ ((crc >> 16) & 0xff)] ^ (crc << 8);
 	}
 
 	for (i = 0; i < state->slots; i++) {
 
 		data = & (state->waitingSince[i]);
-		for (j = 0; j < sizeof(t_weight); j++)
+		for (j = 0; j < sizeof(t_stateTime); j++)
+			crc = table[data[j] ^ ((crc >> 16) & 0xff)] ^ (crc << 8);
+	}
+
+	for (i = 0; i < 2 * state->numberOfFlows; i++) {
+
+		data = & (state->arrivals[i]);
+		for (j = 0; j < sizeof(long); j++)
 			crc = table[data[j] ^ ((crc >> 16) & 0xff)] ^ (crc << 8);
 	}
 
-	for (element = (unsigned long) listBegin(state->bufferList); 
-		element; 
-		element = (unsigned long) listNext(state->bufferList)) {
+	for (buffer = smallVecBegin(& state->bufferList); buffer < smallVecEnd(& state->bufferList); buffer++) {
 
+		element = * buffer;
 		data = & (element);
 		for (j = 0; j < sizeof(unsigned long); j++)
 			crc = table[data[j] ^ ((crc >> 16) & 0xff)] ^ (crc << 8);
@@ -248,9 +281,34 @@ unsigned long stateComputeHash(t_state * state) {
 	return(crc & 0xFFFFFF);
 }
 
+int stateEquals(t_state * state1, t_state * state2) {
+
+	if (state1->wide || state2->wide)
+		return(0);
+	if (memcmp(state1->transmissionBitmap, state2->transmissionBitmap, sizeof(unsigned long) * state2->entries))
+		return(0);
+	if (memcmp(state1->backoffBitmap, state2->backoffBitmap, sizeof(unsigned long) * state2->entries))
+		return(0);
+	if (memcmp(state1->retries, state2->retries, 2 * sizeof(unsigned long) * state2->entries))
+		return(0);
+	if (memcmp(state1->times, state2->times, sizeof(t_stateTime) * state2->slots))
+		return(0);
+	if (memcmp(state1->waitingSince, state2->waitingSince, sizeof(t_stateTime) * state2->slots))
+		return(0);
+	if (memcmp(state1->arrivals, state2->arrivals, 2 * sizeof(long) * state2->numberOfFlows))
+		return(0);
+
+	if (smallVecLength(& state1->bufferList) != smallVecLength(& state2->bufferList))
+		return(0);
+	if (memcmp(smallVecBegin(& state1->bufferList), smallVecBegin(& state2->bufferList), sizeof(int) * smallVecLength(& state2->bufferList)))
+		return(0);
+
+	return(1);
+}
+
 t_state * stateLookupAndStore(t_state * state, t_stateStorage * stateStorage) {
 
-	unsigned long hash, element1, element2;
+	unsigned long hash;
 	t_list * hashEntry;
 	t_state * pState;
 
@@ -261,28 +319,8 @@ t_state * stateLookupAndStore(t_state * state, t_stateStorage * stateStorage) {
 
 		for (pState = listBegin(hashEntry); pState; pState = listNext(hashEntry)) {
 
-			if (memcmp(pState->transmissionBitmap, state->transmissionBitmap, sizeof(unsigned long) * state->entries))
-				continue ;
-			if (memcmp(pState->backoffBitmap, state->backoffBitmap, sizeof(unsigned long) * state->entries))
-				continue ;
-			if (memcmp(pState->retries, state->retries, 2 * sizeof(unsigned long) * state->entries))
-				continue ;
-			if (memcmp(pState->times, state->times, sizeof(t_weight) * state->slots))
-				continue ;
-			if (memcmp(pState->waitingSince, state->waitingSince, sizeof(t_weight) * state->slots))
-				continue ;
-
-			element1 = (unsigned long) listBegin(pState->bufferList);
-			element2 = (unsigned long) listBegin(state->bufferList);
-			while(element1 && element2) {
-
-				if (element1 != element2) break ;
-				element1 = (unsigned long) listNext(pState->bufferList);
-				element2 = (unsigned long) listNext(state->bufferList);
-			}
-			if (element1 || element2) continue ;
-
-			return(pState);
+			if (stateEquals(pState, state)) return(pState);
+			stateStorage->collisions++;
 		}
 	}
 	else {
@@ -307,6 +345,8 @@ t_stateStorage * stateStorageNew(int hashSize) {
 	arrayClear(stateStorage->hashTable);
 
 	stateStorage->usedSlots = setNew();
+	setReserve(stateStorage->usedSlots, hashSize - 1);
+	stateStorage->collisions = 0;
 
 	return(stateStorage);
 }
@@ -330,13 +370,13 @@ void statePrint(t_state * state) {
 			retryIndex = (2 * transmissionIndex) / (8 * sizeof(unsigned long));
 			retryBit = (2 * transmissionIndex) % (8 * sizeof(unsigned long));
 			retry = (state->retries[retryIndex] & (3 << retryBit)) >> retryBit;
-			printf("%d|" WEIGHT_FORMAT "*" WEIGHT_FORMAT "*%lu*%hhu;", transmissionIndex, state->times[transmissionIndex], state->waitingSince[transmissionIndex], backoff, retry);
+			printf("%d|" WEIGHT_FORMAT "*" WEIGHT_FORMAT "*%lu*%hhu;", transmissionIndex, (t_weight) state->times[transmissionIndex], (t_weight) state->waitingSince[transmissionIndex], backoff, retry);
 		}
 	}
 	printf("?");
-	for (x = (unsigned long) listBegin(state->bufferList); x; x = (unsigned long) listNext(state->bufferList)) {
+	for (i = 0; i < smallVecLength(& state->bufferList); i += 2) {
 
-		printf("%lu;", x - 1);
+		printf("%d*%d;", smallVecGet(& state->bufferList, i), smallVecGet(& state->bufferList, i + 1));
 	}
 	printf("\n");
 }
@@ -346,29 +386,21 @@ void stateFree(t_state * state) {
 	free(state->transmissionBitmap);
 	free(state->backoffBitmap);
 	free(state->retries);
-	listFree(state->bufferList);
-	free(state->bufferList);
+	smallVecFree(& state->bufferList);
 	free(state->times);
 	free(state->waitingSince);
-	arrayFree(state->deliveredPacketsFlows);
-	free(state->deliveredPacketsFlows);
-	arrayFree(state->sentPacketsFlows);
-	free(state->sentPacketsFlows);
-	arrayFree(state->delayFlows);
-	free(state->delayFlows);
+	free(state->arrivals);
+	longVecFree(& state->deliveredPacketsFlows);
 }
 
 void stateStorageFreeWithData(t_stateStorage * stateStorage) {
 
-	t_list * list;
 	t_list * hashEntry;
 	t_state * state;
-	unsigned long i;
+	int i;
 
-	list = setGetElements(stateStorage->usedSlots);
-	for (i = (unsigned long) listBegin(list); i; i = (unsigned long) listNext(list)) {
+	for (i = setFirst(stateStorage->usedSlots); i >= 0; i = setNext(stateStorage->usedSlots, i)) {
 
-		i = i - 1;
 		hashEntry = arrayGet(stateStorage->hashTable, i);
 
 		for (state = listBegin(hashEntry); state; state = listNext(hashEntry)) {
@@ -378,12 +410,106 @@ void stateStorageFreeWithData(t_stateStorage * stateStorage) {
 		listFreeWithData(hashEntry);
 		free(hashEntry);
 	}
-	listFree(list);
-	free(list);
 	setFree(stateStorage->usedSlots);
 	free(stateStorage->usedSlots);
 	arrayFree(stateStorage->hashTable);
 	free(stateStorage->hashTable);
 }
 
+#define FINGERPRINT_MIX(h, w) do {\
+							h ^= (uint64_t) (w);\
+							h *= 0x9E3779B97F4A7C15ull;\
+							h ^= h >> 29;\
+						} while(0)
+
+/*
+ * 64-bit fingerprint over the same fields compared by stateEquals.
+ */
+uint64_t stateFingerprint(t_state * state) {
+
+	uint64_t h = 0xCBF29CE484222325ull;
+	int * buffer;
+	int i;
+
+	for (i = 0; i < state->entries; i++) FINGERPRINT_MIX(h, state->transmissionBitmap[i]);
+	for (i = 0; i < state->entries; i++) FINGERPRINT_MIX(h, state->backoffBitmap[i]);
+	for (i = 0; i < 2 * state->entries; i++) FINGERPRINT_MIX(h, state->retries[i]);
+	for (i = 0; i < state->slots; i++) FINGERPRINT_MIX(h, state->times[i]);
+	for (i = 0; i < state->slots; i++) FINGERPRINT_MIX(h, state->waitingSince[i]);
+	for (i = 0; i < 2 * state->numberOfFlows; i++) FINGERPRINT_MIX(h, state->arrivals[i]);
+
+	for (buffer = smallVecBegin(& state->bufferList); buffer < smallVecEnd(& state->bufferList); buffer++) {
+
+		FINGERPRINT_MIX(h, * buffer);
+	}
+	FINGERPRINT_MIX(h, smallVecLength(& state->bufferList));
+
+	return(h);
+}
+
+t_stateCycle * stateCycleNew(void) {
+
+	t_stateCycle * stateCycle;
+
+	MALLOC(stateCycle, sizeof(t_stateCycle));
+	stateCycle->checkpoint = NULL;
+	stateCycle->fingerprint = 0;
+	stateCycle->power = 1;
+	stateCycle->length = 0;
+	stateCycle->collisions = 0;
+
+	return(stateCycle);
+}
+
+/*
+ * Same contract as stateLookupAndStore: returns the stored state equal
+ * to 'state', or NULL and takes ownership of 'state'. States that do
+ * not become the new checkpoint are freed right away.
+ */
+t_state * stateCycleLookupAndStore(t_state * state, t_stateCycle * stateCycle) {
+
+	uint64_t fingerprint;
+
+	fingerprint = stateFingerprint(state);
+
+	if (stateCycle->checkpoint && fingerprint == stateCycle->fingerprint) {
 
+		if (stateEquals(stateCycle->checkpoint, state)) return(stateCycle->checkpoint);
+		stateCycle->collisions++;
+	}
+
+	stateCycle->length++;
+	if (stateCycle->checkpoint == NULL || stateCycle->length == stateCycle->power) {
+
+		/*
+		 * Move the checkpoint forward, doubling the
+		 * distance to the next one.
+		 */
+		if (stateCycle->checkpoint) {
+
+			stateFree(stateCycle->checkpoint);
+			free(stateCycle->checkpoint);
+			stateCycle->power *= 2;
+		}
+		stateCycle->checkpoint = state;
+		stateCycle->fingerprint = fingerprint;
+		stateCycle->length = 0;
+	}
+	else {
+
+		stateFree(state);
+		free(state);
+	}
+
+	return(NULL);
+}
+
+void stateCycleFreeWithData(t_stateCycle * stateCycle) {
+
+	if (stateCycle->checkpoint) {
+
+		stateFree(stateCycle->checkpoint);
+		free(stateCycle->checkpoint);
+		stateCycle->checkpoint = NULL;
+	}
+}
@@ -2,25 +2,46 @@
 #define __STATEH_H__
 
 #include "array.h"
+#include "intVec.h"
 #include "set.h"
 #include "graph.h"
 #include "list.h"
 
+#include <stdint.h>
+
+/*
+ * The times kept in a state are relative to its current time: what is
+ * left of a backoff or transmission, and how long the packet has been
+ * waiting for the medium. They are far shorter than a simulation, so
+ * 32 bits hold them and states hash and compare in half the bytes. A
+ * state given a longer time is marked wide; it is kept as any other,
+ * but never equal to another state, so truncation cannot close a cycle.
+ */
+#ifdef USE_INT_WEIGHT
+typedef uint32_t t_stateTime;
+#define STATE_TIME_MAX		UINT32_MAX
+#else
+typedef t_weight t_stateTime;
+#endif
+
 typedef struct {
 
 	unsigned long * transmissionBitmap;
-	t_list * bufferList;
+	t_smallVec bufferList;		// Per queued packet: its conflict node index, then its age.
 	unsigned long entries;
 	unsigned long slots;
-	t_weight * times;
-	t_weight * waitingSince;
+	t_stateTime * times;
+	t_stateTime * waitingSince;
+	int wide;
+	int numberOfFlows;
+	long * arrivals;		// Per flow: time to its next packet, then its position in its traffic.
 	unsigned long * backoffBitmap;
 	unsigned long * retries;
 	t_weight currentTime;
 	double deliveredPackets;
-	t_array * deliveredPacketsFlows;
-	t_array * sentPacketsFlows;
-	t_array * delayFlows;
+	t_longVec deliveredPacketsFlows;	// The three share deliveredPacketsFlows.data.
+	t_longVec sentPacketsFlows;
+	t_longVec delayFlows;
 } t_state;
 
 typedef struct {
@@ -28,11 +49,28 @@ typedef struct {
 	t_array * hashTable;
 	t_set * usedSlots;
 	int hashSize;
+	unsigned long collisions;	// Stored states with the same hash that were not equal.
 } t_stateStorage;
 
+/*
+ * Memory-bounded alternative to t_stateStorage: Brent's cycle
+ * finding over the sequence of saved states. Only the current
+ * checkpoint is kept, together with its 64-bit fingerprint;
+ * states are compared in full only when fingerprints match.
+ */
+typedef struct {
+
+	t_state * checkpoint;
+	uint64_t fingerprint;
+	unsigned long power;
+	unsigned long length;
+	unsigned long collisions;	// Fingerprint matches that were not equal.
+} t_stateCycle;
+
 t_state * stateNew(unsigned int slots, int numberOfFlows);
 void stateAddTransmission(t_state * state, unsigned long index, t_weight time, unsigned char backoff, unsigned char retries, t_weight waitingSince);
-void stateAddBuffer(t_state * state, unsigned long index);
+void stateAddBuffer(t_state * state, unsigned long index, t_weight age);
+void stateSetArrival(t_state * state, int flow, long nextArrival, long trafficPosition);
 void stateSetCurrentTime(t_state * state, t_weight currentTime);
 void stateSetDeliveredPackets(t_state * state, double deliveredPackets);
 double stateGetDeliveredPackets(t_state * state);
@@ -42,12 +80,17 @@ t_stateStorage * stateStorageNew(int hashSize);
 void statePrint(t_state * state);
 void stateFree(t_state * state);
 void stateStorageFreeWithData(t_stateStorage * stateStorage);
-void stateSetDeliveredPacketsFlows(t_state * state, t_array * deliveredPacketsFlows);
-t_array * stateGetDeliveredPacketsFlows(t_state * state);
-void stateSetSentPacketsFlows(t_state * state, t_array * sentPacketsFlows);
-t_array * stateGetSentPacketsFlows(t_state * state);
-void stateSetDelayFlows(t_state * state, t_array * delayFlows);
-t_array * stateGetDelayFlows(t_state * state);
+uint64_t stateFingerprint(t_state * state);
+int stateEquals(t_state * state1, t_state * state2);
+t_stateCycle * stateCycleNew(void);
+t_state * stateCycleLookupAndStore(t_state * state, t_stateCycle * stateCycle);
+void stateCycleFreeWithData(t_stateCycle * stateCycle);
+void stateSetDeliveredPacketsFlows(t_state * state, t_longVec * deliveredPacketsFlows);
+t_longVec * stateGetDeliveredPacketsFlows(t_state * state);
+void stateSetSentPacketsFlows(t_state * state, t_longVec * sentPacketsFlows);
+t_longVec * stateGetSentPacketsFlows(t_state * state);
+void stateSetDelayFlows(t_state * state, t_longVec * delayFlows);
+t_longVec * stateGetDelayFlows(t_state * state);
 
 #endif
 
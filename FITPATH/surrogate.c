@@ -0,0 +1,252 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+
+#include "surrogate.h"
+#include "heuristics.h"
+#include "linkTable.h"
+#include "memory.h"
+
+/*
+ * Log file: the magic string and the number of features, followed by
+ * one record per simulation: the features, the cost and the delay,
+ * all as floats.
+ */
+#define SURROGATE_MAGIC		"FPSL"
+
+/*
+ * Weight of the ridge term added to the normal equations, so that
+ * features that never vary in the log do not make them singular.
+ */
+#define SURROGATE_RIDGE		1e-6
+
+void surrogateFeatures(t_heuristicCtx * ctx, t_graph * graph, t_array * paths, t_array * flowTimes, double * features) {
+
+	t_linkTable * linkTable;
+	t_array * path;
+	double deliveryProbability;
+	int i, j, hops;
+
+	linkTable = linkTableGet(graph);
+
+	for (i = 0; i < SURROGATE_FEATURES; i++) features[i] = 0;
+	features[0] = 1;
+
+	for (i = 0; i < arrayLength(paths); i++) {
+
+		path = arrayGet(paths, i);
+		hops = arrayLength(path) - 1;
+		features[1] += hops;
+		if (hops > features[2]) features[2] = hops;
+
+		deliveryProbability = 1.0;
+		for (j = 1; j < arrayLength(path); j++) {
+
+			features[3] += (double) graphGetCost(graph, (long) arrayGet(path, j - 1), (long) arrayGet(path, j)) / GRAPH_MULTIPLIER;
+			deliveryProbability *= linkTableLink(linkTable, (long) arrayGet(path, j - 1), (long) arrayGet(path, j))->deliveryFactor;
+		}
+		features[4] += 1.0 - deliveryProbability;
+	}
+
+	features[5] = heuristicCostLowerBound(ctx, graph, paths, arrayLength(paths), flowTimes);
+}
+
+/*
+ * Read and check the header of a log. Returns 0 if the log was not
+ * written with the same features.
+ */
+int surrogateLogHeader(FILE * log) {
+
+	char magic[4];
+	uint32_t numberOfFeatures;
+
+	if (fread(magic, 1, 4, log) != 4 || memcmp(magic, SURROGATE_MAGIC, 4)) return(0);
+	if (fread(& numberOfFeatures, sizeof(uint32_t), 1, log) != 1 || numberOfFeatures != SURROGATE_FEATURES) return(0);
+
+	return(1);
+}
+
+/*
+ * Open a log for appending. The header is written if the file is new;
+ * an existing log must have been written with the same features.
+ */
+FILE * surrogateLogOpen(char * filename) {
+
+	FILE * log;
+	uint32_t numberOfFeatures;
+
+	log = fopen(filename, "a+b");
+	if (!log) return(NULL);
+
+	fseek(log, 0, SEEK_END);
+	if (ftell(log) == 0) {
+
+		numberOfFeatures = SURROGATE_FEATURES;
+		fwrite(SURROGATE_MAGIC, 1, 4, log);
+		fwrite(& numberOfFeatures, sizeof(uint32_t), 1, log);
+		return(log);
+	}
+
+	rewind(log);
+	if (!surrogateLogHeader(log)) {
+
+		fclose(log);
+		return(NULL);
+	}
+	fseek(log, 0, SEEK_END);
+
+	return(log);
+}
+
+void surrogateLogWrite(FILE * log, double * features, float cost, float delay) {
+
+	float record[SURROGATE_FEATURES + 2];
+	int i;
+
+	for (i = 0; i < SURROGATE_FEATURES; i++) record[i] = features[i];
+	record[SURROGATE_FEATURES] = cost;
+	record[SURROGATE_FEATURES + 1] = delay;
+	fwrite(record, sizeof(float), SURROGATE_FEATURES + 2, log);
+}
+
+/*
+ * Read the next record, after surrogateLogHeader.
+ * Returns 0 at the end of the log.
+ */
+int surrogateLogRead(FILE * log, double * features, float * cost, float * delay) {
+
+	float record[SURROGATE_FEATURES + 2];
+	int i;
+
+	if (fread(record, sizeof(float), SURROGATE_FEATURES + 2, log) != SURROGATE_FEATURES + 2) return(0);
+
+	for (i = 0; i < SURROGATE_FEATURES; i++) features[i] = record[i];
+	* cost = record[SURROGATE_FEATURES];
+	* delay = record[SURROGATE_FEATURES + 1];
+
+	return(1);
+}
+
+/*
+ * Least squares fit of the cost over a log, from its start, by accumulating the
+ * normal equations and solving them with Gaussian elimination.
+ * Records with a non-finite cost are skipped. Returns NULL if the log
+ * is not valid.
+ */
+t_surrogate * surrogateTrain(FILE * log, unsigned long * numberOfSamples) {
+
+	t_surrogate * surrogate;
+	double a[SURROGATE_FEATURES][SURROGATE_FEATURES + 1];
+	double features[SURROGATE_FEATURES], factor, tmp;
+	float cost, delay;
+	int i, j, k, pivot;
+
+	if (!surrogateLogHeader(log)) return(NULL);
+
+	memset(a, 0, sizeof(a));
+	* numberOfSamples = 0;
+	while (surrogateLogRead(log, features, & cost, & delay)) {
+
+		if (!isfinite(cost)) continue ;
+
+		for (i = 0; i < SURROGATE_FEATURES; i++) {
+
+			for (j = 0; j < SURROGATE_FEATURES; j++) a[i][j] += features[i] * features[j];
+			a[i][SURROGATE_FEATURES] += features[i] * cost;
+		}
+		(* numberOfSamples)++;
+	}
+
+	for (i = 0; i < SURROGATE_FEATURES; i++) a[i][i] += SURROGATE_RIDGE * (* numberOfSamples + 1);
+
+	for (k = 0; k < SURROGATE_FEATURES; k++) {
+
+		pivot = k;
+		for (i = k + 1; i < SURROGATE_FEATURES; i++) if (fabs(a[i][k]) > fabs(a[pivot][k])) pivot = i;
+		for (j = 0; j <= SURROGATE_FEATURES; j++) {
+
+			tmp = a[k][j];
+			a[k][j] = a[pivot][j];
+			a[pivot][j] = tmp;
+		}
+
+		for (i = k + 1; i < SURROGATE_FEATURES; i++) {
+
+			factor = a[i][k] / a[k][k];
+			for (j = k; j <= SURROGATE_FEATURES; j++) a[i][j] -= factor * a[k][j];
+		}
+	}
+
+	MALLOC(surrogate, sizeof(t_surrogate));
+	for (k = SURROGATE_FEATURES - 1; k >= 0; k--) {
+
+		tmp = a[k][SURROGATE_FEATURES];
+		for (j = k + 1; j < SURROGATE_FEATURES; j++) tmp -= a[k][j] * surrogate->weights[j];
+		surrogate->weights[k] = tmp / a[k][k];
+	}
+
+	return(surrogate);
+}
+
+/*
+ * Models are text files: the number of features, then one weight
+ * per feature.
+ */
+t_surrogate * surrogateLoad(char * filename) {
+
+	t_surrogate * surrogate;
+	FILE * model;
+	int numberOfFeatures, i;
+
+	model = fopen(filename, "r");
+	if (!model) return(NULL);
+
+	if (fscanf(model, "%d", & numberOfFeatures) != 1 || numberOfFeatures != SURROGATE_FEATURES) {
+
+		fclose(model);
+		return(NULL);
+	}
+
+	MALLOC(surrogate, sizeof(t_surrogate));
+	for (i = 0; i < SURROGATE_FEATURES; i++) {
+
+		if (fscanf(model, "%lf", & surrogate->weights[i]) != 1) {
+
+			free(surrogate);
+			fclose(model);
+			return(NULL);
+		}
+	}
+
+	fclose(model);
+
+	return(surrogate);
+}
+
+int surrogateSave(t_surrogate * surrogate, char * filename) {
+
+	FILE * model;
+	int i;
+
+	model = fopen(filename, "w");
+	if (!model) return(0);
+
+	fprintf(model, "%d\n", SURROGATE_FEATURES);
+	for (i = 0; i < SURROGATE_FEATURES; i++) fprintf(model, "%.17g\n", surrogate->weights[i]);
+	fclose(model);
+
+	return(1);
+}
+
+double surrogatePredict(t_surrogate * surrogate, double * features) {
+
+	double prediction = 0;
+	int i;
+
+	for (i = 0; i < SURROGATE_FEATURES; i++) prediction += surrogate->weights[i] * features[i];
+
+	return(prediction);
+}
+
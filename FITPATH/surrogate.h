@@ -0,0 +1,39 @@
+#ifndef __SURROGATE_H__
+#define __SURROGATE_H__
+
+#include <stdio.h>
+
+#include "array.h"
+#include "graph.h"
+#include "heuristics.h"
+
+/*
+ * Features of a path set, in order: a constant 1, total number of
+ * hops, hops of the longest path, sum of the ETX of every hop, the
+ * independent loss bound (sum over flows of 1 - delivery probability)
+ * and heuristicCostLowerBound.
+ */
+#define SURROGATE_FEATURES	6
+
+/*
+ * Linear model of the simulated cost over the features above.
+ */
+typedef struct {
+
+	double weights[SURROGATE_FEATURES];
+} t_surrogate;
+
+void surrogateFeatures(t_heuristicCtx * ctx, t_graph * graph, t_array * paths, t_array * flowTimes, double * features);
+
+FILE * surrogateLogOpen(char * filename);
+int surrogateLogHeader(FILE * log);
+void surrogateLogWrite(FILE * log, double * features, float cost, float delay);
+int surrogateLogRead(FILE * log, double * features, float * cost, float * delay);
+
+t_surrogate * surrogateTrain(FILE * log, unsigned long * numberOfSamples);
+t_surrogate * surrogateLoad(char * filename);
+int surrogateSave(t_surrogate * surrogate, char * filename);
+double surrogatePredict(t_surrogate * surrogate, double * features);
+
+#endif
+
@@ -0,0 +1,55 @@
+#!/bin/bash
+
+# Training workload for the profile-guided build (make pgo): runs the
+# instrumented programs in the given directory on inputs built from
+# data/etx and data/instances, so that their profiles are written next
+# to their objects. The inputs mix grid and random topologies, and
+# etxGrid3_56 makes the simulator time out on some cycle searches.
+#
+#	./train.sh <directory with the instrumented programs>
+
+. ./instances.sh
+
+DIR=$(cd $1 && pwd)
+
+# <topology> <instance file> <flows per instance> <instance number>
+INPUTS=(
+	"etxGrid56 instGrid3 3 2"
+	"etxRandom30 instRand3 3 1"
+	"etxRand2_30 instRand3 3 5"
+	"etxGrid56 instGrid3 3 7"
+	"etxGrid3_56 instGrid3 3 3"
+)
+
+WORKDIR=$(mktemp -d /tmp/train_XXX)
+RUNDIR=$(makeRunDir $WORKDIR)
+
+for INPUT in "${INPUTS[@]}"
+do
+	set -- $INPUT
+	INPUTFILE=$WORKDIR/$1-$2-$4
+	makeInput $1 $2 $3 $4 $INPUTFILE
+
+	echo "Training fitpath on $1-$2-$4"
+	(cd $RUNDIR && $DIR/fitpath -b -s $INPUTFILE $(numberOfNodes $INPUTFILE) 1 1 > /dev/null)
+done
+
+# The default cycle detection (a hash table of the states) takes other
+# paths through the simulator than -b.
+INPUTFILE=$WORKDIR/etxRandom30-instRand3-1
+echo "Training fitpath (hash cycle detection) on etxRandom30-instRand3-1"
+(cd $RUNDIR && $DIR/fitpath -s $INPUTFILE $(numberOfNodes $INPUTFILE) 1 1 > /dev/null)
+
+# heuristicILS_mate takes long enough that one input suffices.
+INPUTFILE=$WORKDIR/etxGrid56-instGrid3-2
+echo "Training heuristicILS_mate on etxGrid56-instGrid3-2"
+(cd $RUNDIR && $DIR/heuristicILS_mate -S 1 $INPUTFILE $(numberOfNodes $INPUTFILE) 1 1 > /dev/null)
+
+# mape simulates four fixed paths on a 56 node topology and needs an
+# input with as many flows.
+INPUTFILE=$WORKDIR/etxGrid56-instGrid3-4flows
+makeInput etxGrid56 instGrid3 4 1 $INPUTFILE
+echo "Training mape on etxGrid56-instGrid3-4flows"
+(cd $RUNDIR && $DIR/mape -S 1 $INPUTFILE > /dev/null)
+
+rm -rf $WORKDIR
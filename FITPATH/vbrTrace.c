@@ -0,0 +1,180 @@
+#define _ISOC99_SOURCE
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "vbrTrace.h"
+#include "memory.h"
+
+/*
+ * Traces loaded so far, so a file used by several flows is read once,
+ * and the trace replayed by each flow. Both are filled before the
+ * simulations start and only read afterwards.
+ */
+static t_vbrTrace ** loadedTraces = NULL;
+static int numberOfLoadedTraces = 0;
+
+static const t_vbrTrace ** flowTraces = NULL;
+static int numberOfFlowTraces = 0;
+
+/*
+ * Each line of an Evalvid trace is a frame: its id, its type, its size
+ * in bytes, the packets it is sent in and its time in seconds, the
+ * columns ns-3's EvalvidServer reads. As there, the packets of a frame
+ * go back to back and the next frame follows at its own time; frames
+ * sent at the same instant become a single burst. The trace repeats
+ * after its last frame, which is followed by the mean interval.
+ */
+const t_vbrTrace * vbrTraceLoad(char * filename) {
+
+	t_vbrTrace * trace;
+	FILE * in;
+	char line[1024], type[16];
+	unsigned long size;
+	double seconds;
+	long long time, firstTime = 0, lastTime = 0;
+	int frame, packets, allocatedBursts = 0, lineNumber = 0;
+	int i;
+
+	for (i = 0; i < numberOfLoadedTraces; i++)
+		if (!strcmp(loadedTraces[i]->filename, filename)) return(loadedTraces[i]);
+
+	if ((in = fopen(filename, "r")) == NULL) {
+
+		fprintf(stderr, "Failed to open file '%s' for reading.\n", filename);
+		exit(-1);
+	}
+
+	MALLOC(trace, sizeof(t_vbrTrace));
+	MALLOC(trace->filename, strlen(filename) + 1);
+	strcpy(trace->filename, filename);
+	trace->numberOfBursts = 0;
+	trace->bursts = NULL;
+
+	while (fgets(line, sizeof(line), in)) {
+
+		lineNumber++;
+		if (line[strspn(line, " \t\r\n")] == 0) continue ;
+
+		if (sscanf(line, "%d %15s %lu %d %lf", & frame, type, & size, & packets, & seconds) != 5) {
+
+			fprintf(stderr, "Error at line %d of '%s': expected frame id, type, size, packets and time.\n", lineNumber, filename);
+			exit(-2);
+		}
+
+		/*
+		 * ns-3 sends at least one packet per frame.
+		 */
+		if (packets < 1) packets = 1;
+		time = llround(seconds * VBR_TIME_UNITS_PER_SECOND);
+
+		if (trace->numberOfBursts > 0 && time < lastTime) {
+
+			fprintf(stderr, "Error at line %d of '%s': frame times must not decrease.\n", lineNumber, filename);
+			exit(-3);
+		}
+
+		if (trace->numberOfBursts > 0 && time == lastTime) {
+
+			trace->bursts[trace->numberOfBursts - 1].packets += packets;
+			continue ;
+		}
+
+		if (trace->numberOfBursts == allocatedBursts) {
+
+			allocatedBursts = allocatedBursts ? 2 * allocatedBursts : 256;
+			REALLOC(trace->bursts, allocatedBursts * sizeof(t_vbrBurst));
+		}
+
+		if (trace->numberOfBursts > 0) trace->bursts[trace->numberOfBursts - 1].interval = time - lastTime;
+		else firstTime = time;
+
+		trace->bursts[trace->numberOfBursts].packets = packets;
+		trace->bursts[trace->numberOfBursts].interval = 0;
+		trace->numberOfBursts++;
+		lastTime = time;
+	}
+
+	fclose(in);
+
+	if (trace->numberOfBursts == 0) {
+
+		fprintf(stderr, "No frame in trace '%s'!\n", filename);
+		exit(-4);
+	}
+
+	/*
+	 * A single burst is repeated every second.
+	 */
+	if (trace->numberOfBursts == 1) trace->bursts[0].interval = VBR_TIME_UNITS_PER_SECOND;
+	else trace->bursts[trace->numberOfBursts - 1].interval = (lastTime - firstTime) / (trace->numberOfBursts - 1);
+
+	REALLOC(trace->bursts, trace->numberOfBursts * sizeof(t_vbrBurst));
+
+	REALLOC(loadedTraces, (numberOfLoadedTraces + 1) * sizeof(t_vbrTrace *));
+	loadedTraces[numberOfLoadedTraces++] = trace;
+
+	return(trace);
+}
+
+/*
+ * Flow i replays traces[i % numberOfTraces].
+ */
+void vbrSetFlowTraces(const t_vbrTrace ** traces, int numberOfTraces) {
+
+	free(flowTraces);
+	MALLOC(flowTraces, numberOfTraces * sizeof(t_vbrTrace *));
+	memcpy(flowTraces, traces, numberOfTraces * sizeof(t_vbrTrace *));
+	numberOfFlowTraces = numberOfTraces;
+}
+
+const t_vbrTrace * vbrFlowTrace(int flow) {
+
+	if (numberOfFlowTraces == 0) return(NULL);
+
+	return(flowTraces[flow % numberOfFlowTraces]);
+}
+
+void vbrCursorInit(t_vbrCursor * cursor, const t_vbrTrace * trace) {
+
+	cursor->trace = trace;
+	cursor->burst = 0;
+	cursor->packetsLeft = trace->bursts[0].packets;
+}
+
+/*
+ * Account for a packet just sent and return the time until the next
+ * one: zero inside a burst, the burst's interval after its last packet.
+ */
+int vbrCursorNext(t_vbrCursor * cursor) {
+
+	int interval;
+
+	if (--cursor->packetsLeft > 0) return(0);
+
+	interval = cursor->trace->bursts[cursor->burst].interval;
+	if (++cursor->burst == cursor->trace->numberOfBursts) cursor->burst = 0;
+	cursor->packetsLeft = cursor->trace->bursts[cursor->burst].packets;
+
+	return(interval);
+}
+
+void vbrTraceFreeAll(void) {
+
+	int i;
+
+	for (i = 0; i < numberOfLoadedTraces; i++) {
+
+		free(loadedTraces[i]->filename);
+		free(loadedTraces[i]->bursts);
+		free(loadedTraces[i]);
+	}
+	free(loadedTraces);
+	loadedTraces = NULL;
+	numberOfLoadedTraces = 0;
+
+	free(flowTraces);
+	flowTraces = NULL;
+	numberOfFlowTraces = 0;
+}
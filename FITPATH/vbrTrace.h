@@ -0,0 +1,48 @@
+#ifndef __VBRTRACE_H__
+#define __VBRTRACE_H__
+
+/*
+ * Simulator time units in a second of trace time.
+ */
+#define VBR_TIME_UNITS_PER_SECOND	18189167
+
+/*
+ * Packets of one or more frames sent back to back, and the time from
+ * them to the next burst.
+ */
+typedef struct {
+
+	int packets;
+	int interval;
+} t_vbrBurst;
+
+/*
+ * An Evalvid trace (ns-3-dev/trace/st_*) converted to bursts. Traces
+ * are loaded once and never changed, so every simulation of a run
+ * shares them.
+ */
+typedef struct {
+
+	char * filename;
+	int numberOfBursts;
+	t_vbrBurst * bursts;
+} t_vbrTrace;
+
+/*
+ * Position of a flow in its trace. Each simulation keeps its own.
+ */
+typedef struct {
+
+	const t_vbrTrace * trace;
+	int burst;
+	int packetsLeft;
+} t_vbrCursor;
+
+const t_vbrTrace * vbrTraceLoad(char * filename);
+void vbrSetFlowTraces(const t_vbrTrace ** traces, int numberOfTraces);
+const t_vbrTrace * vbrFlowTrace(int flow);
+void vbrCursorInit(t_vbrCursor * cursor, const t_vbrTrace * trace);
+int vbrCursorNext(t_vbrCursor * cursor);
+void vbrTraceFreeAll(void);
+
+#endif
@@ -20,6 +20,7 @@ t_list * yen(t_graph * graph, int source, int destination, int numberOfPaths) {
 
 	output = listNew();
 	candidates = heapNew();
+	heapReserve(candidates, numberOfPaths);
 	root = prefixTreeNew(source);
 
 	/*